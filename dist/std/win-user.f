@@ -0,0 +1,14 @@
+
+: user.home  description: "The user's 'home' path."
+             signature: " -- home_path"
+    "userprofile"  user.env@
+;
+
+
+: user.name  description: "The name of the current user."
+             signature: " -- user_name"
+    "username"  user.env@
+;
+
+
+"\\" constant user.path_sep
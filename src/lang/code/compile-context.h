@@ -17,6 +17,8 @@ namespace sorth::internal
         ExecutionContext execution_context = ExecutionContext::run_time;
         WordVisibility visibility = WordVisibility::visible;
         WordContextManagement context_management = WordContextManagement::managed;
+        WordIntrinsic intrinsic = WordIntrinsic::none;
+        WordJitPolicy jit_policy = WordJitPolicy::automatic;
 
         std::string name;
         std::string description;
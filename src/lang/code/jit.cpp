@@ -7,13 +7,17 @@
 #if (SORTH_LLVM_FOUND == 1)
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Verifier.h>
@@ -28,10 +32,16 @@
 #include <llvm/MC/MCSubtargetInfo.h>
 #include <llvm/Object/SymbolicFile.h>
 #include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/Scalar/GVN.h>
 #include <llvm/Transforms/Utils.h>
 
+#if (IS_UNIX == 1)
+    #include <unistd.h>
+#endif
+
 
 
 namespace sorth::internal
@@ -50,6 +60,30 @@ namespace sorth::internal
             public:
                 static std::unordered_map<std::string, std::tuple<uint64_t, size_t>> FunctionSizes;
 
+                // Modules can be compiled on several threads at once, so access to the function
+                // sizes is guarded.
+                static std::mutex FunctionSizesLock;
+
+            public:
+                // Get the address and size of a JITed function, and then forget about it.  If the
+                // function wasn't found both are 0.
+                static std::tuple<uint64_t, size_t> take_function_size(const std::string& name)
+                {
+                    std::lock_guard<std::mutex> lock(FunctionSizesLock);
+
+                    auto iter = FunctionSizes.find(name);
+
+                    if (iter == FunctionSizes.end())
+                    {
+                        return { 0, 0 };
+                    }
+
+                    auto result = iter->second;
+                    FunctionSizes.erase(iter);
+
+                    return result;
+                }
+
             public:
                 virtual void notifyObjectLoaded(llvm::RuntimeDyld& rt_dyld,
                                                 const llvm::object::ObjectFile& obj) override
@@ -82,6 +116,7 @@ namespace sorth::internal
                             // Save the function's address and size. If we could find them.
                             if ((address) && (size > 0))
                             {
+                                std::lock_guard<std::mutex> lock(FunctionSizesLock);
                                 FunctionSizes.insert({ name, { (uint64_t)address, size } });
                             }
                         }
@@ -166,6 +201,47 @@ namespace sorth::internal
         std::unordered_map<std::string, std::tuple<uint64_t, size_t>>
                                                                TrackingMemoryManager::FunctionSizes;
 
+        std::mutex TrackingMemoryManager::FunctionSizesLock;
+
+
+        // Writes the map file that the Linux perf tools use to name the functions found in JITed
+        // code, /tmp/perf-<pid>.map.  Each line holds a function's address and size in hex,
+        // followed by it's name.
+        class PerfMap
+        {
+            private:
+                std::mutex lock;
+                std::ofstream stream;
+
+            public:
+                void add(uint64_t address, size_t size, const std::string& name)
+                {
+                    #if (IS_UNIX == 1)
+                        std::lock_guard<std::mutex> guard(lock);
+
+                        if (!stream.is_open())
+                        {
+                            stream.open("/tmp/perf-" + std::to_string(getpid()) + ".map",
+                                        std::ios::app);
+                        }
+
+                        stream << std::hex << address << " " << size << std::dec << " "
+                               << name << std::endl;
+                    #endif
+                }
+        };
+
+
+        // The name a word's code is reported under to profilers, along with where it was defined.
+        std::string profiler_name(const std::string& name, const Location& location)
+        {
+            std::stringstream stream;
+
+            stream << "sorth:" << name << " (" << location << ")";
+
+            return stream.str();
+        }
+
 
         // On macOS symbols must be prefixed by an underscore.  We'll use this constant to handle
         // that later on in the code.
@@ -187,977 +263,3617 @@ namespace sorth::internal
         };
 
 
-        // The JIT engine, we hold the llvm context here.
-        struct JitEngine
+        // The types of values that the JIT can hold in registers instead of on the interpreter's
+        // stack.
+        enum class CachedType
         {
-            // The llvm execution engine used for JITing code.
-            std::unique_ptr<llvm::orc::LLJIT> jit = nullptr;
+            integer,
+            floating,
+            boolean
+        };
 
-            // Function type info pointers for the JITed code helper functions.
-            llvm::Function* handle_set_location_fn = nullptr;
-            llvm::Function* handle_manage_context_fn = nullptr;
 
-            llvm::Function* handle_define_variable_fn = nullptr;
-            llvm::Function* handle_define_constant_fn = nullptr;
-            llvm::Function* handle_read_variable_fn = nullptr;
-            llvm::Function* handle_write_variable_fn = nullptr;
+        // A value held in a register, (an llvm SSA value,) that logically sits on the top of the
+        // interpreter's stack.
+        struct CachedValue
+        {
+            CachedType type;
+            llvm::Value* value;
+        };
 
-            llvm::Function* handle_pop_bool_fn = nullptr;
 
-            llvm::Function* handle_push_last_exception_fn = nullptr;
-            llvm::Function* handle_push_bool_fn = nullptr;
-            llvm::Function* handle_push_int_fn = nullptr;
-            llvm::Function* handle_push_double_fn = nullptr;
-            llvm::Function* handle_push_string_fn = nullptr;
-            llvm::Function* handle_push_value_fn = nullptr;
+        // Within a straight run of generated code we model the top of the Forth stack
+        // symbolically.  Constants and the results of inlined operations are kept here, with the
+        // last item being the top of the stack, and are only spilled to the interpreter's real
+        // stack at block boundaries, before calls to other words, and before anything that can
+        // raise an error.
+        using StackCache = std::vector<CachedValue>;
 
-            llvm::Function* handle_word_execute_name_fn = nullptr;
-            llvm::Function* handle_word_execute_index_fn = nullptr;
 
-            llvm::Function* handle_word_index_name_fn = nullptr;
-            llvm::Function* handle_word_exists_name_fn = nullptr;
+        // The data that a JITed word's native code needs at run-time.  It's allocated before the
+        // word is compiled so that it has a fixed address that other words in the same module can
+        // use when calling the word directly.
+        struct JitWordData
+        {
+            std::vector<Location> locations;
+            std::vector<Value> constants;
 
-            // For storing any errors that occur in the llvm engine.
-            std::string llvm_error_str;
+            // Cleared if the word is replaced, see WordFunction::invalidate_direct_calls.
+            std::shared_ptr<std::atomic<bool>> is_current =
+                                                          std::make_shared<std::atomic<bool>>(true);
+        };
 
-            // Keep track of the last exception that occurred in the JITed code for each thread.
-            static thread_local std::optional<std::runtime_error> last_exception;
+        using JitWordDataPtr = std::shared_ptr<JitWordData>;
 
 
-            // Constructor for the JIT engine.  Initialize LLVM and create the execution engine.
-            // Also register our helper functions that will get called from the JITed code.
-            JitEngine()
-            {
-                // Initialize the llvm jit engine.
-                llvm::InitializeNativeTarget();
-                llvm::InitializeNativeTargetAsmPrinter();
-                llvm::InitializeNativeTargetAsmParser();
-                llvm::InitializeNativeTargetDisassembler();
+        // Branch weights for checking the result of something that can fail.  Errors are rare, so
+        // this lets llvm move the error handling out of the way of the normal path.
+        llvm::MDNode* unlikely_error(llvm::IRBuilder<>& builder)
+        {
+            return llvm::MDBuilder(builder.getContext()).createBranchWeights(1, 1 << 20);
+        }
 
-                // Construct the LLVM JIT engine, using the object linking layer creator to create
-                // and use our custom memory manager.
-                auto jit_result =
-                    llvm::orc::LLJITBuilder()
-                        .setObjectLinkingLayerCreator([=](llvm::orc::ExecutionSession& es,
-                                                          const llvm::Triple& triple)
-                                          -> llvm::Expected<std::unique_ptr<llvm::orc::ObjectLayer>>
-                        {
-                            // Create a standard object linking layer with our custom memory
-                            // manager, instead of the default one.
-                            auto layer = new llvm::orc::RTDyldObjectLinkingLayer(
-                                    es,
-                                    [=]() -> std::unique_ptr<llvm::RuntimeDyld::MemoryManager>
-                                    {
-                                        return std::make_unique<TrackingMemoryManager>();
-                                    });
 
-                            // Return our new object linking layer.
-                            return std::unique_ptr<llvm::orc::ObjectLayer>(layer);
-                        })
-                        .create();
+        // Is the JIT engine still around?  Handlers can outlive the engine at program exit, and by
+        // then there is nothing left to free their code from.
+        std::atomic<bool> is_engine_alive = false;
 
-                if (!jit_result)
-                {
-                    std::string error_message;
 
-                    llvm::raw_string_ostream stream(error_message);
-                    llvm::logAllUnhandledErrors(jit_result.takeError(),
-                                                stream,
-                                                "Failed to create llvm JIT engine: ");
-                    stream.flush();
+        // The machine code for one compile, either a single word or a script with all of it's
+        // words.  Every handler created by the compile holds a reference to it, and once the last
+        // one is gone the code and the run-time data it uses are freed.
+        struct JitCode
+        {
+            // The trackers for the llvm modules that hold the code.
+            std::vector<llvm::orc::ResourceTrackerSP> trackers;
 
-                    throw_error(error_message);
+            // The run-time data of all the words in the compile.  The generated code embeds the
+            // addresses of this data when the words call each other directly.
+            std::vector<JitWordDataPtr> data;
+
+            ~JitCode()
+            {
+                if (!is_engine_alive)
+                {
+                    return;
                 }
 
-                // Save the jit engine and register the helper function symbols/types.
-                jit = std::move(*jit_result);
-                register_jit_helper_ptrs();
+                for (auto& tracker : trackers)
+                {
+                    if (auto error = tracker->remove())
+                    {
+                        llvm::consumeError(std::move(error));
+                    }
+                }
             }
+        };
 
+        using JitCodePtr = std::shared_ptr<JitCode>;
 
-            // Map the helper function pointers to their symbols in the JIT engine.
-            void register_jit_helper_ptrs()
-            {
-                // Properly mangle symbols for the platform's ABI, on macOS this means we need a
-                // leading underscore.
-                auto mangle = [this](const std::string& name) -> llvm::orc::SymbolStringPtr
-                    {
-                        return jit->getExecutionSession().intern(platform_prefix + name);
-                    };
 
-                // Create the symbol map for the helper functions.
-                llvm::orc::SymbolMap symbol_map =
-                    {
-                        {
-                            mangle("handle_set_location"),
-                            llvm::orc::ExecutorSymbolDef(
-                                         llvm::orc::ExecutorAddr((uint64_t)&handle_set_location),
-                                         llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_manage_context"),
-                            llvm::orc::ExecutorSymbolDef(
-                                         llvm::orc::ExecutorAddr((uint64_t)&handle_manage_context),
-                                         llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_define_variable"),
-                            llvm::orc::ExecutorSymbolDef(
-                                         llvm::orc::ExecutorAddr((uint64_t)&handle_define_variable),
-                                         llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_define_constant"),
-                            llvm::orc::ExecutorSymbolDef(
-                                         llvm::orc::ExecutorAddr((uint64_t)&handle_define_constant),
-                                         llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_read_variable"),
-                            llvm::orc::ExecutorSymbolDef(
-                                           llvm::orc::ExecutorAddr((uint64_t)&handle_read_variable),
-                                           llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_write_variable"),
-                            llvm::orc::ExecutorSymbolDef(
-                                          llvm::orc::ExecutorAddr((uint64_t)&handle_write_variable),
-                                          llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_pop_bool"),
-                            llvm::orc::ExecutorSymbolDef(
-                                                llvm::orc::ExecutorAddr((uint64_t)&handle_pop_bool),
-                                                llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_push_last_exception"),
-                            llvm::orc::ExecutorSymbolDef(
-                                     llvm::orc::ExecutorAddr((uint64_t)&handle_push_last_exception),
-                                     llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_push_bool"),
-                            llvm::orc::ExecutorSymbolDef(
-                                               llvm::orc::ExecutorAddr((uint64_t)&handle_push_bool),
-                                               llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_push_int"),
-                            llvm::orc::ExecutorSymbolDef(
-                                                llvm::orc::ExecutorAddr((uint64_t)&handle_push_int),
-                                                llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_push_double"),
-                            llvm::orc::ExecutorSymbolDef(
-                                            llvm::orc::ExecutorAddr((uint64_t)&handle_push_double),
-                                            llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_push_string"),
-                            llvm::orc::ExecutorSymbolDef(
-                                            llvm::orc::ExecutorAddr((uint64_t)&handle_push_string),
-                                            llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_push_value"),
-                            llvm::orc::ExecutorSymbolDef(
-                                            llvm::orc::ExecutorAddr((uint64_t)&handle_push_value),
-                                            llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_word_execute_name"),
-                            llvm::orc::ExecutorSymbolDef(
-                                       llvm::orc::ExecutorAddr((uint64_t)&handle_word_execute_name),
-                                       llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_word_execute_index"),
-                            llvm::orc::ExecutorSymbolDef(
-                                      llvm::orc::ExecutorAddr((uint64_t)&handle_word_execute_index),
-                                      llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_word_index_name"),
-                            llvm::orc::ExecutorSymbolDef(
-                                         llvm::orc::ExecutorAddr((uint64_t)&handle_word_index_name),
-                                         llvm::JITSymbolFlags::Exported)
-                        },
-                        {
-                            mangle("handle_word_exists_name"),
-                            llvm::orc::ExecutorSymbolDef(
-                                        llvm::orc::ExecutorAddr((uint64_t)&handle_word_exists_name),
-                                        llvm::JITSymbolFlags::Exported)
-                        }
-                    };
+        // A word being compiled as part of the current script that can be called directly instead
+        // of through the interpreter's handler table.
+        struct DirectCallTarget
+        {
+            llvm::Function* function;
+            JitWordDataPtr data;
+        };
 
-                // Register that map with the JIT engine.
-                auto error = jit->getMainJITDylib()
-                                         .define(llvm::orc::absoluteSymbols(std::move(symbol_map)));
+        // Direct call targets indexed by the word's handler index.
+        using DirectCallMap = std::unordered_map<int64_t, DirectCallTarget>;
 
-                if (error)
-                {
-                    std::string error_message;
 
-                    llvm::raw_string_ostream stream(error_message);
-                    llvm::logAllUnhandledErrors(std::move(error),
-                                                stream,
-                                                "Failed to define helper symbols: ");
-                    stream.flush();
+        // The shared state of a word whose compilation has been put off until it's first called.
+        struct LazyWordState
+        {
+            // Only one thread gets to compile the word.
+            std::mutex lock;
+            std::atomic<bool> is_compiled = false;
 
-                    throw_error(error_message);
-                }
-            }
+            // What we need to compile the word.
+            Construction construction;
+            std::shared_ptr<const std::set<std::string>> dynamic_names;
 
+            // The word's native code handler once it's been compiled.
+            WordFunction handler;
+        };
 
-            // Register the helper functions and their signatures that will be called from the JITed
-            // code.
-            void register_jit_helpers(std::unique_ptr<llvm::Module>& module,
-                                      std::unique_ptr<llvm::LLVMContext>& context)
-            {
-                // Gather up our basic types needed for the function signatures.
-                auto void_type = llvm::Type::getVoidTy(*context.get());
-                auto ptr_type = llvm::PointerType::getUnqual(void_type);
-                auto int64_type = llvm::Type::getInt64Ty(*context.get());
-                auto bool_type = llvm::Type::getInt1Ty(*context.get());
-                auto bool_ptr_type = llvm::PointerType::getUnqual(bool_type);
-                auto double_type = llvm::Type::getDoubleTy(*context.get());
-                auto char_type = llvm::Type::getInt8Ty(*context.get());
-                auto char_ptr_type = llvm::PointerType::getUnqual(char_type);
+        using LazyWordStatePtr = std::shared_ptr<LazyWordState>;
 
 
-                // Register the handle_set_location function.
-                auto handle_set_location_type = llvm::FunctionType::get(void_type,
-                                                                 { ptr_type, ptr_type, int64_type },
-                                                                 false);
-                handle_set_location_fn = llvm::Function::Create(handle_set_location_type,
-                                                                llvm::Function::ExternalLinkage,
-                                                                "handle_set_location",
-                                                                module.get());
+        // A group of a script's words that are compiled together into their own llvm module.  Each
+        // partition is optimized and turned into machine code on it's own thread.
+        struct JitPartition
+        {
+            // The words in this partition, as keys into the script's word cache.
+            std::vector<std::string> words;
+
+            // Is the script's top level code part of this partition?
+            bool has_script_body = false;
+
+            // The total size of the byte-code in the partition, used to balance the work.
+            size_t size = 0;
+
+            // The generated module, the tracker that owns it's code once added to the JIT engine,
+            // the IR captured after optimization, and any error that occurred while compiling it.
+            std::unique_ptr<llvm::Module> module;
+            std::unique_ptr<llvm::LLVMContext> context;
+            llvm::orc::ResourceTrackerSP tracker;
+            std::unordered_map<std::string, std::string> ir_map;
+            std::exception_ptr error;
+        };
 
-                // Register the handle_manage_context function.
-                auto handle_manage_context_type = llvm::FunctionType::get(void_type,
-                                                                          { ptr_type, bool_type },
-                                                                          false);
-                handle_manage_context_fn = llvm::Function::Create(handle_manage_context_type,
-                                                                  llvm::Function::ExternalLinkage,
-                                                                  "handle_manage_context",
-                                                                  module.get());
 
-                // Register the handle_define_variable function.
-                auto handle_define_variable_type = llvm::FunctionType::get(int64_type,
-                                                                        { ptr_type, char_ptr_type },
-                                                                        false);
-                handle_define_variable_fn = llvm::Function::Create(handle_define_variable_type,
-                                                                   llvm::Function::ExternalLinkage,
-                                                                   "handle_define_variable",
-                                                                   module.get());
+        // How a word's promoted local variable or constant is stored in it's JITed code.
+        enum class LocalStorage
+        {
+            // Not known yet, it's decided by the first value written to it.
+            undecided,
 
-                // Register the handle_define_constant function.
-                auto handle_define_constant_type = llvm::FunctionType::get(int64_type,
-                                                                        { ptr_type, char_ptr_type },
-                                                                        false);
-                handle_define_constant_fn = llvm::Function::Create(handle_define_constant_type,
-                                                                   llvm::Function::ExternalLinkage,
-                                                                   "handle_define_constant",
-                                                                   module.get());
+            // Unboxed, in an llvm stack slot that's usually promoted to a register.
+            typed,
 
-                // Register the handle_read_variable function.
-                auto handle_read_variable_type = llvm::FunctionType::get(int64_type, { ptr_type },
-                                                                         false);
-                handle_read_variable_fn = llvm::Function::Create(handle_read_variable_type,
-                                                                 llvm::Function::ExternalLinkage,
-                                                                 "handle_read_variable",
-                                                                 module.get());
+            // Boxed, as a Value in the word's local frame.
+            boxed
+        };
 
-                // Register the handle_write_variable function.
-                auto handle_write_variable_type = llvm::FunctionType::get(int64_type, { ptr_type },
-                                                                          false);
-                handle_write_variable_fn = llvm::Function::Create(handle_write_variable_type,
-                                                                  llvm::Function::ExternalLinkage,
-                                                                  "handle_write_variable",
-                                                                  module.get());
 
-                // Register the handle_pop_bool function.
-                auto handle_pop_bool_type = llvm::FunctionType::get(int64_type,
-                                                                    { ptr_type, bool_ptr_type },
-                                                                    false);
-                handle_pop_bool_fn = llvm::Function::Create(handle_pop_bool_type,
-                                                            llvm::Function::ExternalLinkage,
-                                                            "handle_pop_bool",
-                                                            module.get());
+        // A local variable or constant that is only ever used from within it's word.  Instead of
+        // defining it in the interpreter, which means a dictionary entry and a slot in the
+        // variable list, the JITed code keeps it to itself.
+        struct PromotedLocal
+        {
+            // Where the variable, or constant, is defined in the word's byte-code.
+            size_t definition = 0;
 
-                // Register the handle_push_last_exception function.
-                auto handle_push_last_exception_type = llvm::FunctionType::get(void_type,
-                                                                        { ptr_type },
-                                                                        false);
-                handle_push_last_exception_fn =
-                                             llvm::Function::Create(handle_push_last_exception_type,
-                                                                    llvm::Function::ExternalLinkage,
-                                                                    "handle_push_last_exception",
-                                                                    module.get());
+            // Is this a constant rather than a variable?
+            bool is_constant = false;
 
-                // Register the handle_push_bool function.
-                auto handle_push_bool_type = llvm::FunctionType::get(void_type,
-                                                                     { ptr_type, bool_type },
-                                                                     false);
-                handle_push_bool_fn = llvm::Function::Create(handle_push_bool_type,
-                                                             llvm::Function::ExternalLinkage,
-                                                             "handle_push_bool",
-                                                             module.get());
+            // Was the variable given a value as soon as it was defined, as variable! does?
+            bool is_initialized = false;
 
-                // Register the handle_push_int function.
-                auto handle_push_int_type = llvm::FunctionType::get(void_type,
-                                                                    { ptr_type, int64_type },
-                                                                    false);
-                handle_push_int_fn = llvm::Function::Create(handle_push_int_type,
-                                                            llvm::Function::ExternalLinkage,
-                                                            "handle_push_int",
-                                                            module.get());
+            // Is the variable used with ++! or --!?  If so it needs to be stored unboxed.
+            bool is_incremented = false;
 
-                // Register the handle_push_double function.
-                auto handle_push_double_type = llvm::FunctionType::get(void_type,
-                                                                       { ptr_type, double_type },
-                                                                       false);
-                handle_push_double_fn = llvm::Function::Create(handle_push_double_type,
-                                                               llvm::Function::ExternalLinkage,
-                                                               "handle_push_double",
-                                                               module.get());
+            // Set if the variable turned out to be written with values of more than one type.
+            bool must_box = false;
 
-                // Register the handle_push_string function.
-                auto handle_push_string_type = llvm::FunctionType::get(void_type,
-                                                                      { ptr_type, char_ptr_type },
-                                                                      false);
-                handle_push_string_fn = llvm::Function::Create(handle_push_string_type,
-                                                               llvm::Function::ExternalLinkage,
-                                                               "handle_push_string",
-                                                               module.get());
+            // The following is filled in while generating the word's code.
+            LocalStorage storage = LocalStorage::undecided;
+            CachedType type = CachedType::integer;
+            llvm::AllocaInst* slot = nullptr;
+            size_t frame_index = 0;
+        };
 
-                // Register the handle_push_value function.
-                auto handle_push_value_type = llvm::FunctionType::get(void_type,
-                                                                 { ptr_type, ptr_type, int64_type },
-                                                                 false);
-                handle_push_value_fn = llvm::Function::Create(handle_push_value_type,
-                                                              llvm::Function::ExternalLinkage,
-                                                              "handle_push_value",
-                                                              module.get());
 
-                // Register the handle_word_execute_name function.
-                auto handle_word_execute_name_type = llvm::FunctionType::get(int64_type,
-                                                                        { ptr_type, char_ptr_type },
-                                                                        false);
-                handle_word_execute_name_fn = llvm::Function::Create(handle_word_execute_name_type,
-                                                                    llvm::Function::ExternalLinkage,
-                                                                    "handle_word_execute_name",
-                                                                    module.get());
+        // The word's promoted locals indexed by name.
+        using PromotedLocals = std::unordered_map<std::string, PromotedLocal>;
 
-                // Register the handle_word_execute_index function.
-                auto handle_word_execute_index_type = llvm::FunctionType::get(int64_type,
-                                                                        { ptr_type, int64_type },
-                                                                        false);
-                handle_word_execute_index_fn = llvm::Function::Create(
-                                                                    handle_word_execute_index_type,
-                                                                    llvm::Function::ExternalLinkage,
-                                                                    "handle_word_execute_index",
-                                                                    module.get());
 
-                // Register the handle_word_index_name function.
-                auto handle_word_index_name_type = llvm::FunctionType::get(void_type,
-                                                                        { ptr_type, char_ptr_type },
-                                                                        false);
-                handle_word_index_name_fn = llvm::Function::Create(handle_word_index_name_type,
-                                                                   llvm::Function::ExternalLinkage,
-                                                                   "handle_word_index_name",
-                                                                   module.get());
+        // Raised during code generation if a promoted local variable is used in a way that doesn't
+        // fit how it's being stored.  The word's code is then generated again, either boxing the
+        // variable or leaving it to the interpreter.
+        struct LocalPromotionConflict
+        {
+            std::string name;
+            bool can_box;
+        };
 
-                // Register the handle_word_exists_name function.
-                auto handle_word_exists_name_type = llvm::FunctionType::get(void_type,
-                                                                        { ptr_type, char_ptr_type },
-                                                                        false);
-                handle_word_exists_name_fn = llvm::Function::Create(handle_word_exists_name_type,
-                                                                    llvm::Function::ExternalLinkage,
-                                                                    "handle_word_exists_name",
-                                                                    module.get());
-            }
 
+        // Is the instruction one that jumps, or sets up a jump, to a relative location?
+        bool is_relative_jump(const Instruction& instruction)
+        {
+            return    (instruction.id == Instruction::Id::jump)
+                   || (instruction.id == Instruction::Id::jump_if_zero)
+                   || (instruction.id == Instruction::Id::jump_if_not_zero)
+                   || (instruction.id == Instruction::Id::mark_loop_exit)
+                   || (instruction.id == Instruction::Id::mark_catch);
+        }
+
+
+        // Find the names that the code looks up at run-time without defining them itself.  Those
+        // lookups could find another word's local variables, so variables with these names can't
+        // be promoted.
+        void find_dynamic_names(InterpreterPtr& interpreter,
+                                const ByteCode& code,
+                                std::set<std::string>& names)
+        {
+            std::set<std::string> defined;
 
-            // JIT compile the given byte-code block into a native function handler.
-            WordFunction jit_bytecode(InterpreterPtr& interpreter, const Construction& construction)
+            for (const auto& instruction : code)
             {
-                // Make sure we have a name for the word that's usable for the JIT engine.
-                auto filtered_name = filter_word_name(construction.name);
-
-                // Create the context for this compilation.
-                auto [ module, context ] = create_jit_module_context(filtered_name);
-
-                // Jit compile the word and then finalize it's module.
-                auto [ locations, constants ] = jit_compile(interpreter,
-                                                            module,
-                                                            context,
-                                                            filtered_name,
-                                                            construction.code,
-                                                            CodeGenType::word);
-
-                // JIT compile and optimize the module, returning the IR for the word.
-                auto ir_map = finalize_module(std::move(module), std::move(context));
-
-                TrackingMemoryManager::FunctionSizes.clear();
-
-                // Finally return the new word handler function.
-                return create_word_function(filtered_name,
-                                            std::move(ir_map[filtered_name]),
-                                            std::move(locations),
-                                            std::move(constants),
-                                            CodeGenType::word);
+                if (   (   (instruction.id == Instruction::Id::def_variable)
+                        || (instruction.id == Instruction::Id::def_constant))
+                    && (instruction.value.is_string()))
+                {
+                    defined.insert(instruction.value.as_string(interpreter));
+                }
             }
 
-
-            // JIT compile the given byte-code block into the script's top level function handler.
-            // As well as all of the script's non-immediate words that have been cached during the
-            // byte-code compilation phase.
-            WordFunction jit_bytecode(InterpreterPtr& interpreter,
-                                      const std::string& name,
-                                      const ByteCode& code,
-                                      const std::map<std::string, Construction>& word_jit_cache)
+            for (const auto& instruction : code)
             {
-                struct GeneratedWord
+                if (   (   (instruction.id == Instruction::Id::execute)
+                        || (instruction.id == Instruction::Id::word_index)
+                        || (instruction.id == Instruction::Id::word_exists))
+                    && (instruction.value.is_string()))
                 {
-                    std::string name;
-                    std::vector<Location> locations;
-                    std::vector<Value> constants;
-                };
+                    auto name = instruction.value.as_string(interpreter);
 
-                std::map<std::string, GeneratedWord> generated_words;
+                    if (defined.find(name) == defined.end())
+                    {
+                        names.insert(name);
+                    }
+                }
+            }
+        }
 
-                // Create the context for this compilation.
-                auto [ module, context ] = create_jit_module_context(name);
 
-                // JIT compile the scripts words.
-                for (const auto& [ word_name, construction ] : word_jit_cache)
+        // Find the local variables and constants of a word that never escape it.  That is, the
+        // only things that are done with them are direct reads and writes within the word.
+        PromotedLocals find_promotable_locals(InterpreterPtr& interpreter,
+                                              const ByteCode& code,
+                                              const std::set<std::string>& dynamic_names)
+        {
+            PromotedLocals locals;
+            std::set<std::string> rejected;
+
+            auto name_at = [&](size_t index)
                 {
-                    auto filtered_name = filter_word_name(word_name);
+                    return code[index].value.as_string(interpreter);
+                };
 
-                    auto [ locations, constants ] = jit_compile(interpreter,
-                                                                module,
-                                                                context,
-                                                                filtered_name,
-                                                                construction.code,
-                                                                CodeGenType::word);
+            auto is_execute_name = [&](size_t index, const std::string& name)
+                {
+                    return    (index < code.size())
+                           && (code[index].id == Instruction::Id::execute)
+                           && (code[index].value.is_string())
+                           && (name_at(index) == name);
+                };
 
-                    generated_words.insert(
-                        {
-                            filtered_name,
-                            {
-                                .name = construction.name,
-                                .locations = std::move(locations),
-                                .constants = std::move(constants)
-                            }
-                        });
+            // Words that manage their own contexts can shadow and release variables part way
+            // through, so we leave them alone.
+            for (const auto& instruction : code)
+            {
+                if (   (instruction.id == Instruction::Id::mark_context)
+                    || (instruction.id == Instruction::Id::release_context))
+                {
+                    return {};
                 }
+            }
 
-                // JIT compile the script's top level function handler.
-                auto script_name = filter_word_name(name);
+            // Find the definitions.  Names that are defined more than once, or that other code
+            // may look up, are left to the interpreter.
+            for (size_t i = 0; i < code.size(); ++i)
+            {
+                bool is_variable = code[i].id == Instruction::Id::def_variable;
+                bool is_constant = code[i].id == Instruction::Id::def_constant;
 
-                auto [ locations, constants ] = jit_compile(interpreter,
-                                                            module,
-                                                            context,
-                                                            script_name,
-                                                            code,
-                                                            CodeGenType::script_body);
+                if (   ((!is_variable) && (!is_constant))
+                    || (!code[i].value.is_string()))
+                {
+                    continue;
+                }
 
-                // Finalize and optimize the module.
-                auto ir_map = finalize_module(std::move(module), std::move(context));
+                auto name = name_at(i);
 
-                // Now we can extract and register all of the generated words.
-                for (auto& [ word_name, generated_word ] : generated_words)
+                if (   (locals.find(name) != locals.end())
+                    || (dynamic_names.find(name) != dynamic_names.end()))
                 {
-                    auto handler = create_word_function(word_name,
-                                                        std::move(ir_map[word_name]),
-                                                        std::move(generated_word.locations),
-                                                        std::move(generated_word.constants),
-                                                        CodeGenType::word);
-
-                    interpreter->replace_word(generated_word.name, handler);
+                    rejected.insert(name);
+                    continue;
                 }
 
-                TrackingMemoryManager::FunctionSizes.clear();
+                PromotedLocal local;
 
-                // Return the script's top level function handler.
-                return create_word_function(script_name,
-                                            std::move(""),
-                                            //std::move(""),
-                                            std::move(locations),
-                                            std::move(constants),
-                                            CodeGenType::script_body);
-            }
+                local.definition = i;
+                local.is_constant = is_constant;
+                local.is_initialized =    (is_variable)
+                                       && (is_execute_name(i + 1, name))
+                                       && (i + 2 < code.size())
+                                       && (code[i + 2].id == Instruction::Id::write_variable);
 
+                locals[name] = local;
+            }
 
-            std::string disassemble(uint64_t address, size_t size)
+            // Now check every use of those names.  Constants can only be executed, and variables
+            // can only be read, written, incremented or decremented.
+            for (size_t i = 0; i < code.size(); ++i)
             {
-                // Gether up the information needed for the disassembly engine to know how to work
-                // for our runtime-target.
-
-                // Start off by getting the target triple from the JIT engine.
-                auto triple = jit->getTargetTriple();
-                std::string triple_name = triple.str();
-
-                // Make sure we can get the target information for the JIT engine.
-                std::string error;
-
-                auto target = llvm::TargetRegistry::lookupTarget(triple_name, error);
-                if (!target)
+                if (!code[i].value.is_string())
                 {
-                    throw_error("Error finding target: " + error);
+                    continue;
                 }
 
-                // Get the register information for this target.
-                std::unique_ptr<const llvm::MCRegisterInfo>
-                                                     reg_info(target->createMCRegInfo(triple_name));
-                if (!reg_info)
+                if (   (code[i].id == Instruction::Id::word_index)
+                    || (code[i].id == Instruction::Id::word_exists))
                 {
-                    throw_error("Error creating MCRegisterInfo.");
+                    rejected.insert(name_at(i));
+                    continue;
                 }
 
-                // Get the target options for this target.
-                llvm::MCTargetOptions options;
-                std::unique_ptr<const llvm::MCAsmInfo> asm_info(target->createMCAsmInfo(*reg_info,
-                                                                                        triple_name,
-                                                                                        options));
-                if (!asm_info)
+                if (code[i].id != Instruction::Id::execute)
                 {
-                    throw_error("Error creating MCAsmInfo for target" + triple_name + ".");
+                    continue;
                 }
 
-                // Get the sub-target information for this target.
-                std::unique_ptr<const llvm::MCSubtargetInfo> sti(
-                                         target->createMCSubtargetInfo(triple_name, "generic", ""));
-                if (!sti)
-                {
-                    throw_error("Error creating MCSubtargetInfo for target" + triple_name + ".");
-                }
+                auto name = name_at(i);
+                auto found = locals.find(name);
 
-                // Create the MC context for this target.
-                llvm::MCContext mc_context(triple, asm_info.get(), reg_info.get(), sti.get());
-                std::unique_ptr<llvm::MCDisassembler> disassembler(
-                                                    target->createMCDisassembler(*sti, mc_context));
-                if (!disassembler)
+                if (found == locals.end())
                 {
-                    throw_error("Error creating MCDisassembler for target" + triple_name + ".");
+                    continue;
                 }
 
-                // Get the instruction information for this target.
-                std::unique_ptr<const llvm::MCInstrInfo> instr_info(target->createMCInstrInfo());
-
-                // Create an instruction printer for this target.
-                std::unique_ptr<llvm::MCInstPrinter> inst_printer(
-                                                            target->createMCInstPrinter(triple,
-                                                                                        0,
-                                                                                        *asm_info,
-                                                                                        *instr_info,
-                                                                                        *reg_info));
-
-                // Create a temporay non-owning array reference for the code.
-                llvm::ArrayRef<uint8_t> code((uint8_t*)address, size);
-                uint64_t index = address;
-
-                // Create a buffer and a llvm string stream to hold the disassembly.
-                std::string disassembly;
-                llvm::raw_string_ostream stream(disassembly);
+                auto& local = found->second;
+                bool is_valid = false;
 
-                // Go through the array of code and disassemble each instruction in it, advancing
-                // the index by the size of the found instruction.
-                while (index < address + size)
+                if ((i > local.definition) && (local.is_constant))
                 {
-                    // The next instruction and it's size.
-                    llvm::MCInst inst;
-                    uint64_t inst_size;
+                    is_valid = true;
+                }
+                else if ((i > local.definition) && (i + 1 < code.size()))
+                {
+                    const auto& next = code[i + 1];
 
-                    // Try to disassemble the next instruction.
-                    if (disassembler->getInstruction(inst,
-                                                     inst_size,
-                                                     code.slice(index - address),
-                                                     index,
-                                                     llvm::nulls()))
+                    if (   (next.id == Instruction::Id::read_variable)
+                        || (next.id == Instruction::Id::write_variable))
                     {
-                        // We found a valid instruction, so print it out.
-                        stream << llvm::format("0x%016llx: ", index);
-                        inst_printer->printInst(&inst, index, "", *sti, stream);
-                        stream << "\n";
-
-                        // Advance the index by the size of the instruction, with the size retrieved
-                        // from the getInstruction call.
-                        index += inst_size;
+                        is_valid = true;
                     }
-                    else
+                    else if (   (next.id == Instruction::Id::execute)
+                             && (next.value.is_numeric()))
                     {
-                        // If we couldn't disassemble the instruction, then just print out the
-                        // address and that we couldn't disassemble it.  Then try to realign the
-                        // index by one byte to try to find valid instructions again.
-                        stream << llvm::format("0x%016llx:", index) << " <unknown>\n";
-                        ++index;
+                        auto index = next.value.as_integer(interpreter);
+                        auto intrinsic = interpreter->get_handler_info(index)
+                                                     .function
+                                                     .get_intrinsic();
+
+                        if (   (intrinsic == WordIntrinsic::increment_variable)
+                            || (intrinsic == WordIntrinsic::decrement_variable))
+                        {
+                            is_valid = true;
+                            local.is_incremented = true;
+                        }
                     }
                 }
 
-                // All done.
-                return disassembly;
+                if (!is_valid)
+                {
+                    rejected.insert(name);
+                }
             }
 
-
-            // Create the LLVM module, context, and builder for JITing code.
-            std::tuple<std::unique_ptr<llvm::Module>,
-                       std::unique_ptr<llvm::LLVMContext>>
-                            create_jit_module_context(const std::string& name)
+            // The definition has to run before any of the uses.  We check this conservatively,
+            // nothing before the definition may jump past it.
+            for (auto& [ name, local ] : locals)
             {
-                // Create the llvm module that will hold the JITed code.  Then register our helper
-                // functions with it.
-                auto context = std::make_unique<llvm::LLVMContext>();
-                auto module = std::make_unique<llvm::Module>("sorth_module_" + name,
-                                                             *context.get());
-                register_jit_helpers(module, context);
+                for (size_t i = 0; i < local.definition; ++i)
+                {
+                    if (   (is_relative_jump(code[i]))
+                        && (code[i].value.is_numeric())
+                        && (i + code[i].value.as_integer(interpreter) > local.definition))
+                    {
+                        rejected.insert(name);
+                        break;
+                    }
+                }
 
-                return { std::move(module), std::move(context) };
+                // Incremented variables have to be unboxed, so they need to start with a value.
+                if ((local.is_incremented) && (!local.is_initialized))
+                {
+                    rejected.insert(name);
+                }
             }
 
-
-            std::unordered_map<std::string,
-                               std::string>
-                finalize_module(std::unique_ptr<llvm::Module>&& module,
-                                std::unique_ptr<llvm::LLVMContext>&& context)
+            for (const auto& name : rejected)
             {
-                // Capture the optimized IR for all the module's functions.
-                std::unordered_map<std::string, std::string> ir_map;
-
-                // Uncomment to print out the LLVM IR for the JITed function module but before being
-                // optimized.
-                // module->print(llvm::outs(), nullptr);
+                locals.erase(name);
+            }
 
-                // Make sure that the generated module is viable.
-                std::string error_str;
-                llvm::raw_string_ostream error_stream(error_str);
+            return locals;
+        }
 
-                if (llvm::verifyModule(*module, &error_stream))
-                {
-                    error_stream.flush();
-                    throw_error("Module verification failed: " + error_str);
-                }
 
-                // Create the pass manager that will run the optimization passes on the module.
-                llvm::PassBuilder pass_builder;
-                llvm::LoopAnalysisManager loop_am;
-                llvm::FunctionAnalysisManager function_am;
-                llvm::CGSCCAnalysisManager cgsccam;
-                llvm::ModuleAnalysisManager module_am;
+        // Read an optimization level from the given environment variable.  We accept either a
+        // plain level number, 0 - 3, or the compiler style O0 - O3.  If the variable isn't set the
+        // level is left alone.
+        void read_opt_level_env(const char* name, int64_t& level)
+        {
+            auto env_value = std::getenv(name);
 
-                pass_builder.registerModuleAnalyses(module_am);
-                pass_builder.registerCGSCCAnalyses(cgsccam);
-                pass_builder.registerFunctionAnalyses(function_am);
-                pass_builder.registerLoopAnalyses(loop_am);
-                pass_builder.crossRegisterProxies(loop_am, function_am, cgsccam, module_am);
+            if (env_value == nullptr)
+            {
+                return;
+            }
 
-                llvm::ModulePassManager mpm =
-                            pass_builder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+            std::string text = env_value;
 
-                // Now, run the optimization passes on the module.
-                mpm.run(*module, module_am);
+            if (   (!text.empty())
+                && ((text[0] == 'O') || (text[0] == 'o')))
+            {
+                text = text.substr(1);
+            }
 
-                // Uncomment to print out the LLVM IR for the JITed function module after being
-                // optimized.
-                // module->print(llvm::outs(), nullptr);
+            if (   (text.size() == 1)
+                && (text[0] >= '0')
+                && (text[0] <= '3'))
+            {
+                level = text[0] - '0';
+            }
+            else
+            {
+                // The engine is created before main is called, so we can't throw an error here.
+                std::cerr << "Ignoring invalid " << name << " value, " << env_value
+                          << ", expected a level from 0 to 3." << std::endl;
+            }
+        }
 
-                // Capture Optimized IR for Each Function...
-                for (auto &function : module->functions())
-                {
-                    if (!function.isDeclaration())
-                    {
-                        std::string func_ir;
-                        llvm::raw_string_ostream rso(func_ir);
-                        function.print(rso);
-                        rso.flush();
 
-                        ir_map[function.getName().str()] = func_ir;
-                    }
-                }
+        // Read a yes/no setting from the given environment variable.  Anything other than 0, false,
+        // or no is taken as yes.  If the variable isn't set the flag is left alone.
+        void read_flag_env(const char* name, bool& flag)
+        {
+            auto env_value = std::getenv(name);
 
-                // Commit our module to the JIT engine and let it get compiled.
-                auto error = jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module),
-                                                                          std::move(context)));
+            if (env_value != nullptr)
+            {
+                std::string text = env_value;
 
-                if (error)
-                {
-                    std::string error_message;
+                flag = !((text == "0") || (text == "false") || (text == "no"));
+            }
+        }
 
-                    llvm::raw_string_ostream stream(error_message);
-                    llvm::logAllUnhandledErrors(std::move(error),
-                                                stream,
-                                                "Failed to jit module: ");
-                    stream.flush();
 
-                    throw_error(error_message);
-                }
+        // Read a non-negative count from the given environment variable.  If the variable isn't set
+        // the count is left alone.
+        void read_count_env(const char* name, int64_t& count)
+        {
+            auto env_value = std::getenv(name);
 
-                return ir_map;
+            if (env_value == nullptr)
+            {
+                return;
             }
 
+            std::string text = env_value;
 
-            // Create a function handler for the JITed code.
-            WordFunction create_word_function(const std::string& name,
-                                              std::string&& function_ir,
-                                              std::vector<Location>&& locations_,
-                                              std::vector<Value>&& constants_,
-                                              CodeGenType type)
+            if (   (!text.empty())
+                && (text.size() < 10)
+                && (text.find_first_not_of("0123456789") == std::string::npos))
             {
-                auto locations = std::move(locations_);
-                auto constants = std::move(constants_);
-
-                // Get our generated function from the jit engine.
-                auto symbol = jit->lookup(name);
-
-                if (!symbol)
-                {
-                    throw_error("Failed to find JITed function symbol " + name + ".");
-                }
-
-                auto compiled_function = symbol->toPtr<void (*)(void*, // interpreter
-                                                                const void*, // locations
-                                                                const void*)>(); // constants
-
+                count = std::stoll(text);
+            }
+            else
+            {
+                std::cerr << "Ignoring invalid " << name << " value, " << env_value
+                          << ", expected a count of 0 or more." << std::endl;
+            }
+        }
 
-                // Create the function that will hold the JITed code and return it to the caller.
-                auto handler_wrapper = [=, this](InterpreterPtr& interpreter) -> void
-                    {
-                        // The interpreter pointer is passed in as the first argument.  Convert it
-                        // to a void pointer for the JITed code.  We do the same for the locations
-                        // and constants vectors.
-                        void* interpreter_ptr = static_cast<void*>(&interpreter);
-                        const void* locations_ptr = static_cast<const void*>(&locations);
-                        const void* constants_ptr = static_cast<const void*>(&constants);
 
-                        // Clear any previous exception that may have occurred.
-                        clear_last_exception();
+        // Read the JIT settings, starting from the defaults and applying any overrides found in the
+        // environment.
+        JitSettings read_jit_settings()
+        {
+            JitSettings settings;
 
-                        // Mark our word's context for it's local variables.  But only if we're
-                        // compiling a word, not a script.
-                        if (type == CodeGenType::word)
-                        {
-                            interpreter->mark_context();
-                        }
+            read_opt_level_env("SORTH_JIT_OPT_LEVEL", settings.opt_level);
+            read_opt_level_env("SORTH_JIT_IMMEDIATE_OPT_LEVEL", settings.immediate_opt_level);
+            read_count_env("SORTH_JIT_IMMEDIATE_THRESHOLD", settings.immediate_threshold);
 
-                        // Call the JITed function.
-                        compiled_function(interpreter_ptr, locations_ptr, constants_ptr);
+            read_flag_env("SORTH_JIT_HOST_CPU", settings.use_host_cpu);
+            read_flag_env("SORTH_JIT_PROMOTE_LOCALS", settings.promote_locals);
 
-                        // Release the context, freeing up any local variables.
-                        if (type == CodeGenType::word)
-                        {
-                            interpreter->release_context();
-                        }
+            read_count_env("SORTH_JIT_THREADS", settings.compile_threads);
 
-                        // If an exception occurred in the JITed code, re-throw it.
-                        if (last_exception)
-                        {
-                            throw *last_exception;
-                        }
-                    };
+            read_flag_env("SORTH_JIT_LAZY", settings.lazy_words);
+            read_flag_env("SORTH_JIT_DEBUG", settings.capture_code);
+            read_flag_env("SORTH_JIT_PERF", settings.perf_map);
 
-                // Create a new handler object for our generated word.
-                WordFunction handler = WordFunction::Handler(handler_wrapper);
+            auto passes = std::getenv("SORTH_JIT_PASSES");
 
-                // Set the IR for the function.
-                handler.set_ir(function_ir);
+            if (passes != nullptr)
+            {
+                settings.passes = passes;
+            }
 
-                // Set the generated disassembly for the function.  If we were able to properly get
-                // it's address and size.
-                auto [ address, size ] = TrackingMemoryManager::FunctionSizes[name];
+            return settings;
+        }
 
-                if ((address) && (size > 0))
-                {
-                    // We have a proper address and size, so disassemble the function.
-                    handler.set_asm_code(disassemble(address, size));
-                }
 
-                // Return the new function handler.
-                return handler;
+        // Convert our numeric optimization levels into the llvm optimization levels.
+        llvm::OptimizationLevel to_optimization_level(int64_t level)
+        {
+            switch (level)
+            {
+                case 0:  return llvm::OptimizationLevel::O0;
+                case 1:  return llvm::OptimizationLevel::O1;
+                case 2:  return llvm::OptimizationLevel::O2;
+                default: return llvm::OptimizationLevel::O3;
             }
+        }
 
 
-            // JIT compile the given byte-code block into a native function handler.
-            std::tuple<std::vector<Location>,
-                       std::vector<Value>> jit_compile(InterpreterPtr& interpreter,
-                                                       std::unique_ptr<llvm::Module>& module,
-                                                       std::unique_ptr<llvm::LLVMContext>& context,
-                                                       const std::string& name,
-                                                       const ByteCode& code,
-                                                       CodeGenType type)
+        // Convert our numeric optimization levels into the llvm code generator levels.
+        llvm::CodeGenOptLevel to_code_gen_opt_level(int64_t level)
+        {
+            switch (level)
             {
-                // Create the instruction builder for the JITed code.
-                llvm::IRBuilder<> builder(*context.get());
-
-                // Gather up our basic types, and then create the function type for the JITed code.
-                auto void_type = llvm::Type::getVoidTy(*context.get());
-                auto ptr_type = llvm::PointerType::getUnqual(void_type);
+                case 0:  return llvm::CodeGenOptLevel::None;
+                case 1:  return llvm::CodeGenOptLevel::Less;
+                case 2:  return llvm::CodeGenOptLevel::Default;
+                default: return llvm::CodeGenOptLevel::Aggressive;
+            }
+        }
 
-                auto function_type = llvm::FunctionType::get(void_type,
-                                                             { ptr_type, ptr_type, ptr_type },
-                                                             false);
 
-                // Now, create the function that will hold the JITed code.
-                auto function = llvm::Function::Create(function_type,
-                                                       llvm::Function::ExternalLinkage,
-                                                       name,
-                                                       module.get());
+        // The declarations of the helper functions that the JITed code calls into.  Each llvm
+        // module gets it's own set, so that modules can be generated independently of each
+        // other.
+        struct JitHelpers
+        {
+            llvm::Function* handle_set_location_fn = nullptr;
+            llvm::Function* handle_manage_context_fn = nullptr;
 
-                // Keep track of source locations found in the byte-code so that we can later keep
-                // track of where exceptions occurred.
-                std::vector<Location> locations;
+            llvm::Function* handle_define_variable_fn = nullptr;
+            llvm::Function* handle_define_constant_fn = nullptr;
+            llvm::Function* handle_read_variable_fn = nullptr;
+            llvm::Function* handle_write_variable_fn = nullptr;
 
-                // Keep track of constant values that are to complex to be inlined in the generated
-                // code.
-                std::vector<Value> constants;
+            llvm::Function* handle_pop_bool_fn = nullptr;
+            llvm::Function* handle_pop_numeric_fn = nullptr;
+            llvm::Function* handle_pop_numeric_pair_fn = nullptr;
 
-                // Generate the body of the JITed function.
-                generate_function_body(interpreter,
-                                       module,
-                                       builder,
-                                       function,
-                                       context,
-                                       name,
-                                       locations,
-                                       constants,
-                                       code);
+            llvm::Function* handle_push_last_exception_fn = nullptr;
+            llvm::Function* handle_push_bool_fn = nullptr;
+            llvm::Function* handle_push_int_fn = nullptr;
+            llvm::Function* handle_push_double_fn = nullptr;
+            llvm::Function* handle_push_string_fn = nullptr;
+            llvm::Function* handle_push_value_fn = nullptr;
 
-                return { std::move(locations), std::move(constants) };
-            }
+            llvm::Function* handle_word_execute_name_fn = nullptr;
+            llvm::Function* handle_word_execute_index_fn = nullptr;
+            llvm::Function* handle_word_enter_fn = nullptr;
+            llvm::Function* handle_word_leave_fn = nullptr;
 
+            llvm::Function* handle_word_index_name_fn = nullptr;
+            llvm::Function* handle_word_exists_name_fn = nullptr;
 
-            // Generate the body of the JITed function.  We do this by walking the byte-code block
-            // and generating the appropriate llvm instructions for each operation.
-            void generate_function_body(InterpreterPtr& interpreter,
-                                        std::unique_ptr<llvm::Module>& module,
-                                        llvm::IRBuilder<>& builder,
-                                        llvm::Function* function,
-                                        std::unique_ptr<llvm::LLVMContext>& context,
-                                        const std::string& name,
-                                        std::vector<Location>& locations,
-                                        std::vector<Value>& constants,
-                                        const ByteCode& code)
-            {
-                // Gather some types we'll need.
-                auto bool_type = llvm::Type::getInt1Ty(*context.get());
-                auto int64_type = llvm::Type::getInt64Ty(*context.get());
-                auto double_type = llvm::Type::getDoubleTy(*context.get());
-                auto char_type = llvm::Type::getInt1Ty(*context.get());
+            llvm::Function* handle_init_locals_fn = nullptr;
+            llvm::Function* handle_free_locals_fn = nullptr;
+            llvm::Function* handle_reset_local_fn = nullptr;
+            llvm::Function* handle_read_local_fn = nullptr;
+            llvm::Function* handle_write_local_fn = nullptr;
 
+            llvm::Function* handle_spend_budget_fn = nullptr;
+        };
 
-                // Keep track of the basic blocks we create for the jump targets.
-                auto blocks = std::unordered_map<size_t, llvm::BasicBlock*>();
-                auto auto_jump_blocks = std::unordered_map<size_t, std::pair<llvm::BasicBlock*,
-                                                                             llvm::BasicBlock*>>();
 
-                // Create the entry block of the function.
-                auto entry_block = llvm::BasicBlock::Create(*context, "entry_block", function);
-                builder.SetInsertPoint(entry_block);
+        // Guards the engine's settings and statistics, and the registration of newly compiled
+        // words.  Compilation itself happens outside of the lock so that several interpreters can
+        // JIT compile at the same time.
+        std::mutex jit_lock;
 
-                // Get a reference to the interpreter pointer argument.
-                auto interpreter_ptr = function->getArg(0);
-                auto location_arr_ptr = function->getArg(1);
-                auto constant_arr_ptr = function->getArg(2);
 
-                // Keep track of any loop and catch block markers.
-                std::vector<std::pair<size_t, size_t>> loop_markers;
-                std::vector<size_t> catch_markers;
+        // The JIT engine, we hold the llvm context here.
+        struct JitEngine
+        {
+            // The llvm execution engine used for JITing code.
+            std::unique_ptr<llvm::orc::LLJIT> jit = nullptr;
 
-                // Keep track of any jump targets that are the target of a catch block.
-                std::set<size_t> catch_target_markers;
+            // The current optimization settings and the running compile statistics.
+            JitSettings settings;
+            JitStats stats;
 
-                // Take a first pass through the code to create the blocks that we'll need.
-                auto block_index = 1;
+            // For storing any errors that occur in the llvm engine.
+            std::string llvm_error_str;
 
-                for (size_t i = 0; i < code.size(); ++i)
-                {
-                    if (   (code[i].id == Instruction::Id::execute)
-                        || (code[i].id == Instruction::Id::jump_target)
-                        || (code[i].id == Instruction::Id::def_variable)
-                        || (code[i].id == Instruction::Id::def_constant)
-                        || (code[i].id == Instruction::Id::read_variable)
-                        || (code[i].id == Instruction::Id::write_variable)
-                        || (code[i].id == Instruction::Id::jump_loop_start)
-                        || (code[i].id == Instruction::Id::jump_loop_exit))
-                    {
-                        // These instructions are the ones that can start a new block.  In the case
-                        // of a jump target it is an explicit start of a block.  The jump
-                        // instruction is also the implicit end of a block.  For  the other
-                        // instructions it is an implicit start of a block.  Usually for exception
-                        // checking these instructions can call a function that can potentially
-                        // raise an exception.  So we create a new block for each of these
-                        // instructions.
-                        std::stringstream stream;
+            // Reporting JITed code to the perf profiler can only be turned on at start up.
+            bool is_perf_enabled = false;
+            PerfMap perf_map;
 
-                        stream << "block_" << block_index;
-                        ++block_index;
+            // Keep track of the last exception that occurred in the JITed code for each thread.
+            static thread_local std::optional<std::runtime_error> last_exception;
 
-                        blocks[i] = llvm::BasicBlock::Create(*context, stream.str(), function);
-                    }
-                    else if (   (code[i].id == Instruction::Id::jump_if_zero)
-                             || (code[i].id == Instruction::Id::jump_if_not_zero))
-                    {
-                        // These instructions have two jumps.  One jump for the pop error check and
-                        // one for the actual jump.  So we create two blocks for each of these jump
-                        // instructions.
-                        std::stringstream stream;
 
-                        stream << "block_" << block_index;
-                        ++block_index;
+            // Constructor for the JIT engine.  Initialize LLVM and create the execution engine.
+            // Also register our helper functions that will get called from the JITed code.
+            JitEngine()
+            {
+                // Initialize the llvm jit engine.
+                llvm::InitializeNativeTarget();
+                llvm::InitializeNativeTargetAsmPrinter();
+                llvm::InitializeNativeTargetAsmParser();
+                llvm::InitializeNativeTargetDisassembler();
 
-                        auto block_a = llvm::BasicBlock::Create(*context, stream.str(), function);
+                // Pick up the user's optimization settings.
+                settings = read_jit_settings();
 
-                        std::stringstream stream_b;
+                // The code generator's level is fixed for the life of the engine, so it follows the
+                // module optimization level given at start up.
+                auto jtmb = host_machine_builder(settings);
 
-                        stream_b << "block_" << block_index;
-                        ++block_index;
+                // If asked, let the perf tools know about the code we generate.  Through jitdump
+                // records if llvm was built with perf support, and our own perf map either way.
+                is_perf_enabled = settings.perf_map;
 
-                        auto block_b = llvm::BasicBlock::Create(*context, stream_b.str(), function);
+                auto perf_listener = is_perf_enabled
+                                     ? llvm::JITEventListener::createPerfJITEventListener()
+                                     : nullptr;
 
-                        auto_jump_blocks[i] = { block_a, block_b };
-                    }
+                // Construct the LLVM JIT engine, using the object linking layer creator to create
+                // and use our custom memory manager.  Script modules are compiled on several
+                // threads at once, so we use a compiler that creates a target machine for each
+                // compile instead of sharing one.
+                auto jit_result =
+                    llvm::orc::LLJITBuilder()
+                        .setJITTargetMachineBuilder(std::move(jtmb))
+                        .setCompileFunctionCreator([](llvm::orc::JITTargetMachineBuilder jtmb)
+                           -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>>
+                        {
+                            return std::make_unique<llvm::orc::ConcurrentIRCompiler>(
+                                                                                  std::move(jtmb));
+                        })
+                        .setObjectLinkingLayerCreator([=](llvm::orc::ExecutionSession& es,
+                                                          const llvm::Triple& triple)
+                                          -> llvm::Expected<std::unique_ptr<llvm::orc::ObjectLayer>>
+                        {
+                            // Create a standard object linking layer with our custom memory
+                            // manager, instead of the default one.
+                            auto layer = new llvm::orc::RTDyldObjectLinkingLayer(
+                                    es,
+                                    [=]() -> std::unique_ptr<llvm::RuntimeDyld::MemoryManager>
+                                    {
+                                        return std::make_unique<TrackingMemoryManager>();
+                                    });
+
+                            if (perf_listener != nullptr)
+                            {
+                                layer->registerJITEventListener(*perf_listener);
+                            }
+
+                            // Return our new object linking layer.
+                            return std::unique_ptr<llvm::orc::ObjectLayer>(layer);
+                        })
+                        .create();
+
+                if (!jit_result)
+                {
+                    std::string error_message;
+
+                    llvm::raw_string_ostream stream(error_message);
+                    llvm::logAllUnhandledErrors(jit_result.takeError(),
+                                                stream,
+                                                "Failed to create llvm JIT engine: ");
+                    stream.flush();
+
+                    throw_error(error_message);
+                }
+
+                // Save the jit engine and register the helper function symbols/types.
+                jit = std::move(*jit_result);
+                register_jit_helper_ptrs();
+
+                is_engine_alive = true;
+            }
+
+
+            // Any handlers still around can no longer free their code.
+            ~JitEngine()
+            {
+                is_engine_alive = false;
+            }
+
+
+            // Describe the machine we're generating code for.  Either the actual host CPU with all
+            // of it's features, or a generic CPU of the same architecture.
+            static llvm::orc::JITTargetMachineBuilder host_machine_builder(
+                                                                const JitSettings& machine_settings)
+            {
+                auto jtmb_result = llvm::orc::JITTargetMachineBuilder::detectHost();
+
+                if (!jtmb_result)
+                {
+                    std::string error_message;
+
+                    llvm::raw_string_ostream stream(error_message);
+                    llvm::logAllUnhandledErrors(jtmb_result.takeError(),
+                                                stream,
+                                                "Failed to detect the host machine: ");
+                    stream.flush();
+
+                    throw_error(error_message);
+                }
+
+                auto jtmb = std::move(*jtmb_result);
+
+                if (!machine_settings.use_host_cpu)
+                {
+                    jtmb.setCPU("generic");
+                    jtmb.getFeatures() = llvm::SubtargetFeatures();
+                }
+
+                jtmb.setCodeGenOptLevel(to_code_gen_opt_level(machine_settings.opt_level));
+
+                return jtmb;
+            }
+
+
+            // Map the helper function pointers to their symbols in the JIT engine.
+            void register_jit_helper_ptrs()
+            {
+                // Properly mangle symbols for the platform's ABI, on macOS this means we need a
+                // leading underscore.
+                auto mangle = [this](const std::string& name) -> llvm::orc::SymbolStringPtr
+                    {
+                        return jit->getExecutionSession().intern(platform_prefix + name);
+                    };
+
+                // Create the symbol map for the helper functions.
+                llvm::orc::SymbolMap symbol_map =
+                    {
+                        {
+                            mangle("handle_set_location"),
+                            llvm::orc::ExecutorSymbolDef(
+                                         llvm::orc::ExecutorAddr((uint64_t)&handle_set_location),
+                                         llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_manage_context"),
+                            llvm::orc::ExecutorSymbolDef(
+                                         llvm::orc::ExecutorAddr((uint64_t)&handle_manage_context),
+                                         llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_define_variable"),
+                            llvm::orc::ExecutorSymbolDef(
+                                         llvm::orc::ExecutorAddr((uint64_t)&handle_define_variable),
+                                         llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_define_constant"),
+                            llvm::orc::ExecutorSymbolDef(
+                                         llvm::orc::ExecutorAddr((uint64_t)&handle_define_constant),
+                                         llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_read_variable"),
+                            llvm::orc::ExecutorSymbolDef(
+                                           llvm::orc::ExecutorAddr((uint64_t)&handle_read_variable),
+                                           llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_write_variable"),
+                            llvm::orc::ExecutorSymbolDef(
+                                          llvm::orc::ExecutorAddr((uint64_t)&handle_write_variable),
+                                          llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_pop_bool"),
+                            llvm::orc::ExecutorSymbolDef(
+                                                llvm::orc::ExecutorAddr((uint64_t)&handle_pop_bool),
+                                                llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_pop_numeric"),
+                            llvm::orc::ExecutorSymbolDef(
+                                             llvm::orc::ExecutorAddr((uint64_t)&handle_pop_numeric),
+                                             llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_pop_numeric_pair"),
+                            llvm::orc::ExecutorSymbolDef(
+                                        llvm::orc::ExecutorAddr((uint64_t)&handle_pop_numeric_pair),
+                                        llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_push_last_exception"),
+                            llvm::orc::ExecutorSymbolDef(
+                                     llvm::orc::ExecutorAddr((uint64_t)&handle_push_last_exception),
+                                     llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_push_bool"),
+                            llvm::orc::ExecutorSymbolDef(
+                                               llvm::orc::ExecutorAddr((uint64_t)&handle_push_bool),
+                                               llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_push_int"),
+                            llvm::orc::ExecutorSymbolDef(
+                                                llvm::orc::ExecutorAddr((uint64_t)&handle_push_int),
+                                                llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_push_double"),
+                            llvm::orc::ExecutorSymbolDef(
+                                            llvm::orc::ExecutorAddr((uint64_t)&handle_push_double),
+                                            llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_push_string"),
+                            llvm::orc::ExecutorSymbolDef(
+                                            llvm::orc::ExecutorAddr((uint64_t)&handle_push_string),
+                                            llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_push_value"),
+                            llvm::orc::ExecutorSymbolDef(
+                                            llvm::orc::ExecutorAddr((uint64_t)&handle_push_value),
+                                            llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_word_execute_name"),
+                            llvm::orc::ExecutorSymbolDef(
+                                       llvm::orc::ExecutorAddr((uint64_t)&handle_word_execute_name),
+                                       llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_word_execute_index"),
+                            llvm::orc::ExecutorSymbolDef(
+                                      llvm::orc::ExecutorAddr((uint64_t)&handle_word_execute_index),
+                                      llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_word_enter"),
+                            llvm::orc::ExecutorSymbolDef(
+                                              llvm::orc::ExecutorAddr((uint64_t)&handle_word_enter),
+                                              llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_word_leave"),
+                            llvm::orc::ExecutorSymbolDef(
+                                              llvm::orc::ExecutorAddr((uint64_t)&handle_word_leave),
+                                              llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_word_index_name"),
+                            llvm::orc::ExecutorSymbolDef(
+                                         llvm::orc::ExecutorAddr((uint64_t)&handle_word_index_name),
+                                         llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_word_exists_name"),
+                            llvm::orc::ExecutorSymbolDef(
+                                        llvm::orc::ExecutorAddr((uint64_t)&handle_word_exists_name),
+                                        llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_init_locals"),
+                            llvm::orc::ExecutorSymbolDef(
+                                             llvm::orc::ExecutorAddr((uint64_t)&handle_init_locals),
+                                             llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_free_locals"),
+                            llvm::orc::ExecutorSymbolDef(
+                                             llvm::orc::ExecutorAddr((uint64_t)&handle_free_locals),
+                                             llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_reset_local"),
+                            llvm::orc::ExecutorSymbolDef(
+                                             llvm::orc::ExecutorAddr((uint64_t)&handle_reset_local),
+                                             llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_read_local"),
+                            llvm::orc::ExecutorSymbolDef(
+                                              llvm::orc::ExecutorAddr((uint64_t)&handle_read_local),
+                                              llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_write_local"),
+                            llvm::orc::ExecutorSymbolDef(
+                                             llvm::orc::ExecutorAddr((uint64_t)&handle_write_local),
+                                             llvm::JITSymbolFlags::Exported)
+                        },
+                        {
+                            mangle("handle_spend_budget"),
+                            llvm::orc::ExecutorSymbolDef(
+                                            llvm::orc::ExecutorAddr((uint64_t)&handle_spend_budget),
+                                            llvm::JITSymbolFlags::Exported)
+                        }
+                    };
+
+                // Register that map with the JIT engine.
+                auto error = jit->getMainJITDylib()
+                                         .define(llvm::orc::absoluteSymbols(std::move(symbol_map)));
+
+                if (error)
+                {
+                    std::string error_message;
+
+                    llvm::raw_string_ostream stream(error_message);
+                    llvm::logAllUnhandledErrors(std::move(error),
+                                                stream,
+                                                "Failed to define helper symbols: ");
+                    stream.flush();
+
+                    throw_error(error_message);
                 }
+            }
+
+
+            // Register the helper functions and their signatures that will be called from the JITed
+            // code.
+            JitHelpers register_jit_helpers(std::unique_ptr<llvm::Module>& module,
+                                            std::unique_ptr<llvm::LLVMContext>& context)
+            {
+                JitHelpers helpers;
+
+                // Gather up our basic types needed for the function signatures.
+                auto void_type = llvm::Type::getVoidTy(*context.get());
+                auto ptr_type = llvm::PointerType::getUnqual(void_type);
+                auto int64_type = llvm::Type::getInt64Ty(*context.get());
+                auto bool_type = llvm::Type::getInt1Ty(*context.get());
+                auto bool_ptr_type = llvm::PointerType::getUnqual(bool_type);
+                auto double_type = llvm::Type::getDoubleTy(*context.get());
+                auto char_type = llvm::Type::getInt8Ty(*context.get());
+                auto char_ptr_type = llvm::PointerType::getUnqual(char_type);
+
+
+                // Register the handle_set_location function.
+                auto handle_set_location_type = llvm::FunctionType::get(void_type,
+                                                                 { ptr_type, ptr_type, int64_type },
+                                                                 false);
+                helpers.handle_set_location_fn =
+                                        llvm::Function::Create(handle_set_location_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_set_location",
+                                                               module.get());
+
+                // Register the handle_manage_context function.
+                auto handle_manage_context_type = llvm::FunctionType::get(void_type,
+                                                                          { ptr_type, bool_type },
+                                                                          false);
+                helpers.handle_manage_context_fn =
+                                        llvm::Function::Create(handle_manage_context_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_manage_context",
+                                                               module.get());
+
+                // Register the handle_define_variable function.
+                auto handle_define_variable_type = llvm::FunctionType::get(int64_type,
+                                                                        { ptr_type, char_ptr_type },
+                                                                        false);
+                helpers.handle_define_variable_fn =
+                                        llvm::Function::Create(handle_define_variable_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_define_variable",
+                                                               module.get());
+
+                // Register the handle_define_constant function.
+                auto handle_define_constant_type = llvm::FunctionType::get(int64_type,
+                                                                        { ptr_type, char_ptr_type },
+                                                                        false);
+                helpers.handle_define_constant_fn =
+                                        llvm::Function::Create(handle_define_constant_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_define_constant",
+                                                               module.get());
+
+                // Register the handle_read_variable function.
+                auto handle_read_variable_type = llvm::FunctionType::get(int64_type, { ptr_type },
+                                                                         false);
+                helpers.handle_read_variable_fn =
+                                        llvm::Function::Create(handle_read_variable_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_read_variable",
+                                                               module.get());
+
+                // Register the handle_write_variable function.
+                auto handle_write_variable_type = llvm::FunctionType::get(int64_type, { ptr_type },
+                                                                          false);
+                helpers.handle_write_variable_fn =
+                                        llvm::Function::Create(handle_write_variable_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_write_variable",
+                                                               module.get());
+
+                // Register the handle_pop_bool function.
+                auto handle_pop_bool_type = llvm::FunctionType::get(int64_type,
+                                                                    { ptr_type, bool_ptr_type },
+                                                                    false);
+                helpers.handle_pop_bool_fn =
+                                        llvm::Function::Create(handle_pop_bool_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_pop_bool",
+                                                               module.get());
+
+                // Register the handle_pop_numeric function.
+                auto handle_pop_numeric_type = llvm::FunctionType::get(int64_type,
+                                                                       { ptr_type,
+                                                                         ptr_type,
+                                                                         ptr_type },
+                                                                       false);
+                helpers.handle_pop_numeric_fn =
+                                        llvm::Function::Create(handle_pop_numeric_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_pop_numeric",
+                                                               module.get());
+
+                // Register the handle_pop_numeric_pair function.
+                auto handle_pop_numeric_pair_type = llvm::FunctionType::get(int64_type,
+                                                                            { ptr_type,
+                                                                              bool_type,
+                                                                              ptr_type,
+                                                                              ptr_type,
+                                                                              ptr_type,
+                                                                              ptr_type },
+                                                                            false);
+                helpers.handle_pop_numeric_pair_fn =
+                                        llvm::Function::Create(handle_pop_numeric_pair_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_pop_numeric_pair",
+                                                               module.get());
+
+                // Register the handle_push_last_exception function.
+                auto handle_push_last_exception_type = llvm::FunctionType::get(void_type,
+                                                                        { ptr_type },
+                                                                        false);
+                helpers.handle_push_last_exception_fn =
+                                        llvm::Function::Create(handle_push_last_exception_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_push_last_exception",
+                                                               module.get());
+
+                // Register the handle_push_bool function.
+                auto handle_push_bool_type = llvm::FunctionType::get(void_type,
+                                                                     { ptr_type, bool_type },
+                                                                     false);
+                helpers.handle_push_bool_fn =
+                                        llvm::Function::Create(handle_push_bool_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_push_bool",
+                                                               module.get());
+
+                // Register the handle_push_int function.
+                auto handle_push_int_type = llvm::FunctionType::get(void_type,
+                                                                    { ptr_type, int64_type },
+                                                                    false);
+                helpers.handle_push_int_fn =
+                                        llvm::Function::Create(handle_push_int_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_push_int",
+                                                               module.get());
+
+                // Register the handle_push_double function.
+                auto handle_push_double_type = llvm::FunctionType::get(void_type,
+                                                                       { ptr_type, double_type },
+                                                                       false);
+                helpers.handle_push_double_fn =
+                                        llvm::Function::Create(handle_push_double_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_push_double",
+                                                               module.get());
+
+                // Register the handle_push_string function.
+                auto handle_push_string_type = llvm::FunctionType::get(void_type,
+                                                                      { ptr_type, char_ptr_type },
+                                                                      false);
+                helpers.handle_push_string_fn =
+                                        llvm::Function::Create(handle_push_string_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_push_string",
+                                                               module.get());
+
+                // Register the handle_push_value function.
+                auto handle_push_value_type = llvm::FunctionType::get(void_type,
+                                                                 { ptr_type, ptr_type, int64_type },
+                                                                 false);
+                helpers.handle_push_value_fn =
+                                        llvm::Function::Create(handle_push_value_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_push_value",
+                                                               module.get());
+
+                // Register the handle_word_execute_name function.
+                auto handle_word_execute_name_type = llvm::FunctionType::get(int64_type,
+                                                                        { ptr_type, char_ptr_type },
+                                                                        false);
+                helpers.handle_word_execute_name_fn =
+                                        llvm::Function::Create(handle_word_execute_name_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_word_execute_name",
+                                                               module.get());
+
+                // Register the handle_word_execute_index function.
+                auto handle_word_execute_index_type = llvm::FunctionType::get(int64_type,
+                                                                        { ptr_type, int64_type },
+                                                                        false);
+                helpers.handle_word_execute_index_fn =
+                                        llvm::Function::Create(handle_word_execute_index_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_word_execute_index",
+                                                               module.get());
+
+                // Register the handle_word_enter function.
+                auto handle_word_enter_type = llvm::FunctionType::get(void_type,
+                                                                      { ptr_type, int64_type },
+                                                                      false);
+                helpers.handle_word_enter_fn =
+                                        llvm::Function::Create(handle_word_enter_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_word_enter",
+                                                               module.get());
+
+                // Register the handle_word_leave function.
+                auto handle_word_leave_type = llvm::FunctionType::get(int64_type,
+                                                                      { ptr_type },
+                                                                      false);
+                helpers.handle_word_leave_fn =
+                                        llvm::Function::Create(handle_word_leave_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_word_leave",
+                                                               module.get());
+
+                // Register the handle_word_index_name function.
+                auto handle_word_index_name_type = llvm::FunctionType::get(void_type,
+                                                                        { ptr_type, char_ptr_type },
+                                                                        false);
+                helpers.handle_word_index_name_fn =
+                                        llvm::Function::Create(handle_word_index_name_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_word_index_name",
+                                                               module.get());
+
+                // Register the handle_word_exists_name function.
+                auto handle_word_exists_name_type = llvm::FunctionType::get(void_type,
+                                                                        { ptr_type, char_ptr_type },
+                                                                        false);
+                helpers.handle_word_exists_name_fn =
+                                        llvm::Function::Create(handle_word_exists_name_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_word_exists_name",
+                                                               module.get());
+
+                // Register the promoted local frame functions.
+                auto handle_frame_type = llvm::FunctionType::get(void_type,
+                                                                 { ptr_type, int64_type },
+                                                                 false);
+                helpers.handle_init_locals_fn =
+                                        llvm::Function::Create(handle_frame_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_init_locals",
+                                                               module.get());
+                helpers.handle_free_locals_fn =
+                                        llvm::Function::Create(handle_frame_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_free_locals",
+                                                               module.get());
+                helpers.handle_reset_local_fn =
+                                        llvm::Function::Create(handle_frame_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_reset_local",
+                                                               module.get());
+
+                // Register the handle_read_local function.
+                auto handle_read_local_type = llvm::FunctionType::get(void_type,
+                                                                      { ptr_type,
+                                                                        ptr_type,
+                                                                        int64_type,
+                                                                        bool_type },
+                                                                      false);
+                helpers.handle_read_local_fn =
+                                        llvm::Function::Create(handle_read_local_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_read_local",
+                                                               module.get());
+
+                // Register the handle_write_local function.
+                auto handle_write_local_type = llvm::FunctionType::get(int64_type,
+                                                                       { ptr_type,
+                                                                         ptr_type,
+                                                                         int64_type },
+                                                                       false);
+                helpers.handle_write_local_fn =
+                                        llvm::Function::Create(handle_write_local_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_write_local",
+                                                               module.get());
+
+                // Register the handle_spend_budget function.
+                auto handle_spend_budget_type = llvm::FunctionType::get(void_type,
+                                                                        { ptr_type, int64_type },
+                                                                        false);
+                helpers.handle_spend_budget_fn =
+                                        llvm::Function::Create(handle_spend_budget_type,
+                                                               llvm::Function::ExternalLinkage,
+                                                               "handle_spend_budget",
+                                                               module.get());
+
+                // The helpers catch any exceptions raised and report them through their results
+                // instead, so none of them ever unwind.  This lets llvm skip any unwind handling
+                // around the calls.
+                for (auto& function : module->functions())
+                {
+                    function.addFnAttr(llvm::Attribute::NoUnwind);
+                }
+
+                return helpers;
+            }
+
+
+            // Get a copy of the current settings, so that a compile sees a consistent set of them
+            // even if they're changed by another thread.
+            JitSettings current_settings()
+            {
+                std::lock_guard<std::mutex> lock(jit_lock);
+
+                return settings;
+            }
+
+
+            // JIT compile the given byte-code block into a native function handler.
+            WordFunction jit_bytecode(InterpreterPtr& interpreter, const Construction& construction)
+            {
+                auto compile_settings = current_settings();
+
+                // Immediate words get their own, usually much cheaper, optimization level and
+                // always use the default pass pipeline.
+                return jit_single_word(interpreter,
+                                       construction,
+                                       compile_settings,
+                                       compile_settings.immediate_opt_level,
+                                       "",
+                                       {});
+            }
+
+
+            // JIT compile a single word into it's own module, at the given optimization level.
+            WordFunction jit_single_word(InterpreterPtr& interpreter,
+                                         const Construction& construction,
+                                         const JitSettings& compile_settings,
+                                         int64_t opt_level,
+                                         const std::string& passes,
+                                         const std::set<std::string>& dynamic_names)
+            {
+                // Make sure we have a name for the word that's usable for the JIT engine.
+                auto filtered_name = filter_word_name(construction.name);
+
+                // Create the context for this compilation.
+                auto [ module, context, helpers ] = create_jit_module_context(filtered_name);
+
+                // Jit compile the word and then finalize it's module.
+                auto data = std::make_shared<JitWordData>();
+                auto code = std::make_shared<JitCode>();
+
+                code->trackers.push_back(jit->getMainJITDylib().createResourceTracker());
+                code->data.push_back(data);
+
+                jit_compile(interpreter,
+                            module,
+                            context,
+                            helpers,
+                            compile_settings,
+                            filtered_name,
+                            construction.code,
+                            CodeGenType::word,
+                            *data,
+                            {},
+                            dynamic_names);
+
+                // JIT compile and optimize the module, returning the IR for the word.
+                auto ir_map = finalize_module(std::move(module),
+                                              std::move(context),
+                                              code->trackers.back(),
+                                              opt_level,
+                                              passes,
+                                              compile_settings.capture_code);
+
+                // Finally return the new word handler function.
+                return create_word_function(filtered_name,
+                                            profiler_name(construction.name,
+                                                          construction.location),
+                                            std::move(ir_map[filtered_name]),
+                                            data,
+                                            code,
+                                            CodeGenType::word,
+                                            compile_settings.capture_code);
+            }
+
+
+            // Create the handler for a word that compiles the word the first time it's called.
+            // Until then the word costs nothing more than keeping a copy of it's byte-code.
+            WordFunction create_lazy_word(const Construction& construction,
+                                          std::shared_ptr<const std::set<std::string>> names)
+            {
+                auto state = std::make_shared<LazyWordState>();
+
+                state->construction = construction;
+                state->dynamic_names = names;
+
+                auto handler_wrapper = [state, this](InterpreterPtr& interpreter) -> void
+                    {
+                        if (!state->is_compiled.load(std::memory_order_acquire))
+                        {
+                            std::lock_guard<std::mutex> lock(state->lock);
+
+                            if (!state->is_compiled.load(std::memory_order_relaxed))
+                            {
+                                auto compile_settings = current_settings();
+
+                                state->handler = jit_single_word(interpreter,
+                                                                 state->construction,
+                                                                 compile_settings,
+                                                                 compile_settings.opt_level,
+                                                                 compile_settings.passes,
+                                                                 *state->dynamic_names);
+                                state->handler.set_intrinsic(state->construction.intrinsic);
+
+                                // We don't need the byte-code anymore, the interpreter keeps it's
+                                // own copy.
+                                state->construction.code.clear();
+                                state->is_compiled.store(true, std::memory_order_release);
+                            }
+                        }
+
+                        state->handler(interpreter);
+                    };
+
+                WordFunction handler = WordFunction::Handler(handler_wrapper);
+
+                handler.set_intrinsic(construction.intrinsic);
+
+                return handler;
+            }
+
+
+            // Instead of compiling the script's words, register stubs for them that compile each
+            // word on it's first call.
+            void register_lazy_words(InterpreterPtr& interpreter,
+                                     const ByteCode& code,
+                                     const std::map<std::string, Construction>& word_jit_cache)
+            {
+                // The names looked up at run-time are gathered over the whole script, as they are
+                // when compiling eagerly.
+                auto dynamic_names = std::make_shared<std::set<std::string>>();
+
+                find_dynamic_names(interpreter, code, *dynamic_names);
+
+                for (const auto& [ word_name, construction ] : word_jit_cache)
+                {
+                    find_dynamic_names(interpreter, construction.code, *dynamic_names);
+                }
+
+                for (const auto& [ word_name, construction ] : word_jit_cache)
+                {
+                    interpreter->replace_word(construction.name,
+                                              create_lazy_word(construction, dynamic_names));
+                }
+
+                std::lock_guard<std::mutex> lock(jit_lock);
+                stats.deferred_words += word_jit_cache.size();
+            }
+
+
+            // Split up the script's words into partitions of roughly equal size, one for each
+            // thread that will be compiling them.  The biggest words are placed first, each into
+            // the partition with the least work so far.
+            std::vector<JitPartition> partition_words(
+                                     const std::map<std::string, Construction>& word_jit_cache,
+                                     const ByteCode& code,
+                                     int64_t compile_threads)
+            {
+                size_t count = compile_threads > 0
+                               ? compile_threads
+                               : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+                count = std::min(count, word_jit_cache.size() + 1);
+
+                // Gather up the words by size, the script's top level code is the entry without a
+                // name.
+                std::vector<std::pair<size_t, const std::string*>> entries;
+
+                entries.push_back({ code.size(), nullptr });
+
+                for (const auto& [ word_name, construction ] : word_jit_cache)
+                {
+                    entries.push_back({ construction.code.size(), &word_name });
+                }
+
+                std::stable_sort(entries.begin(),
+                                 entries.end(),
+                                 [](const auto& a, const auto& b) { return a.first > b.first; });
+
+                // Now hand out the words.
+                std::vector<JitPartition> partitions(count);
+
+                for (const auto& [ size, word_name ] : entries)
+                {
+                    auto smallest = std::min_element(partitions.begin(),
+                                                     partitions.end(),
+                                                     [](const auto& a, const auto& b)
+                                                     {
+                                                         return a.size < b.size;
+                                                     });
+
+                    if (word_name != nullptr)
+                    {
+                        smallest->words.push_back(*word_name);
+                    }
+                    else
+                    {
+                        smallest->has_script_body = true;
+                    }
+
+                    // Count every entry as at least one instruction, so that empty words are
+                    // still spread out and no partition is left without anything to compile.
+                    smallest->size += size + 1;
+                }
+
+                return partitions;
+            }
+
+
+            // Optimize the partition's module and generate it's machine code.  This is run on it's
+            // own thread, so any errors are saved in the partition for the calling thread to
+            // report.
+            void compile_partition(JitPartition& partition,
+                                   const std::string& symbol_name,
+                                   const JitSettings& compile_settings)
+            {
+                try
+                {
+                    partition.ir_map = finalize_module(std::move(partition.module),
+                                                       std::move(partition.context),
+                                                       partition.tracker,
+                                                       compile_settings.opt_level,
+                                                       compile_settings.passes,
+                                                       compile_settings.capture_code);
+
+                    // Looking up any one of the module's symbols has llvm generate the machine code
+                    // for the whole module.  So do that now while we're on the worker thread.
+                    auto start_time = std::chrono::steady_clock::now();
+
+                    auto symbol = jit->lookup(symbol_name);
+
+                    if (!symbol)
+                    {
+                        std::string error_message;
+
+                        llvm::raw_string_ostream stream(error_message);
+                        llvm::logAllUnhandledErrors(symbol.takeError(),
+                                                    stream,
+                                                    "Failed to generate code for module: ");
+                        stream.flush();
+
+                        throw_error(error_message);
+                    }
+
+                    auto code_gen_time = std::chrono::steady_clock::now() - start_time;
+
+                    std::lock_guard<std::mutex> lock(jit_lock);
+                    stats.code_generation_time += code_gen_time;
+                }
+                catch (...)
+                {
+                    partition.error = std::current_exception();
+                }
+            }
+
+
+            // JIT compile the given byte-code block into the script's top level function handler.
+            // As well as all of the script's non-immediate words that have been cached during the
+            // byte-code compilation phase.
+            //
+            // The words are split up across several llvm modules which are optimized and compiled
+            // in parallel.  Generating the IR needs the interpreter, so that part is still done on
+            // the calling thread.
+            WordFunction jit_bytecode(InterpreterPtr& interpreter,
+                                      const std::string& name,
+                                      const ByteCode& code,
+                                      const std::map<std::string, Construction>& word_jit_cache)
+            {
+                struct GeneratedWord
+                {
+                    std::string name;
+                    std::string display_name;
+                    WordIntrinsic intrinsic;
+                    JitWordDataPtr data;
+                    std::optional<int64_t> handler_index;
+                };
+
+                std::map<std::string, GeneratedWord> generated_words;
+
+                // Every call to filter_word_name gives a new unique name, so remember the one each
+                // word was given.
+                std::map<std::string, std::string> filtered_names;
+
+                auto compile_settings = current_settings();
+
+                // In lazy mode only the script's top level code is compiled now.
+                if (   (compile_settings.lazy_words)
+                    && (!word_jit_cache.empty()))
+                {
+                    register_lazy_words(interpreter, code, word_jit_cache);
+                    return jit_bytecode(interpreter, name, code, {});
+                }
+
+                // Gather up the names that the script looks up at run-time, any local variables
+                // with those names have to stay visible in the interpreter.
+                std::set<std::string> dynamic_names;
+
+                find_dynamic_names(interpreter, code, dynamic_names);
+
+                // Create the run-time data for all of the script's words up front.  The words, and
+                // the script itself, can call each other directly, even across modules, so the
+                // generated code needs to know where that data lives.
+                for (const auto& [ word_name, construction ] : word_jit_cache)
+                {
+                    auto [ found, word ] = interpreter->find_word(construction.name);
+                    auto filtered_name = filter_word_name(word_name);
+
+                    filtered_names[word_name] = filtered_name;
+
+                    generated_words.insert(
+                        {
+                            filtered_name,
+                            {
+                                .name = construction.name,
+                                .display_name = profiler_name(construction.name,
+                                                              construction.location),
+                                .intrinsic = construction.intrinsic,
+                                .data = std::make_shared<JitWordData>(),
+                                .handler_index = found ? std::optional<int64_t>(word.handler_index)
+                                                       : std::nullopt
+                            }
+                        });
+
+                    find_dynamic_names(interpreter, construction.code, dynamic_names);
+                }
+
+                // Generate the IR for each partition of the script in it's own module.
+                auto partitions = partition_words(word_jit_cache,
+                                                  code,
+                                                  compile_settings.compile_threads);
+                auto script_name = filter_word_name(name);
+                auto script_data = std::make_shared<JitWordData>();
+                auto code_unit = std::make_shared<JitCode>();
+
+                code_unit->data.push_back(script_data);
+
+                for (const auto& [ word_name, generated_word ] : generated_words)
+                {
+                    code_unit->data.push_back(generated_word.data);
+                }
+
+                std::vector<std::string> partition_symbols;
+
+                for (size_t i = 0; i < partitions.size(); ++i)
+                {
+                    auto& partition = partitions[i];
+                    auto [ module, context, helpers ] =
+                                         create_jit_module_context(name + "_" + std::to_string(i));
+
+                    // Declare all of the script's words in this module so that they can be called
+                    // directly, wherever they end up being defined.
+                    DirectCallMap direct_calls;
+
+                    for (const auto& [ word_name, generated_word ] : generated_words)
+                    {
+                        if (generated_word.handler_index)
+                        {
+                            auto function = declare_word_function(module, context, word_name);
+
+                            direct_calls[generated_word.handler_index.value()] =
+                                                                { function, generated_word.data };
+                        }
+                    }
+
+                    // JIT compile the partition's words.
+                    for (const auto& word_name : partition.words)
+                    {
+                        auto& filtered_name = filtered_names.at(word_name);
+
+                        jit_compile(interpreter,
+                                    module,
+                                    context,
+                                    helpers,
+                                    compile_settings,
+                                    filtered_name,
+                                    word_jit_cache.at(word_name).code,
+                                    CodeGenType::word,
+                                    *generated_words.at(filtered_name).data,
+                                    direct_calls,
+                                    dynamic_names);
+                    }
+
+                    // JIT compile the script's top level function handler, if it's here.
+                    if (partition.has_script_body)
+                    {
+                        jit_compile(interpreter,
+                                    module,
+                                    context,
+                                    helpers,
+                                    compile_settings,
+                                    script_name,
+                                    code,
+                                    CodeGenType::script_body,
+                                    *script_data,
+                                    direct_calls,
+                                    dynamic_names);
+                    }
+
+                    partition_symbols.push_back(partition.has_script_body
+                                                ? script_name
+                                                : filtered_names.at(partition.words.front()));
+
+                    partition.module = std::move(module);
+                    partition.context = std::move(context);
+                    partition.tracker = jit->getMainJITDylib().createResourceTracker();
+
+                    code_unit->trackers.push_back(partition.tracker);
+                }
+
+                // Optimize and generate the machine code for the partitions in parallel.  The
+                // calling thread takes the first partition itself.
+                std::vector<std::thread> threads;
+
+                for (size_t i = 1; i < partitions.size(); ++i)
+                {
+                    threads.emplace_back([&, i]()
+                        {
+                            compile_partition(partitions[i],
+                                              partition_symbols[i],
+                                              compile_settings);
+                        });
+                }
+
+                compile_partition(partitions[0], partition_symbols[0], compile_settings);
+
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+
+                std::unordered_map<std::string, std::string> ir_map;
+
+                for (auto& partition : partitions)
+                {
+                    if (partition.error)
+                    {
+                        std::rethrow_exception(partition.error);
+                    }
+
+                    ir_map.merge(partition.ir_map);
+                }
+
+                // Now we can extract and register all of the generated words.
+                for (auto& [ word_name, generated_word ] : generated_words)
+                {
+                    auto handler = create_word_function(word_name,
+                                                        generated_word.display_name,
+                                                        std::move(ir_map[word_name]),
+                                                        generated_word.data,
+                                                        code_unit,
+                                                        CodeGenType::word,
+                                                        compile_settings.capture_code);
+
+                    handler.set_intrinsic(generated_word.intrinsic);
+                    handler.set_direct_call_flag(generated_word.data->is_current);
+                    interpreter->replace_word(generated_word.name, handler);
+                }
+
+                // Return the script's top level function handler.
+                return create_word_function(script_name,
+                                            "sorth:" + name,
+                                            std::move(""),
+                                            script_data,
+                                            code_unit,
+                                            CodeGenType::script_body,
+                                            false);
+            }
+
+
+            // Compile the script's top level code and all of it's run-time words into a native
+            // object file instead of the JIT engine.  Along with the code the object holds the
+            // description of the script that sorth_aot_main needs to register it's words, and a
+            // main function that calls it.
+            void aot_compile(InterpreterPtr& interpreter,
+                             const std::string& name,
+                             const ByteCode& code,
+                             const std::map<std::string, Construction>& word_jit_cache,
+                             size_t first_handler,
+                             const std::filesystem::path& object_path)
+            {
+                struct AotGeneratedWord
+                {
+                    std::string name;
+                    std::string function_name;
+                    Word word;
+                    JitWordData data;
+                };
+
+                std::vector<AotGeneratedWord> words;
+
+                auto compile_settings = current_settings();
+
+                // Every word created while the script was compiled has to be created again, at the
+                // same handler index, before the script is run.  We can only do that for the
+                // script's own words, not for words created by native code such as a structure's
+                // accessors.
+                for (size_t index = first_handler; index < interpreter->handler_count(); ++index)
+                {
+                    auto& info = interpreter->get_handler_info(index);
+                    auto [ found, word ] = interpreter->find_word(info.name);
+
+                    if (   (!found)
+                        || (word.handler_index != index))
+                    {
+                        throw_error(interpreter,
+                                    "The word " + info.name + " has been redefined, it can not "
+                                    "be compiled ahead of time.");
+                    }
+
+                    if (   (word.execution_context == ExecutionContext::run_time)
+                        && (!word_jit_cache.contains(info.name)))
+                    {
+                        throw_error(interpreter,
+                                    "The word " + info.name + " can not be compiled ahead of "
+                                    "time, only words that can be JIT compiled are supported.");
+                    }
+
+                    words.push_back({ .name = info.name, .function_name = "", .word = word });
+                }
+
+                // Gather up the names that the script looks up at run-time, as we do when JIT
+                // compiling.
+                std::set<std::string> dynamic_names;
+
+                find_dynamic_names(interpreter, code, dynamic_names);
+
+                for (const auto& [ word_name, construction ] : word_jit_cache)
+                {
+                    find_dynamic_names(interpreter, construction.code, dynamic_names);
+                }
+
+                // The whole script goes into one module, generated for the host machine.  The
+                // object is going to be linked into a position independent executable.
+                auto [ module, context, helpers ] = create_jit_module_context(name);
+
+                auto jtmb = host_machine_builder(compile_settings);
+                jtmb.setRelocationModel(llvm::Reloc::PIC_);
+
+                auto machine_result = jtmb.createTargetMachine();
+
+                if (!machine_result)
+                {
+                    std::string error_message;
+
+                    llvm::raw_string_ostream stream(error_message);
+                    llvm::logAllUnhandledErrors(machine_result.takeError(),
+                                                stream,
+                                                "Failed to create the target machine: ");
+                    stream.flush();
+
+                    throw_error(error_message);
+                }
+
+                auto machine = std::move(*machine_result);
+
+                module->setTargetTriple(machine->getTargetTriple().str());
+                module->setDataLayout(machine->createDataLayout());
+
+                // Generate the code for the script's words.  They can't call each other directly
+                // as the run-time data they'd need doesn't exist until the script is started.
+                for (auto& word : words)
+                {
+                    if (word.word.execution_context == ExecutionContext::compile_time)
+                    {
+                        continue;
+                    }
+
+                    word.function_name = filter_word_name(word.name);
+
+                    jit_compile(interpreter,
+                                module,
+                                context,
+                                helpers,
+                                compile_settings,
+                                word.function_name,
+                                word_jit_cache.at(word.name).code,
+                                CodeGenType::word,
+                                word.data,
+                                {},
+                                dynamic_names);
+                }
+
+                // Then the script's top level code.
+                AotGeneratedWord body =
+                    {
+                        .name = name,
+                        .function_name = filter_word_name(name),
+                        .word =
+                            {
+                                .execution_context = ExecutionContext::run_time,
+                                .type = WordType::scripted,
+                                .visibility = WordVisibility::visible,
+                                .description = "",
+                                .signature = "",
+                                .location = Location(name, 1, 1),
+                                .handler_index = 0
+                            }
+                    };
+
+                jit_compile(interpreter,
+                            module,
+                            context,
+                            helpers,
+                            compile_settings,
+                            body.function_name,
+                            code,
+                            CodeGenType::script_body,
+                            body.data,
+                            {},
+                            dynamic_names);
+
+                // The generated functions are only reached through the script's description, and
+                // the helpers are found in the sorth library under their exported names.
+                for (auto& function : module->functions())
+                {
+                    auto function_name = function.getName().str();
+
+                    if (!function.isDeclaration())
+                    {
+                        function.setLinkage(llvm::GlobalValue::InternalLinkage);
+                    }
+                    else if (function_name.starts_with("handle_"))
+                    {
+                        function.setName("sorth_aot_" + function_name);
+                    }
+                }
+
+                // Now describe the script, the layout of these types matches the Aot structures in
+                // jit.h.
+                auto& llvm_context = *context.get();
+
+                auto void_type = llvm::Type::getVoidTy(llvm_context);
+                auto ptr_type = llvm::PointerType::getUnqual(void_type);
+                auto int32_type = llvm::Type::getInt32Ty(llvm_context);
+                auto int64_type = llvm::Type::getInt64Ty(llvm_context);
+                auto double_type = llvm::Type::getDoubleTy(llvm_context);
+
+                auto location_type = llvm::StructType::create(llvm_context,
+                                                              { ptr_type, int64_type, int64_type },
+                                                              "sorth_aot_location");
+                auto value_type = llvm::StructType::create(llvm_context,
+                                                           {
+                                                               int64_type,
+                                                               int64_type,
+                                                               double_type,
+                                                               ptr_type,
+                                                               ptr_type,
+                                                               int64_type
+                                                           },
+                                                           "sorth_aot_value");
+                auto word_type = llvm::StructType::create(llvm_context,
+                                                          {
+                                                              ptr_type,
+                                                              ptr_type,
+                                                              ptr_type,
+                                                              int64_type,
+                                                              ptr_type,
+                                                              int64_type,
+                                                              ptr_type,
+                                                              ptr_type,
+                                                              location_type,
+                                                              int64_type
+                                                          },
+                                                          "sorth_aot_word");
+                auto script_type = llvm::StructType::create(llvm_context,
+                                                            {
+                                                                ptr_type,
+                                                                ptr_type,
+                                                                int64_type,
+                                                                ptr_type,
+                                                                int64_type,
+                                                                word_type
+                                                            },
+                                                            "sorth_aot_script");
+
+                llvm::Constant* null_ptr = llvm::ConstantPointerNull::get(ptr_type);
+
+                auto int_constant = [&](int64_t value) -> llvm::Constant*
+                    {
+                        return llvm::ConstantInt::get(int64_type, value);
+                    };
+
+                // The same strings, mostly source paths, come up over and over so each one is only
+                // stored once.
+                std::unordered_map<std::string, llvm::Constant*> strings;
+
+                auto string_constant = [&](const std::string& text) -> llvm::Constant*
+                    {
+                        auto& global = strings[text];
+
+                        if (global == nullptr)
+                        {
+                            auto data = llvm::ConstantDataArray::getString(llvm_context,
+                                                                           text,
+                                                                           true);
+
+                            global = new llvm::GlobalVariable(*module,
+                                                              data->getType(),
+                                                              true,
+                                                              llvm::GlobalValue::PrivateLinkage,
+                                                              data);
+                        }
+
+                        return global;
+                    };
+
+                auto array_constant = [&](llvm::Type* type,
+                                          const std::vector<llvm::Constant*>& items)
+                                          -> llvm::Constant*
+                    {
+                        if (items.empty())
+                        {
+                            return null_ptr;
+                        }
+
+                        auto array_type = llvm::ArrayType::get(type, items.size());
+
+                        return new llvm::GlobalVariable(*module,
+                                                        array_type,
+                                                        true,
+                                                        llvm::GlobalValue::PrivateLinkage,
+                                                        llvm::ConstantArray::get(array_type,
+                                                                                 items));
+                    };
+
+                auto location_constant = [&](const Location& location) -> llvm::Constant*
+                    {
+                        return llvm::ConstantStruct::get(location_type,
+                                                         {
+                                                             string_constant(location.get_path()),
+                                                             int_constant(location.get_line()),
+                                                             int_constant(location.get_column())
+                                                         });
+                    };
+
+                // Complex constants, like byte-code blocks, live in the interpreter's memory.  So
+                // there's no way to write them into the object file.
+                std::function<llvm::Constant*(const std::string&, const Value&)> value_constant =
+                    [&](const std::string& word_name, const Value& value) -> llvm::Constant*
+                    {
+                        AotValueType type = AotValueType::none;
+                        int64_t integer = 0;
+                        double floating = 0.0;
+                        llvm::Constant* string = null_ptr;
+                        std::vector<llvm::Constant*> items;
+
+                        if (value.is_none())
+                        {
+                            type = AotValueType::none;
+                        }
+                        else if (value.is_bool())
+                        {
+                            type = AotValueType::boolean;
+                            integer = value.as_bool();
+                        }
+                        else if (value.is_integer())
+                        {
+                            type = AotValueType::integer;
+                            integer = value.as_integer(interpreter);
+                        }
+                        else if (value.is_float())
+                        {
+                            type = AotValueType::floating;
+                            floating = value.as_float(interpreter);
+                        }
+                        else if (value.is_string())
+                        {
+                            type = AotValueType::string;
+                            string = string_constant(value.as_string(interpreter));
+                        }
+                        else if (value.is_array())
+                        {
+                            auto array = value.as_array(interpreter);
+
+                            type = AotValueType::array;
+
+                            for (size_t i = 0; i < array->size(); ++i)
+                            {
+                                items.push_back(value_constant(word_name, (*array)[i]));
+                            }
+                        }
+                        else
+                        {
+                            throw_error(interpreter,
+                                        "The word " + word_name + " uses constant values that "
+                                        "can not be compiled ahead of time.");
+                        }
+
+                        return llvm::ConstantStruct::get(value_type,
+                                                         {
+                                                             int_constant((int64_t)type),
+                                                             int_constant(integer),
+                                                             llvm::ConstantFP::get(double_type,
+                                                                                   floating),
+                                                             string,
+                                                             array_constant(value_type, items),
+                                                             int_constant(items.size())
+                                                         });
+                    };
+
+                auto word_constant = [&](const AotGeneratedWord& word) -> llvm::Constant*
+                    {
+                        std::vector<llvm::Constant*> locations;
+                        std::vector<llvm::Constant*> constants;
+
+                        for (const auto& location : word.data.locations)
+                        {
+                            locations.push_back(location_constant(location));
+                        }
+
+                        for (const auto& value : word.data.constants)
+                        {
+                            constants.push_back(value_constant(word.name, value));
+                        }
+
+                        llvm::Constant* function = word.function_name.empty()
+                                                   ? null_ptr
+                                                   : module->getFunction(word.function_name);
+
+                        auto is_hidden = word.word.visibility == WordVisibility::hidden;
+
+                        return llvm::ConstantStruct::get(word_type,
+                                                         {
+                                                             string_constant(word.name),
+                                                             function,
+                                                             array_constant(location_type,
+                                                                            locations),
+                                                             int_constant(locations.size()),
+                                                             array_constant(value_type,
+                                                                            constants),
+                                                             int_constant(constants.size()),
+                                                             string_constant(word.word.description),
+                                                             string_constant(word.word.signature),
+                                                             location_constant(word.word.location),
+                                                             int_constant(is_hidden)
+                                                         });
+                    };
+
+                std::vector<llvm::Constant*> handler_names;
+
+                for (size_t index = 0; index < first_handler; ++index)
+                {
+                    handler_names.push_back(
+                                       string_constant(interpreter->get_handler_info(index).name));
+                }
+
+                std::vector<llvm::Constant*> word_items;
+
+                for (const auto& word : words)
+                {
+                    word_items.push_back(word_constant(word));
+                }
+
+                auto std_lib_path = interpreter->find_file("std.f").parent_path();
+
+                auto script = llvm::ConstantStruct::get(script_type,
+                                                        {
+                                                            string_constant(std_lib_path.string()),
+                                                            array_constant(ptr_type, handler_names),
+                                                            int_constant(first_handler),
+                                                            array_constant(word_type, word_items),
+                                                            int_constant(word_items.size()),
+                                                            word_constant(body)
+                                                        });
+
+                auto script_global = new llvm::GlobalVariable(*module,
+                                                              script_type,
+                                                              true,
+                                                              llvm::GlobalValue::PrivateLinkage,
+                                                              script,
+                                                              "sorth_aot_script");
+
+                // Finally the program's main function, which hands the script off to the sorth
+                // library.
+                auto entry_type = llvm::FunctionType::get(int32_type,
+                                                          { int32_type, ptr_type, ptr_type },
+                                                          false);
+                auto entry_function = llvm::Function::Create(entry_type,
+                                                             llvm::Function::ExternalLinkage,
+                                                             "sorth_aot_main",
+                                                             module.get());
+
+                auto main_type = llvm::FunctionType::get(int32_type,
+                                                         { int32_type, ptr_type },
+                                                         false);
+                auto main_function = llvm::Function::Create(main_type,
+                                                            llvm::Function::ExternalLinkage,
+                                                            "main",
+                                                            module.get());
+
+                llvm::IRBuilder<> builder(llvm_context);
+
+                builder.SetInsertPoint(llvm::BasicBlock::Create(llvm_context,
+                                                                "entry_block",
+                                                                main_function));
+
+                auto exit_code = builder.CreateCall(entry_function,
+                                                    {
+                                                        main_function->getArg(0),
+                                                        main_function->getArg(1),
+                                                        script_global
+                                                    });
+                builder.CreateRet(exit_code);
+
+                // Optimize the module and write out the object file.
+                optimize_module(*module,
+                                compile_settings.opt_level,
+                                compile_settings.passes,
+                                false);
+
+                std::error_code error_code;
+                llvm::raw_fd_ostream stream(object_path.string(),
+                                            error_code,
+                                            llvm::sys::fs::OF_None);
+
+                if (error_code)
+                {
+                    throw_error(interpreter,
+                                "Could not open " + object_path.string() + " for writing, " +
+                                error_code.message() + ".");
+                }
+
+                llvm::legacy::PassManager pass_manager;
+
+                if (machine->addPassesToEmitFile(pass_manager,
+                                                 stream,
+                                                 nullptr,
+                                                 llvm::CodeGenFileType::ObjectFile))
+                {
+                    throw_error(interpreter, "The target machine can not write object files.");
+                }
+
+                pass_manager.run(*module);
+                stream.flush();
+            }
+
+
+            std::string disassemble(uint64_t address, size_t size)
+            {
+                // Gether up the information needed for the disassembly engine to know how to work
+                // for our runtime-target.
+
+                // Start off by getting the target triple from the JIT engine.
+                auto triple = jit->getTargetTriple();
+                std::string triple_name = triple.str();
+
+                // Make sure we can get the target information for the JIT engine.
+                std::string error;
+
+                auto target = llvm::TargetRegistry::lookupTarget(triple_name, error);
+                if (!target)
+                {
+                    throw_error("Error finding target: " + error);
+                }
+
+                // Get the register information for this target.
+                std::unique_ptr<const llvm::MCRegisterInfo>
+                                                     reg_info(target->createMCRegInfo(triple_name));
+                if (!reg_info)
+                {
+                    throw_error("Error creating MCRegisterInfo.");
+                }
+
+                // Get the target options for this target.
+                llvm::MCTargetOptions options;
+                std::unique_ptr<const llvm::MCAsmInfo> asm_info(target->createMCAsmInfo(*reg_info,
+                                                                                        triple_name,
+                                                                                        options));
+                if (!asm_info)
+                {
+                    throw_error("Error creating MCAsmInfo for target" + triple_name + ".");
+                }
+
+                // Get the sub-target information for this target.
+                std::unique_ptr<const llvm::MCSubtargetInfo> sti(
+                                         target->createMCSubtargetInfo(triple_name, "generic", ""));
+                if (!sti)
+                {
+                    throw_error("Error creating MCSubtargetInfo for target" + triple_name + ".");
+                }
+
+                // Create the MC context for this target.
+                llvm::MCContext mc_context(triple, asm_info.get(), reg_info.get(), sti.get());
+                std::unique_ptr<llvm::MCDisassembler> disassembler(
+                                                    target->createMCDisassembler(*sti, mc_context));
+                if (!disassembler)
+                {
+                    throw_error("Error creating MCDisassembler for target" + triple_name + ".");
+                }
+
+                // Get the instruction information for this target.
+                std::unique_ptr<const llvm::MCInstrInfo> instr_info(target->createMCInstrInfo());
+
+                // Create an instruction printer for this target.
+                std::unique_ptr<llvm::MCInstPrinter> inst_printer(
+                                                            target->createMCInstPrinter(triple,
+                                                                                        0,
+                                                                                        *asm_info,
+                                                                                        *instr_info,
+                                                                                        *reg_info));
+
+                // Create a temporay non-owning array reference for the code.
+                llvm::ArrayRef<uint8_t> code((uint8_t*)address, size);
+                uint64_t index = address;
+
+                // Create a buffer and a llvm string stream to hold the disassembly.
+                std::string disassembly;
+                llvm::raw_string_ostream stream(disassembly);
+
+                // Go through the array of code and disassemble each instruction in it, advancing
+                // the index by the size of the found instruction.
+                while (index < address + size)
+                {
+                    // The next instruction and it's size.
+                    llvm::MCInst inst;
+                    uint64_t inst_size;
+
+                    // Try to disassemble the next instruction.
+                    if (disassembler->getInstruction(inst,
+                                                     inst_size,
+                                                     code.slice(index - address),
+                                                     index,
+                                                     llvm::nulls()))
+                    {
+                        // We found a valid instruction, so print it out.
+                        stream << llvm::format("0x%016llx: ", index);
+                        inst_printer->printInst(&inst, index, "", *sti, stream);
+                        stream << "\n";
+
+                        // Advance the index by the size of the instruction, with the size retrieved
+                        // from the getInstruction call.
+                        index += inst_size;
+                    }
+                    else
+                    {
+                        // If we couldn't disassemble the instruction, then just print out the
+                        // address and that we couldn't disassemble it.  Then try to realign the
+                        // index by one byte to try to find valid instructions again.
+                        stream << llvm::format("0x%016llx:", index) << " <unknown>\n";
+                        ++index;
+                    }
+                }
+
+                // All done.
+                return disassembly;
+            }
+
+
+            // Create the LLVM module and context for JITing code, along with the module's helper
+            // function declarations.
+            std::tuple<std::unique_ptr<llvm::Module>,
+                       std::unique_ptr<llvm::LLVMContext>,
+                       JitHelpers>
+                            create_jit_module_context(const std::string& name)
+            {
+                // Create the llvm module that will hold the JITed code.  Then register our helper
+                // functions with it.
+                auto context = std::make_unique<llvm::LLVMContext>();
+                auto module = std::make_unique<llvm::Module>("sorth_module_" + name,
+                                                             *context.get());
+                auto helpers = register_jit_helpers(module, context);
+
+                return { std::move(module), std::move(context), helpers };
+            }
+
+
+            // Verify and optimize the module at the given level.  If not empty, the given pass
+            // pipeline replaces the default one for the level.  The optimized IR of the functions
+            // is only returned if we're capturing code for debugging.  This can be called from
+            // several threads at once.
+            std::unordered_map<std::string,
+                               std::string>
+                optimize_module(llvm::Module& module,
+                                int64_t opt_level,
+                                const std::string& passes,
+                                bool capture_code)
+            {
+                // Capture the optimized IR for all the module's functions.
+                std::unordered_map<std::string, std::string> ir_map;
+
+                // Uncomment to print out the LLVM IR for the JITed function module but before being
+                // optimized.
+                // module.print(llvm::outs(), nullptr);
+
+                // Make sure that the generated module is viable.
+                std::string error_str;
+                llvm::raw_string_ostream error_stream(error_str);
+
+                if (llvm::verifyModule(module, &error_stream))
+                {
+                    error_stream.flush();
+                    throw_error("Module verification failed: " + error_str);
+                }
+
+                // Create the pass manager that will run the optimization passes on the module.
+                llvm::PassBuilder pass_builder;
+                llvm::LoopAnalysisManager loop_am;
+                llvm::FunctionAnalysisManager function_am;
+                llvm::CGSCCAnalysisManager cgsccam;
+                llvm::ModuleAnalysisManager module_am;
+
+                pass_builder.registerModuleAnalyses(module_am);
+                pass_builder.registerCGSCCAnalyses(cgsccam);
+                pass_builder.registerFunctionAnalyses(function_am);
+                pass_builder.registerLoopAnalyses(loop_am);
+                pass_builder.crossRegisterProxies(loop_am, function_am, cgsccam, module_am);
+
+                llvm::ModulePassManager mpm;
+
+                if (!passes.empty())
+                {
+                    auto error = pass_builder.parsePassPipeline(mpm, passes);
+
+                    if (error)
+                    {
+                        std::string error_message;
+
+                        llvm::raw_string_ostream stream(error_message);
+                        llvm::logAllUnhandledErrors(std::move(error),
+                                                    stream,
+                                                    "Invalid JIT pass pipeline: ");
+                        stream.flush();
+
+                        throw_error(error_message);
+                    }
+                }
+                else if (opt_level == 0)
+                {
+                    mpm = pass_builder.buildO0DefaultPipeline(llvm::OptimizationLevel::O0);
+                }
+                else
+                {
+                    mpm = pass_builder.buildPerModuleDefaultPipeline(
+                                                                to_optimization_level(opt_level));
+                }
+
+                // Now, run the optimization passes on the module.
+                auto start_time = std::chrono::steady_clock::now();
+
+                mpm.run(module, module_am);
+
+                auto optimization_time = std::chrono::steady_clock::now() - start_time;
+
+                {
+                    std::lock_guard<std::mutex> lock(jit_lock);
+
+                    stats.optimization_time += optimization_time;
+                    ++stats.modules;
+                }
+
+                // Uncomment to print out the LLVM IR for the JITed function module after being
+                // optimized.
+                // module.print(llvm::outs(), nullptr);
+
+                // Capture Optimized IR for Each Function...
+                for (auto &function : module.functions())
+                {
+                    if (   (capture_code)
+                        && (!function.isDeclaration()))
+                    {
+                        std::string func_ir;
+                        llvm::raw_string_ostream rso(func_ir);
+                        function.print(rso);
+                        rso.flush();
+
+                        ir_map[function.getName().str()] = func_ir;
+                    }
+                }
+
+                return ir_map;
+            }
+
+
+            // Optimize the module and then hand it off to the JIT engine under the given tracker.
+            std::unordered_map<std::string,
+                               std::string>
+                finalize_module(std::unique_ptr<llvm::Module>&& module,
+                                std::unique_ptr<llvm::LLVMContext>&& context,
+                                llvm::orc::ResourceTrackerSP tracker,
+                                int64_t opt_level,
+                                const std::string& passes,
+                                bool capture_code)
+            {
+                auto ir_map = optimize_module(*module, opt_level, passes, capture_code);
+
+                // Commit our module to the JIT engine and let it get compiled.
+                auto error = jit->addIRModule(tracker,
+                                              llvm::orc::ThreadSafeModule(std::move(module),
+                                                                          std::move(context)));
+
+                if (error)
+                {
+                    std::string error_message;
+
+                    llvm::raw_string_ostream stream(error_message);
+                    llvm::logAllUnhandledErrors(std::move(error),
+                                                stream,
+                                                "Failed to jit module: ");
+                    stream.flush();
+
+                    throw_error(error_message);
+                }
+
+                return ir_map;
+            }
+
+
+            // Wrap a generated function in a word handler that does the book keeping the generated
+            // code expects around the call.  The code is empty for functions that were compiled
+            // ahead of time, as they're part of the executable.
+            static WordFunction::Handler wrap_generated_function(AotFunction compiled_function,
+                                                                 JitWordDataPtr data,
+                                                                 JitCodePtr code,
+                                                                 CodeGenType type)
+            {
+                return [=](InterpreterPtr& interpreter) -> void
+                    {
+                        // The word can be replaced while it's running, freeing this handler.  So
+                        // hold our own references to the code and everything else we need
+                        // afterwards.
+                        auto running_code = code;
+                        auto running_data = data;
+                        auto is_word = type == CodeGenType::word;
+
+                        // The interpreter pointer is passed in as the first argument.  Convert it
+                        // to a void pointer for the JITed code.  We do the same for the locations
+                        // and constants vectors.
+                        void* interpreter_ptr = static_cast<void*>(&interpreter);
+                        const void* locations_ptr = static_cast<const void*>(&data->locations);
+                        const void* constants_ptr = static_cast<const void*>(&data->constants);
+
+                        // Clear any previous exception that may have occurred.
+                        clear_last_exception();
+
+                        // Mark our word's context for it's local variables.  But only if we're
+                        // compiling a word, not a script.
+                        if (is_word)
+                        {
+                            interpreter->mark_context();
+                        }
+
+                        // Call the JITed function.
+                        compiled_function(interpreter_ptr, locations_ptr, constants_ptr);
+
+                        // Release the context, freeing up any local variables.
+                        if (is_word)
+                        {
+                            interpreter->release_context();
+                        }
+
+                        // If an exception occurred in the JITed code, re-throw it.
+                        if (last_exception)
+                        {
+                            throw *last_exception;
+                        }
+                    };
+            }
+
+
+            // Create a function handler for the JITed code.  The handler keeps the code it runs
+            // alive.
+            WordFunction create_word_function(const std::string& name,
+                                              const std::string& display_name,
+                                              std::string&& function_ir,
+                                              JitWordDataPtr data,
+                                              JitCodePtr code,
+                                              CodeGenType type,
+                                              bool capture_code)
+            {
+                // Get our generated function from the jit engine.  The first lookup into a module
+                // is what triggers llvm to generate it's machine code.
+                auto start_time = std::chrono::steady_clock::now();
+
+                auto symbol = jit->lookup(name);
+                auto code_gen_time = std::chrono::steady_clock::now() - start_time;
+
+                {
+                    std::lock_guard<std::mutex> lock(jit_lock);
+                    stats.code_generation_time += code_gen_time;
+                }
+
+                if (!symbol)
+                {
+                    throw_error("Failed to find JITed function symbol " + name + ".");
+                }
+
+                auto compiled_function = symbol->toPtr<void (*)(void*, // interpreter
+                                                                const void*, // locations
+                                                                const void*)>(); // constants
+
+                // Create a new handler object for our generated word.
+                WordFunction handler = wrap_generated_function(compiled_function, data, code, type);
+
+                // Set the IR for the function, if it was captured.
+                if (!function_ir.empty())
+                {
+                    handler.set_ir(function_ir);
+                }
+
+                // Set the generated disassembly for the function.  If we're capturing code and we
+                // were able to properly get it's address and size.
+                auto [ address, size ] = TrackingMemoryManager::take_function_size(name);
+
+                if ((is_perf_enabled) && (address) && (size > 0))
+                {
+                    perf_map.add(address, size, display_name);
+                }
+
+                if ((capture_code) && (address) && (size > 0))
+                {
+                    // We have a proper address and size, so disassemble the function.
+                    handler.set_asm_code(disassemble(address, size));
+                }
+
+                // Return the new function handler.
+                return handler;
+            }
+
+
+            // Get the function that will hold a word's JITed code, creating it if it hasn't been
+            // declared yet.
+            llvm::Function* declare_word_function(std::unique_ptr<llvm::Module>& module,
+                                                  std::unique_ptr<llvm::LLVMContext>& context,
+                                                  const std::string& name)
+            {
+                if (auto function = module->getFunction(name))
+                {
+                    return function;
+                }
+
+                // Gather up our basic types, and then create the function type for the JITed code.
+                auto void_type = llvm::Type::getVoidTy(*context.get());
+                auto ptr_type = llvm::PointerType::getUnqual(void_type);
+
+                auto function_type = llvm::FunctionType::get(void_type,
+                                                             { ptr_type, ptr_type, ptr_type },
+                                                             false);
+
+                auto function = llvm::Function::Create(function_type,
+                                                       llvm::Function::ExternalLinkage,
+                                                       name,
+                                                       module.get());
+
+                // Like the helpers, JITed code reports errors through the interpreter instead of
+                // unwinding.
+                function->addFnAttr(llvm::Attribute::NoUnwind);
+
+                return function;
+            }
+
+
+            // JIT compile the given byte-code block into a native function handler.  The source
+            // locations and complex constants that the code needs at run-time are stored in data.
+            void jit_compile(InterpreterPtr& interpreter,
+                             std::unique_ptr<llvm::Module>& module,
+                             std::unique_ptr<llvm::LLVMContext>& context,
+                             const JitHelpers& helpers,
+                             const JitSettings& current_settings,
+                             const std::string& name,
+                             const ByteCode& code,
+                             CodeGenType type,
+                             JitWordData& data,
+                             const DirectCallMap& direct_calls,
+                             const std::set<std::string>& dynamic_names)
+            {
+                // Get the function that will hold the JITed code.
+                auto function = declare_word_function(module, context, name);
+
+                // Work out which of a word's locals can be kept out of the interpreter.  A script's
+                // top level variables are always visible to other code.
+                PromotedLocals promoted_locals;
+
+                if (   (type == CodeGenType::word)
+                    && (current_settings.promote_locals))
+                {
+                    promoted_locals = find_promotable_locals(interpreter, code, dynamic_names);
+                }
+
+                // Generate the body of the JITed function.  If a promoted local turns out to be
+                // used in a way that doesn't fit how it was stored, we adjust and try again.
+                auto start_time = std::chrono::steady_clock::now();
+
+                while (true)
+                {
+                    llvm::IRBuilder<> builder(*context.get());
+
+                    try
+                    {
+                        generate_function_body(interpreter,
+                                               module,
+                                               builder,
+                                               function,
+                                               context,
+                                               helpers,
+                                               name,
+                                               data.locations,
+                                               data.constants,
+                                               direct_calls,
+                                               promoted_locals,
+                                               code);
+                        break;
+                    }
+                    catch (const LocalPromotionConflict& conflict)
+                    {
+                        if (conflict.can_box)
+                        {
+                            promoted_locals[conflict.name].must_box = true;
+                        }
+                        else
+                        {
+                            promoted_locals.erase(conflict.name);
+                        }
+
+                        function->deleteBody();
+                        data.locations.clear();
+                        data.constants.clear();
+                    }
+                }
+
+                auto ir_time = std::chrono::steady_clock::now() - start_time;
+
+                std::lock_guard<std::mutex> lock(jit_lock);
+
+                stats.ir_generation_time += ir_time;
+                ++stats.functions;
+            }
+
+
+            // Generate the body of the JITed function.  We do this by walking the byte-code block
+            // and generating the appropriate llvm instructions for each operation.
+            void generate_function_body(InterpreterPtr& interpreter,
+                                        std::unique_ptr<llvm::Module>& module,
+                                        llvm::IRBuilder<>& builder,
+                                        llvm::Function* function,
+                                        std::unique_ptr<llvm::LLVMContext>& context,
+                                        const JitHelpers& helpers,
+                                        const std::string& name,
+                                        std::vector<Location>& locations,
+                                        std::vector<Value>& constants,
+                                        const DirectCallMap& direct_calls,
+                                        PromotedLocals& promoted_locals,
+                                        const ByteCode& code)
+            {
+                // Gather some types we'll need.
+                auto bool_type = llvm::Type::getInt1Ty(*context.get());
+                auto int64_type = llvm::Type::getInt64Ty(*context.get());
+                auto double_type = llvm::Type::getDoubleTy(*context.get());
+                auto char_type = llvm::Type::getInt1Ty(*context.get());
+                auto int8_type = llvm::Type::getInt8Ty(*context.get());
+
+
+                // Keep track of the basic blocks we create for the jump targets.
+                auto blocks = std::unordered_map<size_t, llvm::BasicBlock*>();
+                auto auto_jump_blocks = std::unordered_map<size_t, std::pair<llvm::BasicBlock*,
+                                                                             llvm::BasicBlock*>>();
+
+                // Create the entry block of the function.
+                auto entry_block = llvm::BasicBlock::Create(*context, "entry_block", function);
+                builder.SetInsertPoint(entry_block);
+
+                // Get a reference to the interpreter pointer argument.
+                auto interpreter_ptr = function->getArg(0);
+                auto location_arr_ptr = function->getArg(1);
+                auto constant_arr_ptr = function->getArg(2);
+
+                // Keep track of any loop and catch block markers.
+                std::vector<std::pair<size_t, size_t>> loop_markers;
+                std::vector<size_t> catch_markers;
+
+                // Keep track of any jump targets that are the target of a catch block.
+                std::set<size_t> catch_target_markers;
+
+                // The values currently being held in registers instead of on the interpreter's
+                // stack.
+                StackCache stack_cache;
+
+                // The most recent source location that the interpreter hasn't been told about yet.
+                // Locations are only needed for error reporting, so we only update the interpreter
+                // right before doing something that can fail.
+                std::optional<size_t> pending_location;
+
+                auto emit_location = [&]()
+                    {
+                        if (pending_location)
+                        {
+                            auto index_const = llvm::ConstantInt::get(int64_type,
+                                                                      pending_location.value());
+                            builder.CreateCall(helpers.handle_set_location_fn,
+                                               { interpreter_ptr, location_arr_ptr, index_const });
+                            pending_location.reset();
+                        }
+                    };
+
+                // Before calling anything that can see the interpreter's stack or raise an error
+                // get the interpreter's state up to date.
+                auto sync_interpreter = [&]()
+                    {
+                        spill_stack_cache(builder, helpers, interpreter_ptr, stack_cache);
+                        emit_location();
+                    };
+
+                // Jumping backwards means going around a loop again.  The byte-code interpreter
+                // counts every instruction against a coroutine's budget, we count the whole loop
+                // body at once so that busy loops can still be preempted.
+                auto spend_budget = [&](size_t from, size_t to)
+                    {
+                        if (to <= from)
+                        {
+                            auto count_const = llvm::ConstantInt::get(int64_type, from - to + 1);
+                            builder.CreateCall(helpers.handle_spend_budget_fn,
+                                               { interpreter_ptr, count_const });
+                        }
+                    };
+
+                // Take a first pass through the code to create the blocks that we'll need.
+                auto block_index = 1;
+
+                for (size_t i = 0; i < code.size(); ++i)
+                {
+                    if (   (code[i].id == Instruction::Id::execute)
+                        || (code[i].id == Instruction::Id::jump_target)
+                        || (code[i].id == Instruction::Id::def_variable)
+                        || (code[i].id == Instruction::Id::def_constant)
+                        || (code[i].id == Instruction::Id::read_variable)
+                        || (code[i].id == Instruction::Id::write_variable)
+                        || (code[i].id == Instruction::Id::jump_loop_start)
+                        || (code[i].id == Instruction::Id::jump_loop_exit))
+                    {
+                        // These instructions are the ones that can start a new block.  In the case
+                        // of a jump target it is an explicit start of a block.  The jump
+                        // instruction is also the implicit end of a block.  For  the other
+                        // instructions it is an implicit start of a block.  Usually for exception
+                        // checking these instructions can call a function that can potentially
+                        // raise an exception.  So we create a new block for each of these
+                        // instructions.
+                        std::stringstream stream;
+
+                        stream << "block_" << block_index;
+                        ++block_index;
+
+                        blocks[i] = llvm::BasicBlock::Create(*context, stream.str(), function);
+                    }
+                    else if (   (code[i].id == Instruction::Id::jump_if_zero)
+                             || (code[i].id == Instruction::Id::jump_if_not_zero))
+                    {
+                        // These instructions have two jumps.  One jump for the pop error check and
+                        // one for the actual jump.  So we create two blocks for each of these jump
+                        // instructions.
+                        std::stringstream stream;
+
+                        stream << "block_" << block_index;
+                        ++block_index;
+
+                        auto block_a = llvm::BasicBlock::Create(*context, stream.str(), function);
+
+                        std::stringstream stream_b;
+
+                        stream_b << "block_" << block_index;
+                        ++block_index;
+
+                        auto block_b = llvm::BasicBlock::Create(*context, stream_b.str(), function);
+
+                        auto_jump_blocks[i] = { block_a, block_b };
+                    }
+                }
+
+                // // Create the end block of the function.
+                auto exit_block = llvm::BasicBlock::Create(*context, "exit_block", function);
+
+                // Start with a clean slate for the promoted locals.
+                size_t frame_index = 0;
+
+                for (auto& [ local_name, local ] : promoted_locals)
+                {
+                    local.storage = LocalStorage::undecided;
+                    local.slot = nullptr;
+                    local.frame_index = frame_index;
+
+                    ++frame_index;
+                }
+
+                // The frame of boxed values for the promoted locals that need one.  It's only
+                // created if it's used.
+                llvm::AllocaInst* local_frame = nullptr;
+
+                auto get_local_frame = [&]() -> llvm::Value*
+                    {
+                        if (local_frame == nullptr)
+                        {
+                            auto frame_size = promoted_locals.size() * sizeof(Value);
+                            auto frame_type = llvm::ArrayType::get(int8_type, frame_size);
+
+                            local_frame = create_entry_alloca(function, frame_type);
+                            local_frame->setAlignment(llvm::Align(alignof(Value)));
+
+                            // Construct the values as soon as the frame is allocated, they're
+                            // destroyed in the exit block.
+                            llvm::IRBuilder<> frame_builder(entry_block,
+                                                            std::next(local_frame->getIterator()));
+
+                            frame_builder.CreateCall(helpers.handle_init_locals_fn,
+                                                     {
+                                                         local_frame,
+                                                         builder.getInt64(promoted_locals.size())
+                                                     });
+                        }
+
+                        return local_frame;
+                    };
+
+                // Get the promoted local accessed by the instruction at the given index, if any.
+                auto promoted_local_at = [&](size_t index) -> PromotedLocal*
+                    {
+                        if (   (code[index].id != Instruction::Id::execute)
+                            || (!code[index].value.is_string()))
+                        {
+                            return nullptr;
+                        }
+
+                        auto found = promoted_locals.find(code[index].value.as_string(interpreter));
+
+                        return found != promoted_locals.end() ? &found->second : nullptr;
+                    };
+
+                // Get the promoted variable, not constant, accessed by the instruction before the
+                // given index, if any.
+                auto promoted_variable_before = [&](size_t index) -> PromotedLocal*
+                    {
+                        auto local = index > 0 ? promoted_local_at(index - 1) : nullptr;
+
+                        return (local != nullptr) && (!local->is_constant) ? local : nullptr;
+                    };
+
+                auto local_type = [&](CachedType type) -> llvm::Type*
+                    {
+                        switch (type)
+                        {
+                            case CachedType::integer:  return int64_type;
+                            case CachedType::floating: return double_type;
+                            case CachedType::boolean:  break;
+                        }
+
+                        return bool_type;
+                    };
+
+                // Push the value of a promoted local.
+                auto push_local = [&](PromotedLocal& local)
+                    {
+                        if (local.storage == LocalStorage::typed)
+                        {
+                            auto value = builder.CreateLoad(local_type(local.type), local.slot);
+                            stack_cache.push_back({ local.type, value });
+                        }
+                        else if (local.storage == LocalStorage::boxed)
+                        {
+                            spill_stack_cache(builder, helpers, interpreter_ptr, stack_cache);
+                            builder.CreateCall(helpers.handle_read_local_fn,
+                                               {
+                                                   interpreter_ptr,
+                                                   get_local_frame(),
+                                                   builder.getInt64(local.frame_index),
+                                                   builder.getInt1(local.is_constant)
+                                               });
+                        }
+                        else
+                        {
+                            throw_error("Promoted local variable used before it was defined.");
+                        }
+                    };
+
+                // Pop the top of the stack into a promoted local.  If the local's storage hasn't
+                // been decided yet, the type of the value decides it.  Generates the branch to
+                // next_block.
+                auto pop_local = [&](const std::string& local_name,
+                                     PromotedLocal& local,
+                                     llvm::BasicBlock* next_block)
+                    {
+                        if (local.storage == LocalStorage::undecided)
+                        {
+                            if ((!stack_cache.empty()) && (!local.must_box))
+                            {
+                                local.storage = LocalStorage::typed;
+                                local.type = stack_cache.back().type;
+                                local.slot = create_entry_alloca(function, local_type(local.type));
+                            }
+                            else if (local.is_incremented)
+                            {
+                                throw LocalPromotionConflict { local_name, false };
+                            }
+                            else
+                            {
+                                local.storage = LocalStorage::boxed;
+                            }
+                        }
+
+                        if (local.storage == LocalStorage::typed)
+                        {
+                            if (   (stack_cache.empty())
+                                || (stack_cache.back().type != local.type))
+                            {
+                                throw LocalPromotionConflict { local_name, !local.is_incremented };
+                            }
+
+                            builder.CreateStore(stack_cache.back().value, local.slot);
+                            stack_cache.pop_back();
+
+                            builder.CreateBr(next_block);
+                        }
+                        else
+                        {
+                            auto error_block = catch_markers.empty()
+                                               ? exit_block
+                                               : blocks[catch_markers.back()];
+
+                            sync_interpreter();
+
+                            auto result = builder.CreateCall(helpers.handle_write_local_fn,
+                                                             {
+                                                                 interpreter_ptr,
+                                                                 get_local_frame(),
+                                                                 builder.getInt64(local.frame_index)
+                                                             });
+
+                            auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                            builder.CreateCondBr(cmp,
+                                                 error_block,
+                                                 next_block,
+                                                 unlikely_error(builder));
+                        }
+                    };
+
+                // On second pass generate the actual code.
+                for (size_t i = 0; i < code.size(); ++i)
+                {
+                    // Check to see if the current instruction has a location associated with it.
+                    if (code[i].location)
+                    {
+                        // Save the location in our locations vector.  The code to update the
+                        // interpreter's location is generated when it's needed.
+                        auto& location = code[i].location.value();
+
+                        pending_location = locations.size();
+                        locations.push_back(location);
+                    }
+
+                    switch (code[i].id)
+                    {
+                        case Instruction::Id::def_variable:
+                            {
+                                // Get the variable name and create a string constant in the module
+                                // for it.
+                                auto name = code[i].value.as_string(interpreter);
+
+                                // Promoted variables don't exist in the interpreter at all.
+                                auto promoted = promoted_locals.find(name);
+
+                                if (promoted != promoted_locals.end())
+                                {
+                                    auto& local = promoted->second;
+
+                                    if ((local.is_initialized) && (!local.must_box))
+                                    {
+                                        // The value that follows decides how it's stored.
+                                        local.storage = LocalStorage::undecided;
+                                    }
+                                    else
+                                    {
+                                        // A new variable always starts out empty.
+                                        local.storage = LocalStorage::boxed;
+
+                                        builder.CreateCall(helpers.handle_reset_local_fn,
+                                                           {
+                                                               get_local_frame(),
+                                                               builder.getInt64(local.frame_index)
+                                                           });
+                                    }
+
+                                    builder.CreateBr(blocks[i]);
+                                    builder.SetInsertPoint(blocks[i]);
+                                    break;
+                                }
+
+                                auto name_ptr = define_string_constant(name,
+                                                                       builder,
+                                                                       module,
+                                                                       context);
+
+                                // Call the handle_define_variable function to define the variable
+                                // in the interpreter.
+                                sync_interpreter();
+
+                                auto result = builder.CreateCall(helpers.handle_define_variable_fn,
+                                                                 { interpreter_ptr, name_ptr });
+
+                                // Check the result of the call instruction and branch to the next
+                                // block if no errors were raised, otherwise branch to the either
+                                // the exit block or the exception handler block.
+                                auto error_block = catch_markers.empty()
+                                                   ? exit_block
+                                                   : blocks[catch_markers.back()];
+
+                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp,
+                                                     error_block,
+                                                     blocks[i],
+                                                     unlikely_error(builder));
+                                builder.SetInsertPoint(blocks[i]);
+                            }
+                            break;
+
+                        case Instruction::Id::def_constant:
+                            {
+                                // Get the constant name and create a string constant in the module
+                                // for it.
+                                auto name = code[i].value.as_string(interpreter);
+
+                                // Promoted constants just hold on to the value.
+                                auto promoted = promoted_locals.find(name);
+
+                                if (promoted != promoted_locals.end())
+                                {
+                                    promoted->second.storage = LocalStorage::undecided;
+
+                                    pop_local(name, promoted->second, blocks[i]);
+                                    builder.SetInsertPoint(blocks[i]);
+                                    break;
+                                }
+
+                                auto name_ptr = define_string_constant(name,
+                                                                       builder,
+                                                                       module,
+                                                                       context);
+
+                                // Call the handle_define_constant function to define the constant
+                                // in the interpreter.
+                                sync_interpreter();
+
+                                auto result = builder.CreateCall(helpers.handle_define_constant_fn,
+                                                                 { interpreter_ptr, name_ptr });
+
+                                // Check the result of the call instruction and branch to the next
+                                // block if no errors were raised, otherwise branch to the either
+                                // the exit block or the exception handler block.
+                                auto error_block = catch_markers.empty()
+                                                   ? exit_block
+                                                   : blocks[catch_markers.back()];
+
+                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp,
+                                                     error_block,
+                                                     blocks[i],
+                                                     unlikely_error(builder));
+                                builder.SetInsertPoint(blocks[i]);
+                            }
+                            break;
+
+                        case Instruction::Id::read_variable:
+                            {
+                                // Reading a promoted variable.
+                                if (auto local = promoted_variable_before(i))
+                                {
+                                    push_local(*local);
+
+                                    builder.CreateBr(blocks[i]);
+                                    builder.SetInsertPoint(blocks[i]);
+                                    break;
+                                }
+
+                                // Call the handle_read_variable function to read the variable from
+                                // the interpreter.
+                                sync_interpreter();
+
+                                auto result = builder.CreateCall(helpers.handle_read_variable_fn,
+                                                                 { interpreter_ptr });
+
+                                // Check the result of the call instruction and branch to the next
+                                // block if no errors were raised, otherwise branch to the either
+                                // the exit block or the exception handler block.
+                                auto error_block = catch_markers.empty()
+                                                   ? exit_block
+                                                   : blocks[catch_markers.back()];
+
+                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp,
+                                                     error_block,
+                                                     blocks[i],
+                                                     unlikely_error(builder));
+                                builder.SetInsertPoint(blocks[i]);
+                            }
+                            break;
+
+                        case Instruction::Id::write_variable:
+                            {
+                                // Writing a promoted variable.
+                                if (auto local = promoted_variable_before(i))
+                                {
+                                    pop_local(code[i - 1].value.as_string(interpreter),
+                                              *local,
+                                              blocks[i]);
+                                    builder.SetInsertPoint(blocks[i]);
+                                    break;
+                                }
+
+                                // Call the handle_write_variable function to write the variable to
+                                // the interpreter.
+                                sync_interpreter();
+
+                                auto result = builder.CreateCall(helpers.handle_write_variable_fn,
+                                                                 { interpreter_ptr });
+
+                                // Check the result of the call instruction and branch to the next
+                                // block if no errors were raised, otherwise branch to the either
+                                // the exit block or the exception handler block.
+                                auto error_block = catch_markers.empty()
+                                                   ? exit_block
+                                                   : blocks[catch_markers.back()];
+
+                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp,
+                                                     error_block,
+                                                     blocks[i],
+                                                     unlikely_error(builder));
+                                builder.SetInsertPoint(blocks[i]);
+                            }
+                            break;
+
+                        case Instruction::Id::execute:
+                            {
+                                // Get the name or index of the word to execute.
+                                auto& value = code[i].value;
+
+                                // Jump to the catch block if there is one, or the exit block if
+                                // not.
+                                auto error_block = catch_markers.empty()
+                                                   ? exit_block
+                                                   : blocks[catch_markers.back()];
+
+                                // Capture the result of teh execute call instruction.
+                                llvm::Value* result = nullptr;
+
+                                // Executing a promoted constant pushes it's value, for a variable
+                                // the following instruction does the actual work.
+                                if (auto local = promoted_local_at(i))
+                                {
+                                    if (local->is_constant)
+                                    {
+                                        push_local(*local);
+                                    }
+
+                                    builder.CreateBr(blocks[i]);
+                                    builder.SetInsertPoint(blocks[i]);
+                                    break;
+                                }
+
+                                if (value.is_string())
+                                {
+                                    // The value is a string, so execute the word based on it's
+                                    // name.
+                                    auto name = value.as_string(interpreter);
+                                    auto name_ptr = define_string_constant(name,
+                                                                           builder,
+                                                                           module,
+                                                                           context);
+
+                                    sync_interpreter();
+
+                                    result = builder.CreateCall(helpers.handle_word_execute_name_fn,
+                                                                { interpreter_ptr, name_ptr });
+                                }
+                                else if (value.is_numeric())
+                                {
+                                    // The value is a number, so execute the word based on it's
+                                    // handler index.
+                                    auto index = value.as_integer(interpreter);
+
+                                    // If the word is one of our intrinsic operations generate it's
+                                    // code inline instead of calling the word.
+                                    auto intrinsic = interpreter->get_handler_info(index)
+                                                                 .function
+                                                                 .get_intrinsic();
+
+                                    // Incrementing or decrementing a promoted variable, which will
+                                    // have been stored unboxed.
+                                    bool is_increment =
+                                                  intrinsic == WordIntrinsic::increment_variable;
+                                    bool is_decrement =
+                                                  intrinsic == WordIntrinsic::decrement_variable;
+
+                                    auto local = is_increment || is_decrement
+                                                 ? promoted_variable_before(i)
+                                                 : nullptr;
+
+                                    if (local != nullptr)
+                                    {
+                                        if (   (local->storage != LocalStorage::typed)
+                                            || (local->type == CachedType::boolean))
+                                        {
+                                            auto local_name = code[i - 1].value
+                                                                         .as_string(interpreter);
+
+                                            throw LocalPromotionConflict { local_name, false };
+                                        }
+
+                                        auto type = local_type(local->type);
+                                        auto old_value = builder.CreateLoad(type, local->slot);
+                                        llvm::Value* new_value = nullptr;
+
+                                        if (local->type == CachedType::integer)
+                                        {
+                                            auto one = builder.getInt64(1);
+
+                                            new_value = is_increment
+                                                        ? builder.CreateAdd(old_value, one)
+                                                        : builder.CreateSub(old_value, one);
+                                        }
+                                        else
+                                        {
+                                            auto one = llvm::ConstantFP::get(double_type, 1.0);
+
+                                            new_value = is_increment
+                                                        ? builder.CreateFAdd(old_value, one)
+                                                        : builder.CreateFSub(old_value, one);
+                                        }
+
+                                        builder.CreateStore(new_value, local->slot);
+
+                                        builder.CreateBr(blocks[i]);
+                                        builder.SetInsertPoint(blocks[i]);
+                                        break;
+                                    }
+
+                                    if (intrinsic != WordIntrinsic::none)
+                                    {
+                                        // Best case, the operands are already in registers and we
+                                        // can perform the operation without touching the
+                                        // interpreter at all.
+                                        if (generate_cached_intrinsic(builder,
+                                                                      context,
+                                                                      stack_cache,
+                                                                      intrinsic))
+                                        {
+                                            builder.CreateBr(blocks[i]);
+                                            builder.SetInsertPoint(blocks[i]);
+                                            break;
+                                        }
+
+                                        // Otherwise, the operands are on the interpreter's stack,
+                                        // so check their types at run-time.
+                                        if (is_numeric_intrinsic(intrinsic))
+                                        {
+                                            spill_stack_cache(builder,
+                                                              helpers,
+                                                              interpreter_ptr,
+                                                              stack_cache);
+
+                                            // The location is only sent on the slow path, so it's
+                                            // still pending for the fast paths.
+                                            auto location = pending_location;
+
+                                            generate_intrinsic(builder,
+                                                               context,
+                                                               helpers,
+                                                               function,
+                                                               interpreter_ptr,
+                                                               intrinsic,
+                                                               index,
+                                                               emit_location,
+                                                               blocks[i],
+                                                               error_block);
+
+                                            pending_location = location;
+                                            builder.SetInsertPoint(blocks[i]);
+                                            break;
+                                        }
+                                    }
+
+                                    // Words that can't fail don't need their location or their
+                                    // result checked.
+                                    if (interpreter->get_handler_info(index)
+                                                    .function
+                                                    .is_no_throw())
+                                    {
+                                        spill_stack_cache(builder,
+                                                          helpers,
+                                                          interpreter_ptr,
+                                                          stack_cache);
+
+                                        builder.CreateCall(helpers.handle_word_execute_index_fn,
+                                                           {
+                                                               interpreter_ptr,
+                                                               builder.getInt64(index)
+                                                           });
+
+                                        builder.CreateBr(blocks[i]);
+                                        builder.SetInsertPoint(blocks[i]);
+                                        break;
+                                    }
+
+                                    sync_interpreter();
+
+                                    // Words from the same module are called directly, everything
+                                    // else goes through the interpreter.
+                                    auto direct_call = direct_calls.find(index);
+
+                                    if (direct_call != direct_calls.end())
+                                    {
+                                        result = generate_direct_call(builder,
+                                                                      context,
+                                                                      helpers,
+                                                                      function,
+                                                                      interpreter_ptr,
+                                                                      index,
+                                                                      direct_call->second,
+                                                                      blocks[i]);
+                                    }
+                                    else
+                                    {
+                                        auto int_const = llvm::ConstantInt::get(int64_type, index);
+                                        result = builder.CreateCall(
+                                                            helpers.handle_word_execute_index_fn,
+                                                            { interpreter_ptr, int_const });
+                                    }
+                                }
+                                else
+                                {
+                                    throw_error("Can not execute unexpected value type.");
+                                }
+
+                                // Check the result of the call instruction and branch to the next
+                                // if no errors were raised, otherwise branch to the either the
+                                // exit block or the exception handler block.
+                                auto next_block = blocks[i];
+
+                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp,
+                                                     error_block,
+                                                     next_block,
+                                                     unlikely_error(builder));
+
+                                // We're done with the current block, so move on to the next one.
+                                builder.SetInsertPoint(next_block);
+                            }
+                            break;
+
+                        case Instruction::Id::word_index:
+                            {
+                                // Make sure we have a name for lookup.
+                                if (!code[i].value.is_string())
+                                {
+                                    throw_error("Expected a numeric value for word_index.");
+                                }
+
+                                // See if we can find the word in the interpreter at compile time.
+                                // If we can, we'll generate the code to push it's index on the
+                                // stack, if we can't we'll generate code to try again at runtime.
+                                auto name = code[i].value.as_string(interpreter);
+                                auto [ found, word_info ] = interpreter->find_word(name);
+
+                                if (found)
+                                {
+                                    auto int_const = llvm::ConstantInt::get(int64_type,
+                                                                           word_info.handler_index);
+                                    stack_cache.push_back({ CachedType::integer, int_const });
+                                }
+                                else
+                                {
+                                    sync_interpreter();
+
+                                    auto name_constant = define_string_constant(name,
+                                                                                builder,
+                                                                                module,
+                                                                                context);
+                                    builder.CreateCall(helpers.handle_word_index_name_fn,
+                                                       { interpreter_ptr, name_constant });
+                                }
+                            }
+                            break;
+
+                        case Instruction::Id::word_exists:
+                            {
+                                // Make sure we have a name for lookup.
+                                if (!code[i].value.is_string())
+                                {
+                                    throw_error("Expected a numeric value for word_index.");
+                                }
+
+                                // See if we can find the word in the interpreter at compile time.
+                                // If we can, we'll generate the code to push a true value onto the
+                                // stack, if we can't we'll generate code to try again at runtime.
+                                auto name = code[i].value.as_string(interpreter);
+                                auto [ found, _ ] = interpreter->find_word(name);
+
+                                if (found)
+                                {
+                                    auto true_const = llvm::ConstantInt::get(bool_type, true);
+                                    stack_cache.push_back({ CachedType::boolean, true_const });
+                                }
+                                else
+                                {
+                                    auto name_ptr = define_string_constant(name,
+                                                                           builder,
+                                                                           module,
+                                                                           context);
+
+                                    sync_interpreter();
+
+                                    builder.CreateCall(helpers.handle_word_exists_name_fn,
+                                                       { interpreter_ptr, name_ptr });
+                                }
+                            }
+                            break;
+
+                        case Instruction::Id::push_constant_value:
+                            {
+                                // Get the value to push from the instruction.
+                                auto& value = code[i].value;
+
+                                // Check the type of the value.  If it's one of the simple types
+                                // we keep it in the stack cache as a constant.
+                                if (value.is_bool())
+                                {
+                                    auto bool_value = value.as_bool();
+                                    auto bool_const = llvm::ConstantInt::get(bool_type, bool_value);
+                                    stack_cache.push_back({ CachedType::boolean, bool_const });
+                                }
+                                else if (value.is_integer())
+                                {
+                                    auto int_value = value.as_integer(interpreter);
+                                    auto int_const = llvm::ConstantInt::get(int64_type, int_value);
+                                    stack_cache.push_back({ CachedType::integer, int_const });
+                                }
+                                else if (value.is_float())
+                                {
+                                    auto double_value = value.as_float(interpreter);
+                                    auto double_const = llvm::ConstantFP::get(double_type,
+                                                                              double_value);
+                                    stack_cache.push_back({ CachedType::floating, double_const });
+                                }
+                                else if (value.is_string())
+                                {
+                                    // Anything pushed onto the real stack has to go on top of the
+                                    // cached values.
+                                    spill_stack_cache(builder,
+                                                      helpers,
+                                                      interpreter_ptr,
+                                                      stack_cache);
+
+                                    auto string_value = value.as_string(interpreter);
+                                    auto string_ptr = define_string_constant(string_value,
+                                                                             builder,
+                                                                             module,
+                                                                             context);
+                                    builder.CreateCall(helpers.handle_push_string_fn,
+                                                       { interpreter_ptr, string_ptr });
+                                }
+                                else
+                                {
+                                    // The value is a complex type that we can't inline in the JITed
+                                    // code directly.  So we'll add it to the constants array and
+                                    // generate code to push the value from the array onto the
+                                    // stack.
+                                    spill_stack_cache(builder,
+                                                      helpers,
+                                                      interpreter_ptr,
+                                                      stack_cache);
+
+                                    auto index = constants.size();
+                                    constants.push_back(value);
+
+                                    auto index_const = builder.getInt64(index);
+                                    builder.CreateCall(helpers.handle_push_value_fn,
+                                                       { interpreter_ptr,
+                                                         constant_arr_ptr,
+                                                         index_const });
+                                }
+                            }
+                            break;
+
+                        case Instruction::Id::mark_loop_exit:
+                            {
+                                // Capture the start and end indexes of the loop for later use.
+                                auto start_index = i + 1;
+                                auto end_index = i + code[i].value.as_integer(interpreter);
+
+                                loop_markers.push_back({ start_index, end_index });
+                            }
+                            break;
 
-                // // Create the end block of the function.
-                auto exit_block = llvm::BasicBlock::Create(*context, "exit_block", function);
+                        case Instruction::Id::unmark_loop_exit:
+                            {
+                                // Clear the current loop markers.
+                                loop_markers.pop_back();
+                            }
+                            break;
 
-                // On second pass generate the actual code.
-                for (size_t i = 0; i < code.size(); ++i)
-                {
-                    // Check to see if the current instruction has a location associated with it.
-                    if (code[i].location)
-                    {
-                        // Save the location in our locations vector.
-                        auto& location = code[i].location.value();
-                        auto index = locations.size();
+                        case Instruction::Id::mark_catch:
+                            {
+                                // Capture the index of the catch block for later use.
+                                auto target_index = i + code[i].value.as_integer(interpreter);
+                                catch_markers.push_back(target_index);
+                                catch_target_markers.insert(target_index);
+                            }
+                            break;
 
-                        locations.push_back(location);
+                        case Instruction::Id::unmark_catch:
+                            {
+                                // Clear the current catch markers so that we don't jump to then.
+                                // Note that we leave the catch_target_markers set alone so that we
+                                // can generate the code to push the exception onto the stack when
+                                // we reach the catch target instruction.
+                                catch_markers.pop_back();
+                            }
+                            break;
 
-                        // Generate the code to update the location in the interpreter.
-                        auto index_const = llvm::ConstantInt::get(int64_type, index);
-                        builder.CreateCall(handle_set_location_fn,
-                                           { interpreter_ptr, location_arr_ptr, index_const});
-                    }
+                        case Instruction::Id::mark_context:
+                            {
+                                // Call the handle_manage_context function to mark the context in
+                                // the interpreter.
+                                auto bool_const = llvm::ConstantInt::get(bool_type, true);
+                                builder.CreateCall(helpers.handle_manage_context_fn,
+                                                   { interpreter_ptr, bool_const });
+                            }
+                            break;
 
-                    switch (code[i].id)
-                    {
-                        case Instruction::Id::def_variable:
+                        case Instruction::Id::release_context:
                             {
-                                // Get the variable name and create a string constant in the module
-                                // for it.
-                                auto name = code[i].value.as_string(interpreter);
-                                auto name_ptr = define_string_constant(name,
-                                                                       builder,
-                                                                       module,
-                                                                       context);
+                                // Call the handle_manage_context function to release the context in
+                                // the interpreter.
+                                auto bool_const = llvm::ConstantInt::get(bool_type, false);
+                                builder.CreateCall(helpers.handle_manage_context_fn,
+                                                   { interpreter_ptr, bool_const });
+                            }
+                            break;
 
-                                // Call the handle_define_variable function to define the variable
-                                // in the interpreter.
-                                auto result = builder.CreateCall(handle_define_variable_fn,
-                                                                 { interpreter_ptr, name_ptr });
+                        case Instruction::Id::jump:
+                            {
+                                // Jump to the target block.
+                                auto index = i + code[i].value.as_integer(interpreter);
+
+                                spend_budget(i, index);
+                                spill_stack_cache(builder, helpers, interpreter_ptr, stack_cache);
+                                builder.CreateBr(blocks[index]);
+                            }
+                            break;
+
+                        case Instruction::Id::jump_if_zero:
+                            {
+                                // Convert the relative index to an absolute index.
+                                auto index = i + code[i].value.as_integer(interpreter);
+                                auto [ a, b ] = auto_jump_blocks[i];
+
+                                spend_budget(i, index);
+
+                                // If the test value is in a register we can branch on it directly.
+                                if (!stack_cache.empty())
+                                {
+                                    auto test = pop_cached_as_bool(builder, context, stack_cache);
+                                    spill_stack_cache(builder,
+                                                      helpers,
+                                                      interpreter_ptr,
+                                                      stack_cache);
+
+                                    builder.CreateBr(a);
+                                    builder.SetInsertPoint(a);
+                                    builder.CreateCondBr(test, b, blocks[index]);
+                                    builder.SetInsertPoint(b);
+                                    break;
+                                }
+
+                                emit_location();
+
+                                // Allocate a bool to hold the test value.  Then call the
+                                // handle_pop_bool function to get the value from the stack.
+                                auto test_value = create_entry_alloca(function, bool_type);
+                                auto pop_result = builder.CreateCall(helpers.handle_pop_bool_fn,
+                                                                   { interpreter_ptr, test_value });
 
                                 // Check the result of the call instruction and branch to the next
                                 // block if no errors were raised, otherwise branch to the either
@@ -1166,450 +3882,848 @@ namespace sorth::internal
                                                    ? exit_block
                                                    : blocks[catch_markers.back()];
 
-                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, blocks[i]);
+                                auto cmp = builder.CreateICmpNE(pop_result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp, error_block, a, unlikely_error(builder));
+
+                                // The pop was successful, so switch to the next block and generate
+                                // the code to perform the jump based on the test value.
+                                builder.SetInsertPoint(a);
+
+                                // Jump to the 'success' block if the test value is false, otherwise
+                                // jump to the 'fail' block.
+                                auto read_value = builder.CreateLoad(bool_type, test_value);
+                                builder.CreateCondBr(read_value, b, blocks[index]);
+                                builder.SetInsertPoint(b);
+                            }
+                            break;
+
+                        case Instruction::Id::jump_if_not_zero:
+                            {
+                                // Convert the relative index to an absolute index.
+                                auto index = i + code[i].value.as_integer(interpreter);
+                                auto [ a, b ] = auto_jump_blocks[i];
+
+                                spend_budget(i, index);
+
+                                // If the test value is in a register we can branch on it directly.
+                                if (!stack_cache.empty())
+                                {
+                                    auto test = pop_cached_as_bool(builder, context, stack_cache);
+                                    spill_stack_cache(builder,
+                                                      helpers,
+                                                      interpreter_ptr,
+                                                      stack_cache);
+
+                                    builder.CreateBr(a);
+                                    builder.SetInsertPoint(a);
+                                    builder.CreateCondBr(test, blocks[index], b);
+                                    builder.SetInsertPoint(b);
+                                    break;
+                                }
+
+                                emit_location();
+
+                                // Allocate a bool to hold the test value.  Then call the
+                                // handle_pop_bool function to get the value from the stack.
+                                auto test_value = create_entry_alloca(function, bool_type);
+                                auto pop_result = builder.CreateCall(helpers.handle_pop_bool_fn,
+                                                                   { interpreter_ptr, test_value });
+
+                                // Check the result of the call instruction and branch to the next
+                                // block if no errors were raised, otherwise branch to the either
+                                // the exit block or the exception handler block.
+                                auto error_block = catch_markers.empty()
+                                                   ? exit_block
+                                                   : blocks[catch_markers.back()];
+
+                                auto cmp = builder.CreateICmpNE(pop_result, builder.getInt64(0));
+                                builder.CreateCondBr(cmp, error_block, a, unlikely_error(builder));
+
+                                // The pop was successful, so switch to the next block and generate
+                                // the code to perform the jump based on the test value.
+                                builder.SetInsertPoint(a);
+
+                                // Jump to the 'success' block if the test value is true, otherwise
+                                // jump to the 'fail' block.
+                                auto read_value = builder.CreateLoad(bool_type, test_value);
+                                builder.CreateCondBr(read_value, blocks[index], b);
+                                builder.SetInsertPoint(b);
+                            }
+                            break;
+
+                        case Instruction::Id::jump_loop_start:
+                            {
+                                // Jump to the start block of the loop.
+                                auto start_index = loop_markers.back().first;
+
+                                spend_budget(i, start_index);
+                                spill_stack_cache(builder, helpers, interpreter_ptr, stack_cache);
+                                builder.CreateBr(blocks[start_index]);
                                 builder.SetInsertPoint(blocks[i]);
                             }
                             break;
 
-                        case Instruction::Id::def_constant:
+                        case Instruction::Id::jump_loop_exit:
                             {
-                                // Get the constant name and create a string constant in the module
-                                // for it.
-                                auto name = code[i].value.as_string(interpreter);
-                                auto name_ptr = define_string_constant(name,
-                                                                       builder,
-                                                                       module,
-                                                                       context);
+                                // Jump to the end block of the loop.
+                                auto end_index = loop_markers.back().second;
+
+                                spill_stack_cache(builder, helpers, interpreter_ptr, stack_cache);
+                                builder.CreateBr(blocks[end_index]);
+
+                                builder.SetInsertPoint(blocks[i]);
+                            }
+                            break;
+
+                        case Instruction::Id::jump_target:
+                            {
+                                // Make sure that the current block has a terminator instruction, if
+                                // not, add one to jump to the next block.  This is because this
+                                // would be a natural follow through in the original byte-code.
+                                if (builder.GetInsertBlock()->getTerminator() == nullptr)
+                                {
+                                    spill_stack_cache(builder,
+                                                      helpers,
+                                                      interpreter_ptr,
+                                                      stack_cache);
+                                    builder.CreateBr(blocks[i]);
+                                }
+
+                                // We're done with the current block, switch over to the next.
+                                // Code can reach this block from more than one place, so we
+                                // start over with no cached state.
+                                builder.SetInsertPoint(blocks[i]);
+
+                                stack_cache.clear();
+                                pending_location.reset();
+
+
+                                // If this is a catch target, we need to generate the code to push
+                                // the exception onto the stack and clear the last exception.
+                                if (   (!catch_target_markers.empty())
+                                    && (catch_target_markers.find(i) != catch_target_markers.end()))
+                                {
+                                    builder.CreateCall(helpers.handle_push_last_exception_fn,
+                                                       { interpreter_ptr });
+                                }
+                            }
+                            break;
+                    }
+                }
+
+                // Make sure that the last block has a terminator instruction, if not, add one to
+                // jump to the exit block.
+                if (builder.GetInsertBlock()->getTerminator() == nullptr)
+                {
+                    spill_stack_cache(builder, helpers, interpreter_ptr, stack_cache);
+                    builder.CreateBr(exit_block);
+                }
+
+                // We're done with the last user code block, so switch over to the exit block and
+                // generate the code to return from the function.
+                builder.SetInsertPoint(exit_block);
+
+                if (local_frame != nullptr)
+                {
+                    builder.CreateCall(helpers.handle_free_locals_fn,
+                                       { local_frame, builder.getInt64(promoted_locals.size()) });
+                }
+
+                builder.CreateRetVoid();
+            }
+
+
+            // Create a stack slot in the function's entry block.  Keeping all of these in the entry
+            // block means that they're allocated only once per call, even when used in a loop, and
+            // lets llvm promote them to registers.
+            llvm::AllocaInst* create_entry_alloca(llvm::Function* function, llvm::Type* type)
+            {
+                auto& entry_block = function->getEntryBlock();
+                llvm::IRBuilder<> entry_builder(&entry_block, entry_block.begin());
+
+                return entry_builder.CreateAlloca(type);
+            }
+
+
+            // Generate a direct call to another word's native code.  This lets llvm see the called
+            // function and inline it when it's small enough.  If the called word has since been
+            // replaced we go through the interpreter instead.  Returns the status of the call, 0
+            // for success and -1 if the word raised an error.
+            llvm::Value* generate_direct_call(llvm::IRBuilder<>& builder,
+                                              std::unique_ptr<llvm::LLVMContext>& context,
+                                              const JitHelpers& helpers,
+                                              llvm::Function* function,
+                                              llvm::Value* interpreter_ptr,
+                                              int64_t index,
+                                              const DirectCallTarget& target,
+                                              llvm::BasicBlock* next_block)
+            {
+                auto void_type = llvm::Type::getVoidTy(*context.get());
+                auto ptr_type = llvm::PointerType::getUnqual(void_type);
+                auto int8_type = llvm::Type::getInt8Ty(*context.get());
+                auto int64_type = llvm::Type::getInt64Ty(*context.get());
+
+                auto direct_block = llvm::BasicBlock::Create(*context,
+                                                             "direct_call",
+                                                             function,
+                                                             next_block);
+                auto indirect_block = llvm::BasicBlock::Create(*context,
+                                                               "indirect_call",
+                                                               function,
+                                                               next_block);
+                auto done_block = llvm::BasicBlock::Create(*context,
+                                                           "call_done",
+                                                           function,
+                                                           next_block);
+
+                // The target's data lives for as long as the engine, so it's safe to embed it's
+                // address directly in the code.
+                auto address_of = [&](const void* pointer)
+                    {
+                        return builder.CreateIntToPtr(builder.getInt64((uint64_t)pointer),
+                                                      ptr_type);
+                    };
+
+                auto index_const = builder.getInt64(index);
+
+                // Check that the word hasn't been replaced since we were compiled.
+                auto flag = builder.CreateLoad(int8_type,
+                                               address_of(target.data->is_current.get()));
+                flag->setAtomic(llvm::AtomicOrdering::Monotonic);
+
+                auto is_current = builder.CreateICmpNE(flag, builder.getInt8(0));
+                builder.CreateCondBr(is_current, direct_block, indirect_block);
+
+                // Call the word's function directly, doing the same book keeping that the word's
+                // handler would.
+                builder.SetInsertPoint(direct_block);
+                builder.CreateCall(helpers.handle_word_enter_fn, { interpreter_ptr, index_const });
+                builder.CreateCall(target.function,
+                                   {
+                                       interpreter_ptr,
+                                       address_of(&target.data->locations),
+                                       address_of(&target.data->constants)
+                                   });
+
+                auto direct_result = builder.CreateCall(helpers.handle_word_leave_fn,
+                                                        { interpreter_ptr });
+                builder.CreateBr(done_block);
+
+                // The word has been replaced, so call whatever is in the handler table now.
+                builder.SetInsertPoint(indirect_block);
+
+                auto indirect_result = builder.CreateCall(helpers.handle_word_execute_index_fn,
+                                                          { interpreter_ptr, index_const });
+                builder.CreateBr(done_block);
+
+                builder.SetInsertPoint(done_block);
+
+                auto result = builder.CreatePHI(int64_type, 2);
+                result->addIncoming(direct_result, direct_block);
+                result->addIncoming(indirect_result, indirect_block);
+
+                return result;
+            }
+
+
+            // Is the intrinsic one of the numeric operations, as opposed to a stack operation?
+            static bool is_numeric_intrinsic(WordIntrinsic intrinsic)
+            {
+                switch (intrinsic)
+                {
+                    case WordIntrinsic::none:
+                    case WordIntrinsic::dup:
+                    case WordIntrinsic::drop:
+                    case WordIntrinsic::swap:
+                    case WordIntrinsic::over:
+                    case WordIntrinsic::rot:
+                    case WordIntrinsic::increment_variable:
+                    case WordIntrinsic::decrement_variable:
+                        return false;
+
+                    default:
+                        return true;
+                }
+            }
+
+
+            // Write all of the values held in registers out to the interpreter's stack, bottom
+            // first, and leave the cache empty.
+            void spill_stack_cache(llvm::IRBuilder<>& builder,
+                                   const JitHelpers& helpers,
+                                   llvm::Value* interpreter_ptr,
+                                   StackCache& cache)
+            {
+                for (const auto& cached : cache)
+                {
+                    llvm::Function* push_fn = nullptr;
+
+                    switch (cached.type)
+                    {
+                        case CachedType::integer:  push_fn = helpers.handle_push_int_fn;     break;
+                        case CachedType::floating: push_fn = helpers.handle_push_double_fn;  break;
+                        case CachedType::boolean:  push_fn = helpers.handle_push_bool_fn;    break;
+                    }
+
+                    builder.CreateCall(push_fn, { interpreter_ptr, cached.value });
+                }
+
+                cache.clear();
+            }
+
+
+            // Pop the top cached value and convert it to an i1 following the same truthiness rules
+            // as the interpreter, where any non-zero number is true.
+            llvm::Value* pop_cached_as_bool(llvm::IRBuilder<>& builder,
+                                            std::unique_ptr<llvm::LLVMContext>& context,
+                                            StackCache& cache)
+            {
+                auto cached = cache.back();
+                cache.pop_back();
+
+                switch (cached.type)
+                {
+                    case CachedType::integer:
+                        return builder.CreateICmpNE(cached.value, builder.getInt64(0));
+
+                    case CachedType::floating:
+                        {
+                            auto double_type = llvm::Type::getDoubleTy(*context.get());
+                            auto zero = llvm::ConstantFP::get(double_type, 0.0);
+
+                            return builder.CreateFCmpUNE(cached.value, zero);
+                        }
+
+                    case CachedType::boolean:
+                        break;
+                }
 
-                                // Call the handle_define_constant function to define the constant
-                                // in the interpreter.
-                                auto result = builder.CreateCall(handle_define_constant_fn,
-                                                                 { interpreter_ptr, name_ptr });
+                return cached.value;
+            }
 
-                                // Check the result of the call instruction and branch to the next
-                                // block if no errors were raised, otherwise branch to the either
-                                // the exit block or the exception handler block.
-                                auto error_block = catch_markers.empty()
-                                                   ? exit_block
-                                                   : blocks[catch_markers.back()];
 
-                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, blocks[i]);
-                                builder.SetInsertPoint(blocks[i]);
-                            }
-                            break;
+            // Try to perform an intrinsic operation entirely on values held in registers.  If the
+            // operands aren't all cached, or are of types that the word itself would need to deal
+            // with, nothing is generated and we return false so that the caller can fall back to
+            // generate_intrinsic or a plain call to the word.
+            bool generate_cached_intrinsic(llvm::IRBuilder<>& builder,
+                                           std::unique_ptr<llvm::LLVMContext>& context,
+                                           StackCache& cache,
+                                           WordIntrinsic intrinsic)
+            {
+                auto size = cache.size();
 
-                        case Instruction::Id::read_variable:
-                            {
-                                // Call the handle_read_variable function to read the variable from
-                                // the interpreter.
-                                auto result = builder.CreateCall(handle_read_variable_fn,
-                                                                 { interpreter_ptr });
+                // The stack operations work the same way no matter the types of their values.
+                switch (intrinsic)
+                {
+                    case WordIntrinsic::none:
+                    case WordIntrinsic::increment_variable:
+                    case WordIntrinsic::decrement_variable:
+                        return false;
 
-                                // Check the result of the call instruction and branch to the next
-                                // block if no errors were raised, otherwise branch to the either
-                                // the exit block or the exception handler block.
-                                auto error_block = catch_markers.empty()
-                                                   ? exit_block
-                                                   : blocks[catch_markers.back()];
+                    case WordIntrinsic::dup:
+                        if (size < 1)
+                        {
+                            return false;
+                        }
 
-                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, blocks[i]);
-                                builder.SetInsertPoint(blocks[i]);
-                            }
-                            break;
+                        cache.push_back(cache.back());
+                        return true;
 
-                        case Instruction::Id::write_variable:
-                            {
-                                // Call the handle_write_variable function to write the variable to
-                                // the interpreter.
-                                auto result = builder.CreateCall(handle_write_variable_fn,
-                                                                 { interpreter_ptr });
+                    case WordIntrinsic::drop:
+                        if (size < 1)
+                        {
+                            return false;
+                        }
 
-                                // Check the result of the call instruction and branch to the next
-                                // block if no errors were raised, otherwise branch to the either
-                                // the exit block or the exception handler block.
-                                auto error_block = catch_markers.empty()
-                                                   ? exit_block
-                                                   : blocks[catch_markers.back()];
+                        cache.pop_back();
+                        return true;
 
-                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, blocks[i]);
-                                builder.SetInsertPoint(blocks[i]);
-                            }
-                            break;
+                    case WordIntrinsic::swap:
+                        if (size < 2)
+                        {
+                            return false;
+                        }
 
-                        case Instruction::Id::execute:
-                            {
-                                // Get the name or index of the word to execute.
-                                auto& value = code[i].value;
+                        std::swap(cache[size - 1], cache[size - 2]);
+                        return true;
 
-                                // Capture the result of teh execute call instruction.
-                                llvm::CallInst* result = nullptr;
+                    case WordIntrinsic::over:
+                        if (size < 2)
+                        {
+                            return false;
+                        }
 
-                                if (value.is_string())
-                                {
-                                    // The value is a string, so execute the word based on it's
-                                    // name.
-                                    auto name = value.as_string(interpreter);
-                                    auto name_ptr = define_string_constant(name,
-                                                                           builder,
-                                                                           module,
-                                                                           context);
+                        // a b -- b a b
+                        std::swap(cache[size - 1], cache[size - 2]);
+                        cache.push_back(cache[size - 2]);
+                        return true;
 
-                                    result = builder.CreateCall(handle_word_execute_name_fn,
-                                                                { interpreter_ptr, name_ptr });
-                                }
-                                else if (value.is_numeric())
-                                {
-                                    // The value is a number, so execute the word based on it's
-                                    // handler index.
-                                    auto index = value.as_integer(interpreter);
-                                    auto int_const = llvm::ConstantInt::get(int64_type, index);
-                                    result = builder.CreateCall(handle_word_execute_index_fn,
-                                                                { interpreter_ptr, int_const });
-                                }
-                                else
-                                {
-                                    throw_error("Can not execute unexpected value type.");
-                                }
+                    case WordIntrinsic::rot:
+                        if (size < 3)
+                        {
+                            return false;
+                        }
 
-                                // Check the result of the call instruction and branch to the next
-                                // if no errors were raised, otherwise branch to the either the
-                                // exit block or the exception handler block.
-                                auto next_block = blocks[i];
+                        // a b c -- c a b
+                        std::rotate(cache.end() - 3, cache.end() - 1, cache.end());
+                        return true;
 
-                                // Jump to the catch block if there is one, or the exit block if
-                                // not.
-                                auto error_block = catch_markers.empty()
-                                                   ? exit_block
-                                                   : blocks[catch_markers.back()];
+                    default:
+                        break;
+                }
 
-                                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, next_block);
+                bool is_unary =    (intrinsic == WordIntrinsic::increment)
+                                || (intrinsic == WordIntrinsic::decrement)
+                                || (intrinsic == WordIntrinsic::logic_not);
 
-                                // We're done with the current block, so move on to the next one.
-                                builder.SetInsertPoint(next_block);
-                            }
-                            break;
+                if (size < (is_unary ? 1 : 2))
+                {
+                    return false;
+                }
 
-                        case Instruction::Id::word_index:
-                            {
-                                // Make sure we have a name for lookup.
-                                if (!code[i].value.is_string())
-                                {
-                                    throw_error("Expected a numeric value for word_index.");
-                                }
+                auto double_type = llvm::Type::getDoubleTy(*context.get());
 
-                                // See if we can find the word in the interpreter at compile time.
-                                // If we can, we'll generate the code to push it's index on the
-                                // stack, if we can't we'll generate code to try again at runtime.
-                                auto name = code[i].value.as_string(interpreter);
-                                auto [ found, word_info ] = interpreter->find_word(name);
+                // Unary operations are simple, only logical not can take a bool.
+                if (is_unary)
+                {
+                    auto& a = cache.back();
 
-                                if (found)
-                                {
-                                    auto int_const = llvm::ConstantInt::get(int64_type,
-                                                                           word_info.handler_index);
-                                    builder.CreateCall(handle_push_int_fn,
-                                                       { interpreter_ptr, int_const });
-                                }
-                                else
-                                {
-                                    auto name_constant = define_string_constant(name,
-                                                                                builder,
-                                                                                module,
-                                                                                context);
-                                    builder.CreateCall(handle_word_index_name_fn,
-                                                       { interpreter_ptr, name_constant });
-                                }
-                            }
-                            break;
+                    if (intrinsic == WordIntrinsic::logic_not)
+                    {
+                        // Reuse the interpreter's truthiness rules, then invert.
+                        auto test = pop_cached_as_bool(builder, context, cache);
+                        cache.push_back({ CachedType::boolean, builder.CreateNot(test) });
+                        return true;
+                    }
 
-                        case Instruction::Id::word_exists:
-                            {
-                                // Make sure we have a name for lookup.
-                                if (!code[i].value.is_string())
-                                {
-                                    throw_error("Expected a numeric value for word_index.");
-                                }
+                    if (a.type == CachedType::integer)
+                    {
+                        a.value = intrinsic == WordIntrinsic::increment
+                                  ? builder.CreateAdd(a.value, builder.getInt64(1))
+                                  : builder.CreateSub(a.value, builder.getInt64(1));
+                        return true;
+                    }
 
-                                // See if we can find the word in the interpreter at compile time.
-                                // If we can, we'll generate the code to push a true value onto the
-                                // stack, if we can't we'll generate code to try again at runtime.
-                                auto name = code[i].value.as_string(interpreter);
-                                auto [ found, _ ] = interpreter->find_word(name);
+                    if (a.type == CachedType::floating)
+                    {
+                        auto one = llvm::ConstantFP::get(double_type, 1.0);
 
-                                if (found)
-                                {
-                                    auto true_const = llvm::ConstantInt::get(bool_type, true);
-                                    builder.CreateCall(handle_push_bool_fn,
-                                                       { interpreter_ptr, true_const });
-                                }
-                                else
-                                {
-                                    auto name_ptr = define_string_constant(name,
-                                                                           builder,
-                                                                           module,
-                                                                           context);
+                        a.value = intrinsic == WordIntrinsic::increment
+                                  ? builder.CreateFAdd(a.value, one)
+                                  : builder.CreateFSub(a.value, one);
+                        return true;
+                    }
 
-                                    builder.CreateCall(handle_word_exists_name_fn,
-                                                       { interpreter_ptr, name_ptr });
-                                }
-                            }
-                            break;
+                    return false;
+                }
 
-                        case Instruction::Id::push_constant_value:
-                            {
-                                // Get the value to push from the instruction.
-                                auto& value = code[i].value;
+                auto a = cache[size - 2];
+                auto b = cache[size - 1];
 
-                                // Check the type of the value.  If it's one of the simple types
-                                // directly generate the code to push it's value onto the stack.
-                                if (value.is_bool())
-                                {
-                                    auto bool_value = value.as_bool();
-                                    auto bool_const = llvm::ConstantInt::get(bool_type, bool_value);
-                                    builder.CreateCall(handle_push_bool_fn,
-                                                       { interpreter_ptr, bool_const });
-                                }
-                                else if (value.is_integer())
-                                {
-                                    auto int_value = value.as_integer(interpreter);
-                                    auto int_const = llvm::ConstantInt::get(int64_type, int_value);
-                                    builder.CreateCall(handle_push_int_fn,
-                                                       { interpreter_ptr, int_const });
-                                }
-                                else if (value.is_float())
-                                {
-                                    auto double_value = value.as_float(interpreter);
-                                    auto double_const = llvm::ConstantFP::get(double_type,
-                                                                              double_value);
-                                    builder.CreateCall(handle_push_double_fn,
-                                                       { interpreter_ptr, double_const });
-                                }
-                                else if (value.is_string())
-                                {
-                                    auto string_value = value.as_string(interpreter);
-                                    auto string_ptr = define_string_constant(string_value,
-                                                                             builder,
-                                                                             module,
-                                                                             context);
-                                    builder.CreateCall(handle_push_string_fn,
-                                                       { interpreter_ptr, string_ptr });
-                                }
-                                else
-                                {
-                                    // The value is a complex type that we can't inline in the JITed
-                                    // code directly.  So we'll add it to the constants array and
-                                    // generate code to push the value from the array onto the
-                                    // stack.
-                                    auto index = constants.size();
-                                    constants.push_back(value);
+                // Booleans are handled by the words themselves.
+                if (   (a.type == CachedType::boolean)
+                    || (b.type == CachedType::boolean))
+                {
+                    return false;
+                }
 
-                                    auto index_const = builder.getInt64(index);
-                                    builder.CreateCall(handle_push_value_fn,
-                                                       { interpreter_ptr,
-                                                         constant_arr_ptr,
-                                                         index_const });
-                                }
-                            }
-                            break;
+                bool is_float =    (a.type == CachedType::floating)
+                                || (b.type == CachedType::floating);
 
-                        case Instruction::Id::mark_loop_exit:
-                            {
-                                // Capture the start and end indexes of the loop for later use.
-                                auto start_index = i + 1;
-                                auto end_index = i + code[i].value.as_integer(interpreter);
+                bool allow_float =    (intrinsic != WordIntrinsic::mod)
+                                   && (intrinsic != WordIntrinsic::bit_and)
+                                   && (intrinsic != WordIntrinsic::bit_or)
+                                   && (intrinsic != WordIntrinsic::bit_xor);
 
-                                loop_markers.push_back({ start_index, end_index });
-                            }
-                            break;
+                if (is_float && !allow_float)
+                {
+                    return false;
+                }
 
-                        case Instruction::Id::unmark_loop_exit:
-                            {
-                                // Clear the current loop markers.
-                                loop_markers.pop_back();
-                            }
-                            break;
+                // Only inline integer division when we can prove that the divisor is safe.
+                // Otherwise leave it to generate_intrinsic to check at run-time.
+                if (   (!is_float)
+                    && (   (intrinsic == WordIntrinsic::divide)
+                        || (intrinsic == WordIntrinsic::mod)))
+                {
+                    auto divisor = llvm::dyn_cast<llvm::ConstantInt>(b.value);
 
-                        case Instruction::Id::mark_catch:
-                            {
-                                // Capture the index of the catch block for later use.
-                                auto target_index = i + code[i].value.as_integer(interpreter);
-                                catch_markers.push_back(target_index);
-                                catch_target_markers.insert(target_index);
-                            }
-                            break;
+                    if (   (divisor == nullptr)
+                        || (divisor->isZero())
+                        || (divisor->isMinusOne()))
+                    {
+                        return false;
+                    }
+                }
 
-                        case Instruction::Id::unmark_catch:
-                            {
-                                // Clear the current catch markers so that we don't jump to then.
-                                // Note that we leave the catch_target_markers set alone so that we
-                                // can generate the code to push the exception onto the stack when
-                                // we reach the catch target instruction.
-                                catch_markers.pop_back();
-                            }
-                            break;
+                // Mixed operations are performed as doubles, same as the interpreter.
+                if (is_float)
+                {
+                    if (a.type == CachedType::integer)
+                    {
+                        a.value = builder.CreateSIToFP(a.value, double_type);
+                    }
+
+                    if (b.type == CachedType::integer)
+                    {
+                        b.value = builder.CreateSIToFP(b.value, double_type);
+                    }
+                }
+
+                llvm::Value* result = nullptr;
+                CachedType result_type = is_float ? CachedType::floating : CachedType::integer;
+
+                switch (intrinsic)
+                {
+                    case WordIntrinsic::add:
+                        result = is_float ? builder.CreateFAdd(a.value, b.value)
+                                          : builder.CreateAdd(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::subtract:
+                        result = is_float ? builder.CreateFSub(a.value, b.value)
+                                          : builder.CreateSub(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::multiply:
+                        result = is_float ? builder.CreateFMul(a.value, b.value)
+                                          : builder.CreateMul(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::divide:
+                        result = is_float ? builder.CreateFDiv(a.value, b.value)
+                                          : builder.CreateSDiv(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::mod:
+                        result = builder.CreateSRem(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::bit_and:
+                        result = builder.CreateAnd(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::bit_or:
+                        result = builder.CreateOr(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::bit_xor:
+                        result = builder.CreateXor(a.value, b.value);
+                        break;
+
+                    case WordIntrinsic::equal:
+                        result = is_float ? builder.CreateFCmpOEQ(a.value, b.value)
+                                          : builder.CreateICmpEQ(a.value, b.value);
+                        result_type = CachedType::boolean;
+                        break;
+
+                    case WordIntrinsic::not_equal:
+                        result = is_float ? builder.CreateFCmpUNE(a.value, b.value)
+                                          : builder.CreateICmpNE(a.value, b.value);
+                        result_type = CachedType::boolean;
+                        break;
+
+                    case WordIntrinsic::greater_equal:
+                        result = is_float ? builder.CreateFCmpOGE(a.value, b.value)
+                                          : builder.CreateICmpSGE(a.value, b.value);
+                        result_type = CachedType::boolean;
+                        break;
+
+                    case WordIntrinsic::less_equal:
+                        result = is_float ? builder.CreateFCmpOLE(a.value, b.value)
+                                          : builder.CreateICmpSLE(a.value, b.value);
+                        result_type = CachedType::boolean;
+                        break;
+
+                    case WordIntrinsic::greater:
+                        result = is_float ? builder.CreateFCmpOGT(a.value, b.value)
+                                          : builder.CreateICmpSGT(a.value, b.value);
+                        result_type = CachedType::boolean;
+                        break;
+
+                    case WordIntrinsic::less:
+                        result = is_float ? builder.CreateFCmpOLT(a.value, b.value)
+                                          : builder.CreateICmpSLT(a.value, b.value);
+                        result_type = CachedType::boolean;
+                        break;
+
+                    default:
+                        throw_error("Unexpected intrinsic operation.");
+                }
 
-                        case Instruction::Id::mark_context:
-                            {
-                                // Call the handle_manage_context function to mark the context in
-                                // the interpreter.
-                                auto bool_const = llvm::ConstantInt::get(bool_type, true);
-                                builder.CreateCall(handle_manage_context_fn,
-                                                   { interpreter_ptr, bool_const });
-                            }
-                            break;
+                cache.pop_back();
+                cache.back() = { result_type, result };
 
-                        case Instruction::Id::release_context:
-                            {
-                                // Call the handle_manage_context function to release the context in
-                                // the interpreter.
-                                auto bool_const = llvm::ConstantInt::get(bool_type, false);
-                                builder.CreateCall(handle_manage_context_fn,
-                                                   { interpreter_ptr, bool_const });
-                            }
-                            break;
+                return true;
+            }
 
-                        case Instruction::Id::jump:
-                            {
-                                // Jump to the target block.
-                                auto index = i + code[i].value.as_integer(interpreter);
-                                builder.CreateBr(blocks[index]);
-                            }
-                            break;
 
-                        case Instruction::Id::jump_if_zero:
-                            {
-                                // Convert the relative index to an absolute index.
-                                auto index = i + code[i].value.as_integer(interpreter);
+            // Generate the inline code for one of the intrinsic word operations.  At run-time the
+            // operands are checked, if they are integers or doubles the operation is performed
+            // directly.  Otherwise, (or if an integer divide by zero is attempted,) the original
+            // word is called as usual.  Control ends up in either the next_block or the
+            // error_block.
+            //
+            // This is used when the operands are on the interpreter's stack, see
+            // generate_cached_intrinsic for when they're in registers.
+            void generate_intrinsic(llvm::IRBuilder<>& builder,
+                                    std::unique_ptr<llvm::LLVMContext>& context,
+                                    const JitHelpers& helpers,
+                                    llvm::Function* function,
+                                    llvm::Value* interpreter_ptr,
+                                    WordIntrinsic intrinsic,
+                                    int64_t index,
+                                    const std::function<void()>& emit_location,
+                                    llvm::BasicBlock* next_block,
+                                    llvm::BasicBlock* error_block)
+            {
+                auto int64_type = llvm::Type::getInt64Ty(*context.get());
+                auto double_type = llvm::Type::getDoubleTy(*context.get());
 
-                                // Allocate a bool to hold the test value.  Then call the
-                                // handle_pop_bool function to get the value from the stack.
-                                auto test_value = builder.CreateAlloca(bool_type);
-                                auto pop_result = builder.CreateCall(handle_pop_bool_fn,
-                                                                   { interpreter_ptr, test_value });
+                auto int_block = llvm::BasicBlock::Create(*context,
+                                                          "intrinsic_int",
+                                                          function,
+                                                          next_block);
+                auto float_block = llvm::BasicBlock::Create(*context,
+                                                            "intrinsic_float",
+                                                            function,
+                                                            next_block);
+                auto generic_block = llvm::BasicBlock::Create(*context,
+                                                              "intrinsic_generic",
+                                                              function,
+                                                              next_block);
+
+                // Integer only operations can't take double values.
+                bool allow_float =    (intrinsic != WordIntrinsic::mod)
+                                   && (intrinsic != WordIntrinsic::bit_and)
+                                   && (intrinsic != WordIntrinsic::bit_or)
+                                   && (intrinsic != WordIntrinsic::bit_xor);
+
+                bool is_unary =    (intrinsic == WordIntrinsic::increment)
+                                || (intrinsic == WordIntrinsic::decrement)
+                                || (intrinsic == WordIntrinsic::logic_not);
+
+                // Pop the operands, the helper leaves the stack alone and returns 0 if they aren't
+                // of the expected types.  Otherwise it returns 1 for integers and 2 for doubles.
+                auto a_int = create_entry_alloca(function, int64_type);
+                auto b_int = create_entry_alloca(function, int64_type);
+                auto a_float = create_entry_alloca(function, double_type);
+                auto b_float = create_entry_alloca(function, double_type);
+
+                llvm::Value* kind = nullptr;
+
+                if (is_unary)
+                {
+                    kind = builder.CreateCall(helpers.handle_pop_numeric_fn,
+                                              { interpreter_ptr, a_int, a_float });
+                }
+                else
+                {
+                    kind = builder.CreateCall(helpers.handle_pop_numeric_pair_fn,
+                                              { interpreter_ptr,
+                                                builder.getInt1(allow_float),
+                                                a_int,
+                                                b_int,
+                                                a_float,
+                                                b_float });
+                }
 
-                                // Check the result of the call instruction and branch to the next
-                                // block if no errors were raised, otherwise branch to the either
-                                // the exit block or the exception handler block.
-                                auto error_block = catch_markers.empty()
-                                                   ? exit_block
-                                                   : blocks[catch_markers.back()];
+                auto type_switch = builder.CreateSwitch(kind, generic_block, 2);
 
-                                // Get the two blocks that we'll jump to based on the test value.
-                                auto [ a, b ] = auto_jump_blocks[i];
+                type_switch->addCase(builder.getInt64(1), int_block);
+                type_switch->addCase(builder.getInt64(2), float_block);
 
-                                auto cmp = builder.CreateICmpNE(pop_result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, a);
+                // Generate the integer version of the operation.
+                builder.SetInsertPoint(int_block);
 
-                                // The pop was successful, so switch to the next block and generate
-                                // the code to perform the jump based on the test value.
-                                builder.SetInsertPoint(a);
+                auto a = builder.CreateLoad(int64_type, a_int);
+                llvm::Value* b = is_unary ? nullptr : builder.CreateLoad(int64_type, b_int);
 
-                                // Jump to the 'success' block if the test value is false, otherwise
-                                // jump to the 'fail' block.
-                                auto read_value = builder.CreateLoad(bool_type, test_value);
-                                builder.CreateCondBr(read_value, b, blocks[index]);
-                                builder.SetInsertPoint(b);
-                            }
-                            break;
+                if (   (intrinsic == WordIntrinsic::divide)
+                    || (intrinsic == WordIntrinsic::mod))
+                {
+                    // Dividing by zero, or dividing the smallest integer by -1 is undefined.  So
+                    // put the operands back and let the word deal with it.
+                    auto divide_block = llvm::BasicBlock::Create(*context,
+                                                                 "intrinsic_divide",
+                                                                 function,
+                                                                 next_block);
+                    auto restore_block = llvm::BasicBlock::Create(*context,
+                                                                  "intrinsic_restore",
+                                                                  function,
+                                                                  next_block);
+
+                    auto is_zero = builder.CreateICmpEQ(b, builder.getInt64(0));
+                    auto is_minus_one = builder.CreateICmpEQ(b, builder.getInt64(-1));
+                    auto is_unsafe = builder.CreateOr(is_zero, is_minus_one);
+                    builder.CreateCondBr(is_unsafe, restore_block, divide_block);
+
+                    builder.SetInsertPoint(restore_block);
+                    builder.CreateCall(helpers.handle_push_int_fn, { interpreter_ptr, a });
+                    builder.CreateCall(helpers.handle_push_int_fn, { interpreter_ptr, b });
+                    builder.CreateBr(generic_block);
+
+                    builder.SetInsertPoint(divide_block);
+                }
 
-                        case Instruction::Id::jump_if_not_zero:
-                            {
-                                // Convert the relative index to an absolute index.
-                                auto index = i + code[i].value.as_integer(interpreter);
+                llvm::Value* int_result = nullptr;
+                bool is_bool_result = false;
 
-                                // Allocate a bool to hold the test value.  Then call the
-                                // handle_pop_bool function to get the value from the stack.
-                                auto test_value = builder.CreateAlloca(bool_type);
-                                auto pop_result = builder.CreateCall(handle_pop_bool_fn,
-                                                                   { interpreter_ptr, test_value });
+                switch (intrinsic)
+                {
+                    case WordIntrinsic::add:       int_result = builder.CreateAdd(a, b);      break;
+                    case WordIntrinsic::subtract:  int_result = builder.CreateSub(a, b);      break;
+                    case WordIntrinsic::multiply:  int_result = builder.CreateMul(a, b);      break;
+                    case WordIntrinsic::divide:    int_result = builder.CreateSDiv(a, b);     break;
+                    case WordIntrinsic::mod:       int_result = builder.CreateSRem(a, b);     break;
+                    case WordIntrinsic::bit_and:   int_result = builder.CreateAnd(a, b);      break;
+                    case WordIntrinsic::bit_or:    int_result = builder.CreateOr(a, b);       break;
+                    case WordIntrinsic::bit_xor:   int_result = builder.CreateXor(a, b);      break;
+
+                    case WordIntrinsic::increment:
+                        int_result = builder.CreateAdd(a, builder.getInt64(1));
+                        break;
+
+                    case WordIntrinsic::decrement:
+                        int_result = builder.CreateSub(a, builder.getInt64(1));
+                        break;
+
+                    case WordIntrinsic::logic_not:
+                        int_result = builder.CreateICmpEQ(a, builder.getInt64(0));
+                        is_bool_result = true;
+                        break;
+
+                    case WordIntrinsic::equal:
+                        int_result = builder.CreateICmpEQ(a, b);
+                        is_bool_result = true;
+                        break;
+
+                    case WordIntrinsic::not_equal:
+                        int_result = builder.CreateICmpNE(a, b);
+                        is_bool_result = true;
+                        break;
+
+                    case WordIntrinsic::greater_equal:
+                        int_result = builder.CreateICmpSGE(a, b);
+                        is_bool_result = true;
+                        break;
+
+                    case WordIntrinsic::less_equal:
+                        int_result = builder.CreateICmpSLE(a, b);
+                        is_bool_result = true;
+                        break;
+
+                    case WordIntrinsic::greater:
+                        int_result = builder.CreateICmpSGT(a, b);
+                        is_bool_result = true;
+                        break;
+
+                    case WordIntrinsic::less:
+                        int_result = builder.CreateICmpSLT(a, b);
+                        is_bool_result = true;
+                        break;
+
+                    default:
+                        throw_error("Unexpected intrinsic operation.");
+                }
 
-                                // Check the result of the call instruction and branch to the next
-                                // block if no errors were raised, otherwise branch to the either
-                                // the exit block or the exception handler block.
-                                auto error_block = catch_markers.empty()
-                                                   ? exit_block
-                                                   : blocks[catch_markers.back()];
+                builder.CreateCall(is_bool_result ? helpers.handle_push_bool_fn
+                                                  : helpers.handle_push_int_fn,
+                                   { interpreter_ptr, int_result });
+                builder.CreateBr(next_block);
 
-                                auto [ a, b ] = auto_jump_blocks[i];
+                // Now generate the double version of the operation, if there is one.
+                builder.SetInsertPoint(float_block);
 
-                                auto cmp = builder.CreateICmpNE(pop_result, builder.getInt64(0));
-                                builder.CreateCondBr(cmp, error_block, a);
+                if (allow_float)
+                {
+                    auto fa = builder.CreateLoad(double_type, a_float);
+                    llvm::Value* fb = is_unary ? nullptr : builder.CreateLoad(double_type, b_float);
+                    auto one = llvm::ConstantFP::get(double_type, 1.0);
+                    auto zero = llvm::ConstantFP::get(double_type, 0.0);
 
-                                // The pop was successful, so switch to the next block and generate
-                                // the code to perform the jump based on the test value.
-                                builder.SetInsertPoint(a);
+                    llvm::Value* float_result = nullptr;
 
-                                // Jump to the 'success' block if the test value is true, otherwise
-                                // jump to the 'fail' block.
-                                auto read_value = builder.CreateLoad(bool_type, test_value);
-                                builder.CreateCondBr(read_value, blocks[index], b);
-                                builder.SetInsertPoint(b);
-                            }
+                    switch (intrinsic)
+                    {
+                        case WordIntrinsic::add:
+                            float_result = builder.CreateFAdd(fa, fb);
                             break;
 
-                        case Instruction::Id::jump_loop_start:
-                            {
-                                // Jump to the start block of the loop.
-                                auto start_index = loop_markers.back().first;
+                        case WordIntrinsic::subtract:
+                            float_result = builder.CreateFSub(fa, fb);
+                            break;
 
-                                builder.CreateBr(blocks[start_index]);
-                                builder.SetInsertPoint(blocks[i]);
-                            }
+                        case WordIntrinsic::multiply:
+                            float_result = builder.CreateFMul(fa, fb);
                             break;
 
-                        case Instruction::Id::jump_loop_exit:
-                            {
-                                // Jump to the end block of the loop.
-                                auto end_index = loop_markers.back().second;
-                                builder.CreateBr(blocks[end_index]);
+                        case WordIntrinsic::divide:
+                            float_result = builder.CreateFDiv(fa, fb);
+                            break;
 
-                                builder.SetInsertPoint(blocks[i]);
-                            }
+                        case WordIntrinsic::increment:
+                            float_result = builder.CreateFAdd(fa, one);
                             break;
 
-                        case Instruction::Id::jump_target:
-                            {
-                                // Make sure that the current block has a terminator instruction, if
-                                // not, add one to jump to the next block.  This is because this
-                                // would be a natural follow through in the original byte-code.
-                                if (builder.GetInsertBlock()->getTerminator() == nullptr)
-                                {
-                                    builder.CreateBr(blocks[i]);
-                                }
+                        case WordIntrinsic::decrement:
+                            float_result = builder.CreateFSub(fa, one);
+                            break;
 
-                                // We're done with the current block, switch over to the next.
-                                builder.SetInsertPoint(blocks[i]);
+                        case WordIntrinsic::logic_not:
+                            float_result = builder.CreateFCmpOEQ(fa, zero);
+                            break;
 
+                        case WordIntrinsic::equal:
+                            float_result = builder.CreateFCmpOEQ(fa, fb);
+                            break;
 
-                                // If this is a catch target, we need to generate the code to push
-                                // the exception onto the stack and clear the last exception.
-                                if (   (!catch_target_markers.empty())
-                                    && (catch_target_markers.find(i) != catch_target_markers.end()))
-                                {
-                                    builder.CreateCall(handle_push_last_exception_fn,
-                                                       { interpreter_ptr });
-                                }
-                            }
+                        case WordIntrinsic::not_equal:
+                            float_result = builder.CreateFCmpUNE(fa, fb);
+                            break;
+
+                        case WordIntrinsic::greater_equal:
+                            float_result = builder.CreateFCmpOGE(fa, fb);
                             break;
+
+                        case WordIntrinsic::less_equal:
+                            float_result = builder.CreateFCmpOLE(fa, fb);
+                            break;
+
+                        case WordIntrinsic::greater:
+                            float_result = builder.CreateFCmpOGT(fa, fb);
+                            break;
+
+                        case WordIntrinsic::less:
+                            float_result = builder.CreateFCmpOLT(fa, fb);
+                            break;
+
+                        default:
+                            throw_error("Unexpected intrinsic operation.");
                     }
-                }
 
-                // Make sure that the last block has a terminator instruction, if not, add one to
-                // jump to the exit block.
-                if (builder.GetInsertBlock()->getTerminator() == nullptr)
+                    builder.CreateCall(is_bool_result ? helpers.handle_push_bool_fn
+                                                      : helpers.handle_push_double_fn,
+                                       { interpreter_ptr, float_result });
+                    builder.CreateBr(next_block);
+                }
+                else
                 {
-                    builder.CreateBr(exit_block);
+                    // The helper never returns doubles for integer only operations.
+                    builder.CreateUnreachable();
                 }
 
-                // We're done with the last user code block, so switch over to the exit block and
-                // generate the code to return from the function.
-                builder.SetInsertPoint(exit_block);
-                builder.CreateRetVoid();
+                // Finally, the fallback is to just call the word.
+                builder.SetInsertPoint(generic_block);
+                emit_location();
+
+                auto index_const = llvm::ConstantInt::get(int64_type, index);
+                auto result = builder.CreateCall(helpers.handle_word_execute_index_fn,
+                                                 { interpreter_ptr, index_const });
+
+                auto cmp = builder.CreateICmpNE(result, builder.getInt64(0));
+                builder.CreateCondBr(cmp, error_block, next_block, unlikely_error(builder));
             }
 
 
@@ -1648,6 +4762,82 @@ namespace sorth::internal
             }
 
 
+            // Pop a numeric value for an intrinsic operation.  Returns 1 if the value was an
+            // integer, 2 if it was a double.  If the value isn't one of those types it's left on
+            // the stack and 0 is returned so that the original word can deal with it.
+            static int64_t handle_pop_numeric(void* interpreter_ptr,
+                                              int64_t* int_value,
+                                              double* float_value)
+            {
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+
+                if (interpreter->depth() < 1)
+                {
+                    return 0;
+                }
+
+                auto value = interpreter->pop();
+
+                if (value.is_integer())
+                {
+                    *int_value = value.as_integer(interpreter);
+                    return 1;
+                }
+
+                if (value.is_float())
+                {
+                    *float_value = value.as_float(interpreter);
+                    return 2;
+                }
+
+                interpreter->push(value);
+                return 0;
+            }
+
+
+            // Pop a pair of numeric values for an intrinsic operation.  If both are integers they
+            // are returned as integers, (1.)  If they are a mix of integers and doubles they are
+            // both returned as doubles, (2,) but only if the operation allows it.  Otherwise the
+            // values are left on the stack and 0 is returned.
+            static int64_t handle_pop_numeric_pair(void* interpreter_ptr,
+                                                   bool allow_float,
+                                                   int64_t* a_int,
+                                                   int64_t* b_int,
+                                                   double* a_float,
+                                                   double* b_float)
+            {
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+
+                if (interpreter->depth() < 2)
+                {
+                    return 0;
+                }
+
+                auto b = interpreter->pop();
+                auto a = interpreter->pop();
+
+                if ((a.is_integer()) && (b.is_integer()))
+                {
+                    *a_int = a.as_integer(interpreter);
+                    *b_int = b.as_integer(interpreter);
+                    return 1;
+                }
+
+                if (   (allow_float)
+                    && ((a.is_integer()) || (a.is_float()))
+                    && ((b.is_integer()) || (b.is_float())))
+                {
+                    *a_float = a.as_float(interpreter);
+                    *b_float = b.as_float(interpreter);
+                    return 2;
+                }
+
+                interpreter->push(a);
+                interpreter->push(b);
+                return 0;
+            }
+
+
             // Filter word names to be acceptable for use as llvm function names.
             std::string filter_word_name(const std::string& name)
             {
@@ -1897,20 +5087,115 @@ namespace sorth::internal
             static int64_t handle_word_execute_name(void* interpreter_ptr, const char* name)
             {
                 int64_t result = 0;
-                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+
+                try
+                {
+                    auto location = interpreter->get_current_location();
+
+                    interpreter->call_stack_push(name, location);
+                    interpreter->execute_word(name);
+                    interpreter->call_stack_pop();
+                }
+                catch (std::runtime_error& error)
+                {
+                    interpreter->call_stack_pop();
+
+                    set_last_exception(error);
+                    result = -1;
+                }
+
+                return result;
+            }
+
+
+            // Handle executing a word by index for the JITed code.
+            static int64_t handle_word_execute_index(void* interpreter_ptr, int64_t index)
+            {
+                int64_t result = 0;
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+
+                try
+                {
+                    auto& info = interpreter->get_handler_info(index);
+
+                    interpreter->call_stack_push(info);
+                    info.function(interpreter);
+                    interpreter->call_stack_pop();
+                }
+                catch (std::runtime_error& error)
+                {
+                    interpreter->call_stack_pop();
+
+                    set_last_exception(error);
+                    result = -1;
+                }
+
+                return result;
+            }
+
+
+            // Construct the boxed values of a word's promoted local frame.
+            static void handle_init_locals(void* frame_ptr, int64_t count)
+            {
+                auto frame = static_cast<Value*>(frame_ptr);
+
+                for (int64_t i = 0; i < count; ++i)
+                {
+                    new (&frame[i]) Value();
+                }
+            }
+
+
+            // Destroy the boxed values of a word's promoted local frame.
+            static void handle_free_locals(void* frame_ptr, int64_t count)
+            {
+                auto frame = static_cast<Value*>(frame_ptr);
+
+                for (int64_t i = 0; i < count; ++i)
+                {
+                    frame[i].~Value();
+                }
+            }
+
+
+            // A newly defined variable starts out empty.
+            static void handle_reset_local(void* frame_ptr, int64_t index)
+            {
+                auto frame = static_cast<Value*>(frame_ptr);
+
+                frame[index] = Value();
+            }
+
+
+            // Push the value of a boxed promoted local.  Constants push a deep copy of their value,
+            // just as the interpreter's constant words do.
+            static void handle_read_local(void* interpreter_ptr,
+                                          void* frame_ptr,
+                                          int64_t index,
+                                          bool deep_copy)
+            {
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+                auto frame = static_cast<Value*>(frame_ptr);
+
+                interpreter->push(deep_copy ? frame[index].deep_copy() : frame[index]);
+            }
+
+
+            // Pop a value into a boxed promoted local.
+            static int64_t handle_write_local(void* interpreter_ptr, void* frame_ptr, int64_t index)
+            {
+                int64_t result = 0;
 
                 try
                 {
-                    auto location = interpreter->get_current_location();
+                    auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+                    auto frame = static_cast<Value*>(frame_ptr);
 
-                    interpreter->call_stack_push(name, location);
-                    interpreter->execute_word(name);
-                    interpreter->call_stack_pop();
+                    frame[index] = interpreter->pop();
                 }
                 catch (std::runtime_error& error)
                 {
-                    interpreter->call_stack_pop();
-
                     set_last_exception(error);
                     result = -1;
                 }
@@ -1919,28 +5204,48 @@ namespace sorth::internal
             }
 
 
-            // Handle executing a word by index for the JITed code.
-            static int64_t handle_word_execute_index(void* interpreter_ptr, int64_t index)
+            // Count a trip around a loop against the coroutine's instruction budget, yielding to
+            // the other coroutines if it's been used up.
+            static void handle_spend_budget(void* interpreter_ptr, int64_t instructions)
             {
-                int64_t result = 0;
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+
+                interpreter->spend_instruction_budget(instructions);
+            }
+
+
+            // Get ready for a direct call from one JITed word to another.  This does the same book
+            // keeping that calling the word through it's handler would.
+            static void handle_word_enter(void* interpreter_ptr, int64_t index)
+            {
+                auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
+
+                interpreter->call_stack_push(interpreter->get_handler_info(index));
+
+                clear_last_exception();
+                interpreter->mark_context();
+            }
+
+
+            // Clean up after a direct call from one JITed word to another.  Returns -1 if the
+            // called word raised an error.
+            static int64_t handle_word_leave(void* interpreter_ptr)
+            {
+                int64_t result = last_exception ? -1 : 0;
                 auto& interpreter = *static_cast<InterpreterPtr*>(interpreter_ptr);
 
                 try
                 {
-                    auto& info = interpreter->get_handler_info(index);
-
-                    interpreter->call_stack_push(info);
-                    info.function(interpreter);
-                    interpreter->call_stack_pop();
+                    interpreter->release_context();
                 }
                 catch (std::runtime_error& error)
                 {
-                    interpreter->call_stack_pop();
-
                     set_last_exception(error);
                     result = -1;
                 }
 
+                interpreter->call_stack_pop();
+
                 return result;
             }
 
@@ -2006,25 +5311,191 @@ namespace sorth::internal
         // The storage for the last exception that occurred in the JITed code.
         thread_local std::optional<std::runtime_error> JitEngine::last_exception;
 
-
-        // Only one thread can be JIT compiling at a time.
-        std::mutex jit_lock;
-
         // The one instance of the jit engine.
         JitEngine jit_engine;
 
 
+        // Recreate a constant value that was written into a script's object file.
+        Value aot_value(const AotValue& value)
+        {
+            switch (value.type)
+            {
+                case AotValueType::none:
+                    return None();
+
+                case AotValueType::boolean:
+                    return value.integer != 0;
+
+                case AotValueType::integer:
+                    return value.integer;
+
+                case AotValueType::floating:
+                    return value.floating;
+
+                case AotValueType::string:
+                    return std::string(value.string);
+
+                case AotValueType::array:
+                    {
+                        auto array = std::make_shared<Array>(value.item_count);
+
+                        for (int64_t i = 0; i < value.item_count; ++i)
+                        {
+                            (*array)[i] = aot_value(value.items[i]);
+                        }
+
+                        return array;
+                    }
+            }
+
+            throw_error("Unexpected constant type in an ahead of time compiled script.");
+        }
+
+
+        // Create the handler for a function that was compiled ahead of time.
+        WordFunction aot_word_function(const AotWord& word, CodeGenType type)
+        {
+            auto data = std::make_shared<JitWordData>();
+
+            for (int64_t i = 0; i < word.location_count; ++i)
+            {
+                const auto& location = word.locations[i];
+
+                data->locations.push_back(Location(location.path, location.line, location.column));
+            }
+
+            for (int64_t i = 0; i < word.constant_count; ++i)
+            {
+                data->constants.push_back(aot_value(word.constants[i]));
+            }
+
+            return JitEngine::wrap_generated_function(word.function, data, nullptr, type);
+        }
+
+
+        // Register the words of a script that was compiled ahead of time and then run it's top
+        // level code.
+        void run_aot_script(InterpreterPtr& interpreter, const AotScript& script)
+        {
+            // The generated code calls words by their handler index, so we have to have the same
+            // words that the script was compiled with.
+            bool is_matching = interpreter->handler_count() == (size_t)script.handler_count;
+
+            for (int64_t i = 0; (is_matching) && (i < script.handler_count); ++i)
+            {
+                is_matching = interpreter->get_handler_info(i).name == script.handler_names[i];
+            }
+
+            if (!is_matching)
+            {
+                throw_error("The script was compiled with a different version of sorth or of it's "
+                            "standard library.");
+            }
+
+            for (int64_t i = 0; i < script.word_count; ++i)
+            {
+                const auto& word = script.words[i];
+
+                auto context = ExecutionContext::run_time;
+                WordFunction handler;
+
+                if (word.function != nullptr)
+                {
+                    handler = aot_word_function(word, CodeGenType::word);
+                }
+                else
+                {
+                    // Immediate words have already done their work, their byte-code isn't part of
+                    // the executable.
+                    std::string name = word.name;
+
+                    context = ExecutionContext::compile_time;
+                    handler = WordFunction::Handler([name](InterpreterPtr& interpreter)
+                        {
+                            throw_error(interpreter,
+                                        "The immediate word " + name + " is not available in a "
+                                        "script that was compiled ahead of time.");
+                        });
+                }
+
+                interpreter->add_word(word.name,
+                                      handler,
+                                      Location(word.location.path,
+                                               word.location.line,
+                                               word.location.column),
+                                      context,
+                                      word.is_hidden ? WordVisibility::hidden
+                                                     : WordVisibility::visible,
+                                      WordType::scripted,
+                                      word.description,
+                                      word.signature);
+            }
+
+            // Now run the script like process_source would have, with it's directory in the search
+            // path.
+            std::filesystem::path path = script.body.name;
+            auto body = aot_word_function(script.body, CodeGenType::script_body);
+
+            interpreter->add_search_path(path.parent_path());
+            interpreter->call_stack_push(path.string(), Location(path.string(), 1, 1));
+
+            body(interpreter);
+
+            interpreter->call_stack_pop();
+        }
+
+
     }
 
 
-    // Lock the JIT engine and JIT compile the given immediate word.
-    WordFunction jit_immediate_word(InterpreterPtr& Interpreter,
-                                    const Construction& construction)
+    // Get a copy of the JIT engine's current optimization settings.
+    JitSettings get_jit_settings()
     {
         std::lock_guard<std::mutex> lock(jit_lock);
 
-        return jit_engine.jit_bytecode(Interpreter, construction);
+        return jit_engine.settings;
+    }
+
 
+    // Update the JIT engine's optimization settings, these will be used for all future compiles.
+    void set_jit_settings(const JitSettings& settings)
+    {
+        std::lock_guard<std::mutex> lock(jit_lock);
+
+        // The target machine and the profiler support have already been set up, so keep those
+        // settings in sync with the engine.
+        auto use_host_cpu = jit_engine.settings.use_host_cpu;
+        auto perf_map = jit_engine.settings.perf_map;
+
+        jit_engine.settings = settings;
+        jit_engine.settings.use_host_cpu = use_host_cpu;
+        jit_engine.settings.perf_map = perf_map;
+    }
+
+
+    // Get a copy of the JIT engine's compile statistics.
+    JitStats get_jit_stats()
+    {
+        std::lock_guard<std::mutex> lock(jit_lock);
+
+        return jit_engine.stats;
+    }
+
+
+    // Clear out the JIT engine's compile statistics.
+    void reset_jit_stats()
+    {
+        std::lock_guard<std::mutex> lock(jit_lock);
+
+        jit_engine.stats = JitStats();
+    }
+
+
+    // JIT compile the given immediate word.  The engine takes it's own lock when it needs it.
+    WordFunction jit_immediate_word(InterpreterPtr& Interpreter,
+                                    const Construction& construction)
+    {
+        return jit_engine.jit_bytecode(Interpreter, construction);
     }
 
 
@@ -2039,12 +5510,269 @@ namespace sorth::internal
                             const ByteCode& code,
                             const std::map<std::string, Construction>& word_jit_cache)
     {
-        std::lock_guard<std::mutex> lock(jit_lock);
-
         return jit_engine.jit_bytecode(Interpreter, name, code, word_jit_cache);
     }
 
 
+    // Compile the script into an object file instead of running it.
+    void aot_compile_module(InterpreterPtr& interpreter,
+                            const std::string& name,
+                            const ByteCode& code,
+                            const std::map<std::string, Construction>& word_jit_cache,
+                            size_t first_handler,
+                            const std::filesystem::path& object_path)
+    {
+        jit_engine.aot_compile(interpreter, name, code, word_jit_cache, first_handler, object_path);
+    }
+
+
+}
+
+
+// The helper functions are exported under these names for the code of scripts that were compiled
+// ahead of time.  They're found when the script's object file is linked with the sorth library.
+extern "C"
+{
+
+
+    SORTH_API int64_t sorth_aot_handle_pop_bool(void* interpreter_ptr, bool* value)
+    {
+        return sorth::internal::JitEngine::handle_pop_bool(interpreter_ptr, value);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_pop_numeric(void* interpreter_ptr,
+                                                   int64_t* int_value,
+                                                   double* float_value)
+    {
+        return sorth::internal::JitEngine::handle_pop_numeric(interpreter_ptr,
+                                                              int_value,
+                                                              float_value);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_pop_numeric_pair(void* interpreter_ptr,
+                                                        bool allow_float,
+                                                        int64_t* a_int,
+                                                        int64_t* b_int,
+                                                        double* a_float,
+                                                        double* b_float)
+    {
+        return sorth::internal::JitEngine::handle_pop_numeric_pair(interpreter_ptr,
+                                                                   allow_float,
+                                                                   a_int,
+                                                                   b_int,
+                                                                   a_float,
+                                                                   b_float);
+    }
+
+
+    SORTH_API void sorth_aot_handle_set_location(void* interpreter_ptr,
+                                                 void* location_array_ptr,
+                                                 size_t index)
+    {
+        sorth::internal::JitEngine::handle_set_location(interpreter_ptr, location_array_ptr, index);
+    }
+
+
+    SORTH_API void sorth_aot_handle_manage_context(void* interpreter_ptr, bool is_marking)
+    {
+        sorth::internal::JitEngine::handle_manage_context(interpreter_ptr, is_marking);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_define_variable(void* interpreter_ptr, const char* name)
+    {
+        return sorth::internal::JitEngine::handle_define_variable(interpreter_ptr, name);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_define_constant(void* interpreter_ptr, const char* name)
+    {
+        return sorth::internal::JitEngine::handle_define_constant(interpreter_ptr, name);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_read_variable(void* interpreter_ptr)
+    {
+        return sorth::internal::JitEngine::handle_read_variable(interpreter_ptr);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_write_variable(void* interpreter_ptr)
+    {
+        return sorth::internal::JitEngine::handle_write_variable(interpreter_ptr);
+    }
+
+
+    SORTH_API void sorth_aot_handle_push_last_exception(void* interpreter_ptr)
+    {
+        sorth::internal::JitEngine::handle_push_last_exception(interpreter_ptr);
+    }
+
+
+    SORTH_API void sorth_aot_handle_push_bool(void* interpreter_ptr, bool value)
+    {
+        sorth::internal::JitEngine::handle_push_bool(interpreter_ptr, value);
+    }
+
+
+    SORTH_API void sorth_aot_handle_push_int(void* interpreter_ptr, int64_t value)
+    {
+        sorth::internal::JitEngine::handle_push_int(interpreter_ptr, value);
+    }
+
+
+    SORTH_API void sorth_aot_handle_push_double(void* interpreter_ptr, double value)
+    {
+        sorth::internal::JitEngine::handle_push_double(interpreter_ptr, value);
+    }
+
+
+    SORTH_API void sorth_aot_handle_push_string(void* interpreter_ptr, const char* value)
+    {
+        sorth::internal::JitEngine::handle_push_string(interpreter_ptr, value);
+    }
+
+
+    SORTH_API void sorth_aot_handle_push_value(void* interpreter_ptr,
+                                               void* array_ptr,
+                                               int64_t index)
+    {
+        sorth::internal::JitEngine::handle_push_value(interpreter_ptr, array_ptr, index);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_word_execute_name(void* interpreter_ptr, const char* name)
+    {
+        return sorth::internal::JitEngine::handle_word_execute_name(interpreter_ptr, name);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_word_execute_index(void* interpreter_ptr, int64_t index)
+    {
+        return sorth::internal::JitEngine::handle_word_execute_index(interpreter_ptr, index);
+    }
+
+
+    SORTH_API void sorth_aot_handle_init_locals(void* frame_ptr, int64_t count)
+    {
+        sorth::internal::JitEngine::handle_init_locals(frame_ptr, count);
+    }
+
+
+    SORTH_API void sorth_aot_handle_free_locals(void* frame_ptr, int64_t count)
+    {
+        sorth::internal::JitEngine::handle_free_locals(frame_ptr, count);
+    }
+
+
+    SORTH_API void sorth_aot_handle_reset_local(void* frame_ptr, int64_t index)
+    {
+        sorth::internal::JitEngine::handle_reset_local(frame_ptr, index);
+    }
+
+
+    SORTH_API void sorth_aot_handle_read_local(void* interpreter_ptr,
+                                               void* frame_ptr,
+                                               int64_t index,
+                                               bool deep_copy)
+    {
+        sorth::internal::JitEngine::handle_read_local(interpreter_ptr, frame_ptr, index, deep_copy);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_write_local(void* interpreter_ptr,
+                                                   void* frame_ptr,
+                                                   int64_t index)
+    {
+        return sorth::internal::JitEngine::handle_write_local(interpreter_ptr, frame_ptr, index);
+    }
+
+
+    SORTH_API void sorth_aot_handle_spend_budget(void* interpreter_ptr, int64_t instructions)
+    {
+        sorth::internal::JitEngine::handle_spend_budget(interpreter_ptr, instructions);
+    }
+
+
+    SORTH_API void sorth_aot_handle_word_enter(void* interpreter_ptr, int64_t index)
+    {
+        sorth::internal::JitEngine::handle_word_enter(interpreter_ptr, index);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_word_leave(void* interpreter_ptr)
+    {
+        return sorth::internal::JitEngine::handle_word_leave(interpreter_ptr);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_word_index_name(void* interpreter_ptr, const char* name)
+    {
+        return sorth::internal::JitEngine::handle_word_index_name(interpreter_ptr, name);
+    }
+
+
+    SORTH_API int64_t sorth_aot_handle_word_exists_name(void* interpreter_ptr, const char* name)
+    {
+        return sorth::internal::JitEngine::handle_word_exists_name(interpreter_ptr, name);
+    }
+
+
+}
+
+
+// The entry point of a script that was compiled ahead of time.  The interpreter is set up the same
+// way the sorth executable sets it up, except that the standard library is found where it was when
+// the script was compiled.  Unless SORTH_LIB says otherwise.
+extern "C" SORTH_API int sorth_aot_main(int argc,
+                                        char* argv[],
+                                        const sorth::internal::AotScript* script)
+{
+    int exit_code = EXIT_SUCCESS;
+
+    try
+    {
+        auto env_mode = std::getenv("SORTH_EXE_MODE");
+        auto mode = (env_mode != nullptr) && (std::string(env_mode) == "jit")
+                    ? sorth::ExecutionMode::jit
+                    : sorth::ExecutionMode::byte_code;
+
+        auto interpreter = sorth::create_interpreter(mode);
+        auto env_path = std::getenv("SORTH_LIB");
+
+        interpreter->add_search_path(env_path != nullptr
+                                     ? std::filesystem::canonical(env_path)
+                                     : std::filesystem::path(script->std_lib_path));
+
+        sorth::register_builtin_words(interpreter);
+        sorth::register_terminal_words(interpreter);
+        sorth::register_io_words(interpreter);
+        #if (IS_UNIX == 1)
+            sorth::register_event_words(interpreter);
+        #endif
+        sorth::register_user_words(interpreter);
+        sorth::register_ffi_words(interpreter);
+
+        auto std_lib = interpreter->find_file("std.f");
+        interpreter->process_source(std_lib);
+
+        interpreter->mark_context();
+        interpreter->add_search_path(std::filesystem::current_path());
+
+        sorth::register_command_line_args(interpreter, argc, 1, argv);
+        sorth::internal::run_aot_script(interpreter, *script);
+
+        exit_code = interpreter->get_exit_code();
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::cerr << "Run-Time error: " << error.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return exit_code;
 }
 
 
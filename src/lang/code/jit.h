@@ -10,6 +10,106 @@ namespace sorth::internal
 {
 
 
+    // The settings that control how much effort the JIT engine puts into optimizing the code it
+    // generates.  The defaults can be overridden with the following environment variables:
+    //
+    //     SORTH_JIT_OPT_LEVEL            Optimization level, 0 - 3, for script modules.
+    //     SORTH_JIT_IMMEDIATE_OPT_LEVEL  Optimization level, 0 - 3, for immediate words.
+    //     SORTH_JIT_IMMEDIATE_THRESHOLD  How many calls an immediate word is interpreted for
+    //                                    before it's compiled, 0 to compile them right away.
+    //     SORTH_JIT_HOST_CPU             Set to 0 to generate code for a generic CPU.
+    //     SORTH_JIT_PASSES               A custom LLVM pass pipeline for script modules.
+    //     SORTH_JIT_PROMOTE_LOCALS       Set to 0 to keep word local variables in the interpreter.
+    //     SORTH_JIT_THREADS              How many threads compile a script's module, 0 for one
+    //                                    per CPU core.
+    //     SORTH_JIT_LAZY                 Set to 1 to compile a script's words on their first call.
+    //     SORTH_JIT_DEBUG                Set to 1 to keep the IR and machine code of JITed words.
+    //     SORTH_JIT_PERF                 Set to 1 to report JITed code to the Linux perf tools.
+    //
+    // Everything but the host CPU and perf settings can also be changed at run-time through the
+    // sorth.jit.* words.
+    struct JitSettings
+    {
+        // The optimization level used for a script's module, which holds the script's top level
+        // code and all of it's run-time words.
+        int64_t opt_level = 3;
+
+        // Immediate words are compiled one at a time in their own modules and are usually only run
+        // a handful of times during compilation.  So by default we don't spend much time optimizing
+        // them.
+        int64_t immediate_opt_level = 0;
+
+        // Because immediate words are run so rarely, it usually costs more to compile them than to
+        // just interpret their byte-code.  So they're interpreted until they've been called this
+        // many times, and then compiled.  If 0, immediate words are compiled as they're defined.
+        int64_t immediate_threshold = 16;
+
+        // Should the generated code take advantage of the features of the CPU we're running on?  If
+        // false we generate code for a generic CPU of the same architecture.  Because the engine
+        // is created at start up, this can only be changed through the environment.
+        bool use_host_cpu = true;
+
+        // A custom pass pipeline in the same textual format used by LLVM's opt tool.  For example,
+        // "function(mem2reg,instcombine,simplifycfg)".  If empty the default pipeline for the
+        // module's optimization level is used.
+        std::string passes;
+
+        // Should local variables that never escape their word be kept in registers, or the word's
+        // stack frame, instead of the interpreter's variable list?
+        bool promote_locals = true;
+
+        // A script's words are split up into several modules that are compiled in parallel.  This
+        // is the most threads that will be used, if 0 we use one for each of the host's cores.
+        int64_t compile_threads = 0;
+
+        // Should a script's words be compiled when they're first called instead of when the script
+        // is loaded?  This makes loading libraries of words cheap, but words compiled this way are
+        // always called through the interpreter.
+        bool lazy_words = false;
+
+        // Should the optimized IR and the disassembled machine code be kept with each word for
+        // sorth.show-ir and sorth.show-asm?  This costs time and memory so it's off by default.
+        bool capture_code = false;
+
+        // Should JITed code be reported to the Linux perf tools?  If so the name and location of
+        // each word is written to /tmp/perf-<pid>.map, and jitdump records are written if llvm
+        // was built with perf support.  Like the host CPU setting this is fixed at start up.
+        bool perf_map = false;
+    };
+
+
+    // Running totals of the work the JIT engine has done so that compile latency can be weighed
+    // against the quality of the generated code.
+    struct JitStats
+    {
+        // How many llvm modules and functions have been compiled.
+        size_t modules = 0;
+        size_t functions = 0;
+
+        // How many words had their compilation put off until their first call.
+        size_t deferred_words = 0;
+
+        // Time spent converting byte-code into llvm IR.
+        std::chrono::nanoseconds ir_generation_time = std::chrono::nanoseconds::zero();
+
+        // Time spent running the optimization pass pipeline.
+        std::chrono::nanoseconds optimization_time = std::chrono::nanoseconds::zero();
+
+        // Time spent by llvm generating and linking the machine code.
+        std::chrono::nanoseconds code_generation_time = std::chrono::nanoseconds::zero();
+    };
+
+
+    // Access the JIT engine's current optimization settings.
+    JitSettings get_jit_settings();
+    void set_jit_settings(const JitSettings& settings);
+
+
+    // Access the JIT engine's running compile statistics.
+    JitStats get_jit_stats();
+    void reset_jit_stats();
+
+
     // JIT compile a single immediate word into it's own module.
     WordFunction jit_immediate_word(InterpreterPtr& Interpreter,
                                     const Construction& construction);
@@ -27,7 +127,102 @@ namespace sorth::internal
                             const std::map<std::string, Construction>& word_jit_cache);
 
 
+    // A script compiled ahead of time is described by constant data in it's object file.  The
+    // layout of these structures has to match what aot_compile_module generates.
+    struct AotLocation
+    {
+        const char* path;
+        int64_t line;
+        int64_t column;
+    };
+
+
+    using AotFunction = void (*)(void*, const void*, const void*);
+
+
+    // Only simple constant values, and arrays of them, can be written into the object file.
+    enum class AotValueType : int64_t
+    {
+        none,
+        boolean,
+        integer,
+        floating,
+        string,
+        array
+    };
+
+
+    struct AotValue
+    {
+        AotValueType type;
+
+        int64_t integer;
+        double floating;
+        const char* string;
+
+        const AotValue* items;
+        int64_t item_count;
+    };
+
+
+    struct AotWord
+    {
+        // Immediate words have done their work by the time the script is compiled, so they don't
+        // have a function.
+        const char* name;
+        AotFunction function;
+
+        // The source locations that the function reports errors at, and the constant values that
+        // it pushes.
+        const AotLocation* locations;
+        int64_t location_count;
+        const AotValue* constants;
+        int64_t constant_count;
+
+        // How the word is listed in the dictionary.
+        const char* description;
+        const char* signature;
+        AotLocation location;
+        int64_t is_hidden;
+    };
+
+
+    struct AotScript
+    {
+        // Where the standard library the script was compiled against was found.
+        const char* std_lib_path;
+
+        // The generated code refers to words by their handler index, so the words that existed
+        // before the script's have to be the same when it's run.
+        const char* const* handler_names;
+        int64_t handler_count;
+
+        // The script's words in the order they were defined, and it's top level code.
+        const AotWord* words;
+        int64_t word_count;
+        AotWord body;
+    };
+
+
+    // Compile a script's top level code and run-time words into a native object file instead of
+    // running them.  The object's main function runs the script once it's linked with the sorth
+    // library.  Scripts that create words in any other way while they're compiled are rejected.
+    void aot_compile_module(InterpreterPtr& interpreter,
+                            const std::string& name,
+                            const ByteCode& code,
+                            const std::map<std::string, Construction>& word_jit_cache,
+                            size_t first_handler,
+                            const std::filesystem::path& object_path);
+
+
 }
 
 
+// The entry point called by the main function of an ahead of time compiled script.  It sets up
+// the interpreter the same way the sorth executable does and then runs the script.
+extern "C" SORTH_API int sorth_aot_main(int argc,
+                                        char* argv[],
+                                        const sorth::internal::AotScript* script);
+
+
 #endif
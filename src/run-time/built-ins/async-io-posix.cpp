@@ -0,0 +1,668 @@
+#include "sorth.h"
+
+
+#if defined(IS_UNIX)
+
+
+#include <unistd.h>
+#include <sys/uio.h>
+
+#if defined(__linux__)
+
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <linux/io_uring.h>
+
+    // We talk to io_uring through it's system calls directly, so all we need is for the kernel
+    // headers to know about them.
+    #if defined(__NR_io_uring_setup)
+
+        #define HAS_IO_URING 1
+
+    #endif
+
+#endif
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        std::string transfer_error(bool is_read, int error)
+        {
+            return std::string(is_read ? "FD could not be read from "
+                                       : "FD could not be written to ")
+                   + strerror(error) + ".";
+        }
+
+
+        // Run a read or write to completion on the calling thread, used by the task pool backend.
+        Value transfer(InterpreterPtr& interpreter,
+                       int fd,
+                       const ByteBufferPtr& buffer,
+                       off_t offset,
+                       bool is_read)
+        {
+            auto data = static_cast<char*>(buffer->data_ptr());
+            auto size = buffer->size();
+            size_t done = 0;
+
+            while (done < size)
+            {
+                errno = 0;
+
+                auto result = is_read ? pread(fd, data + done, size - done, offset + done)
+                                      : pwrite(fd, data + done, size - done, offset + done);
+
+                if (result == -1)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    throw_error(interpreter, transfer_error(is_read, errno));
+                }
+
+                if (result == 0)
+                {
+                    break;
+                }
+
+                done += result;
+            }
+
+            return static_cast<int64_t>(done);
+        }
+
+
+        FuturePtr transfer_on_task_pool(InterpreterPtr& interpreter,
+                                        int fd,
+                                        const ByteBufferPtr& buffer,
+                                        off_t offset,
+                                        bool is_read)
+        {
+            return task_spawn(interpreter,
+                              [=](InterpreterPtr& worker)
+                              {
+                                  return transfer(worker, fd, buffer, offset, is_read);
+                              });
+        }
+
+
+        #if (HAS_IO_URING == 1)
+
+
+            // Requests gathered past this many are sent to the kernel right away, even if it's
+            // still busy with earlier ones.
+            constexpr size_t batch_limit = 64;
+
+            constexpr unsigned ring_entries = 256;
+
+            // The user data of the completion thread's wake up poll, real requests always point at
+            // their Operation.
+            constexpr uint64_t wake_tag = 0;
+
+
+            // A request that's been handed to the ring.  It holds onto the buffer so that the
+            // memory the kernel is using stays alive until the request completes.
+            struct Operation
+            {
+                ByteBufferPtr buffer;
+                FuturePtr future;
+                struct iovec io_vector;
+                bool is_read;
+            };
+
+
+            class IoUring
+            {
+                private:
+                    int ring_fd;
+
+                    void* sq_ring;
+                    size_t sq_ring_size;
+                    void* cq_ring;
+                    size_t cq_ring_size;
+                    struct io_uring_sqe* sqes;
+                    size_t sqes_size;
+
+                    unsigned* sq_head;
+                    unsigned* sq_tail;
+                    unsigned sq_mask;
+                    unsigned sq_size;
+                    unsigned* sq_array;
+
+                    unsigned* cq_head;
+                    unsigned* cq_tail;
+                    unsigned cq_mask;
+                    unsigned cq_size;
+                    struct io_uring_cqe* cqes;
+
+                    // Written to by submitters to wake the completion thread while it's waiting on
+                    // the kernel, so that it can send the requests that have gathered since.
+                    int wake_fd;
+                    bool is_wake_armed;
+
+                    // Entries that have been written to the ring but not yet sent to the kernel,
+                    // and requests that have been started but not completed.
+                    std::mutex lock;
+                    std::condition_variable condition;
+                    size_t unsubmitted;
+                    size_t pending;
+
+                public:
+                    IoUring()
+                    : ring_fd(-1),
+                      sq_ring(MAP_FAILED),
+                      sq_ring_size(0),
+                      cq_ring(MAP_FAILED),
+                      cq_ring_size(0),
+                      sqes(static_cast<struct io_uring_sqe*>(MAP_FAILED)),
+                      sqes_size(0),
+                      wake_fd(-1),
+                      is_wake_armed(false),
+                      lock(),
+                      condition(),
+                      unsubmitted(0),
+                      pending(0)
+                    {
+                    }
+
+                    IoUring(const IoUring& ring) = delete;
+
+                    ~IoUring()
+                    {
+                        if (sqes != MAP_FAILED)
+                        {
+                            munmap(sqes, sqes_size);
+                        }
+
+                        if ((cq_ring != MAP_FAILED) && (cq_ring != sq_ring))
+                        {
+                            munmap(cq_ring, cq_ring_size);
+                        }
+
+                        if (sq_ring != MAP_FAILED)
+                        {
+                            munmap(sq_ring, sq_ring_size);
+                        }
+
+                        if (ring_fd != -1)
+                        {
+                            close(ring_fd);
+                        }
+
+                        if (wake_fd != -1)
+                        {
+                            close(wake_fd);
+                        }
+                    }
+
+                public:
+                    IoUring& operator =(const IoUring& ring) = delete;
+
+                public:
+                    // Set up the ring and start the thread that collects it's completions.  This
+                    // fails if the kernel is too old, or io_uring has been turned off.
+                    bool start()
+                    {
+                        struct io_uring_params params;
+
+                        memset(&params, 0, sizeof(params));
+
+                        wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+                        if (wake_fd == -1)
+                        {
+                            return false;
+                        }
+
+                        ring_fd = syscall(__NR_io_uring_setup, ring_entries, &params);
+
+                        if (ring_fd == -1)
+                        {
+                            return false;
+                        }
+
+                        // Older kernels throw completions away if the completion ring overflows,
+                        // which would leave their futures waiting forever.  Those are left to the
+                        // task pool.
+                        if ((params.features & IORING_FEAT_NODROP) == 0)
+                        {
+                            return false;
+                        }
+
+                        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                        cq_ring_size = params.cq_off.cqes
+                                       + params.cq_entries * sizeof(struct io_uring_cqe);
+
+                        // Newer kernels map both rings with a single call.
+                        bool is_single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+                        if (is_single_map)
+                        {
+                            sq_ring_size = std::max(sq_ring_size, cq_ring_size);
+                        }
+
+                        sq_ring = map(sq_ring_size, IORING_OFF_SQ_RING);
+
+                        if (sq_ring == MAP_FAILED)
+                        {
+                            return false;
+                        }
+
+                        if (is_single_map)
+                        {
+                            cq_ring = sq_ring;
+                        }
+                        else
+                        {
+                            cq_ring = map(cq_ring_size, IORING_OFF_CQ_RING);
+
+                            if (cq_ring == MAP_FAILED)
+                            {
+                                return false;
+                            }
+                        }
+
+                        sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+                        sqes = static_cast<struct io_uring_sqe*>(map(sqes_size, IORING_OFF_SQES));
+
+                        if (sqes == MAP_FAILED)
+                        {
+                            return false;
+                        }
+
+                        auto sq_base = static_cast<char*>(sq_ring);
+                        auto cq_base = static_cast<char*>(cq_ring);
+
+                        sq_head = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+                        sq_tail = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+                        sq_mask = *reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+                        sq_size = params.sq_entries;
+                        sq_array = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+
+                        cq_head = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+                        cq_tail = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+                        cq_mask = *reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+                        cq_size = params.cq_entries;
+                        cqes = reinterpret_cast<struct io_uring_cqe*>(cq_base
+                                                                     + params.cq_off.cqes);
+
+                        // The ring lives as long as the process does, so the completion thread is
+                        // never joined.
+                        std::thread([this]() { reap_main(); }).detach();
+
+                        return true;
+                    }
+
+                    FuturePtr submit(int fd,
+                                     const ByteBufferPtr& buffer,
+                                     off_t offset,
+                                     bool is_read)
+                    {
+                        auto future = std::make_shared<Future>();
+                        auto operation = new Operation
+                            {
+                                .buffer = buffer,
+                                .future = future,
+                                .io_vector = { .iov_base = buffer->data_ptr(),
+                                               .iov_len = buffer->size() },
+                                .is_read = is_read
+                            };
+
+                        std::unique_lock<std::mutex> guard(lock);
+
+                        // If the ring is full of requests the kernel hasn't taken yet, wait for the
+                        // completion thread to get them sent.  Likewise if there's no room left for
+                        // the request's completion, wait for the earlier ones to be reaped.
+                        if ((is_full()) || (is_at_limit()))
+                        {
+                            wake();
+                            condition.wait(guard,
+                                           [this]() { return (!is_full()) && (!is_at_limit()); });
+                        }
+
+                        bool is_batch_empty = unsubmitted == 0;
+
+                        auto& sqe = next_sqe();
+
+                        sqe.opcode = is_read ? IORING_OP_READV : IORING_OP_WRITEV;
+                        sqe.fd = fd;
+                        sqe.off = offset;
+                        sqe.addr = reinterpret_cast<uint64_t>(&operation->io_vector);
+                        sqe.len = 1;
+                        sqe.user_data = reinterpret_cast<uint64_t>(operation);
+
+                        queue_sqe();
+                        ++pending;
+
+                        // If the kernel is idle send the request right away.  Otherwise let
+                        // requests gather while the completion thread wakes up, it sends them all
+                        // at once when it does.
+                        bool should_flush = (pending == 1) || (unsubmitted >= batch_limit);
+
+                        if (should_flush)
+                        {
+                            flush();
+                        }
+
+                        // Either way, anything left over is the completion thread's to send.
+                        if ((unsubmitted > 0) && (is_batch_empty || should_flush))
+                        {
+                            wake();
+                        }
+
+                        return future;
+                    }
+
+                private:
+                    void* map(size_t size, off_t offset)
+                    {
+                        return mmap(nullptr,
+                                    size,
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_POPULATE,
+                                    ring_fd,
+                                    offset);
+                    }
+
+                    // Is the ring full of entries that the kernel hasn't taken yet?  This and the
+                    // ring updates below are all done with the lock held.
+                    bool is_full() const
+                    {
+                        auto head = std::atomic_ref<unsigned>(*sq_head).load(
+                                                                   std::memory_order_acquire);
+
+                        return (*sq_tail - head) >= sq_size;
+                    }
+
+                    // Are there as many requests in flight as the completion ring can hold?  One
+                    // entry is kept back for the completion of the wake up poll.
+                    bool is_at_limit() const
+                    {
+                        return pending >= (cq_size - 1);
+                    }
+
+                    // Get the next free entry of the ring, ready to be filled in.
+                    struct io_uring_sqe& next_sqe()
+                    {
+                        auto& sqe = sqes[*sq_tail & sq_mask];
+
+                        memset(&sqe, 0, sizeof(sqe));
+
+                        return sqe;
+                    }
+
+                    // Add the entry we just filled in to the ring, it's handed to the kernel on
+                    // the next flush.
+                    void queue_sqe()
+                    {
+                        auto tail = *sq_tail;
+                        auto index = tail & sq_mask;
+
+                        sq_array[index] = index;
+                        std::atomic_ref<unsigned>(*sq_tail).store(tail + 1,
+                                                                  std::memory_order_release);
+
+                        ++unsubmitted;
+                    }
+
+                    // Have the kernel tell us when the wake up fd is written to.
+                    void arm_wake()
+                    {
+                        auto& sqe = next_sqe();
+
+                        sqe.opcode = IORING_OP_POLL_ADD;
+                        sqe.fd = wake_fd;
+                        sqe.poll_events = POLLIN;
+                        sqe.user_data = wake_tag;
+
+                        queue_sqe();
+                        is_wake_armed = true;
+                    }
+
+                    // Wake up the completion thread if it's waiting on the kernel.
+                    void wake()
+                    {
+                        uint64_t value = 1;
+
+                        while (   (write(wake_fd, &value, sizeof(value)) == -1)
+                               && (errno == EINTR))
+                        {
+                        }
+                    }
+
+                    // Send the gathered requests to the kernel, called with the lock held.
+                    void flush()
+                    {
+                        while (unsubmitted > 0)
+                        {
+                            auto result = syscall(__NR_io_uring_enter,
+                                                  ring_fd,
+                                                  unsubmitted,
+                                                  0,
+                                                  0,
+                                                  nullptr,
+                                                  0);
+
+                            if (result == -1)
+                            {
+                                if (errno == EINTR)
+                                {
+                                    continue;
+                                }
+
+                                // The kernel is backed up, or is holding completions that didn't
+                                // fit in the ring (EBUSY).  The completion thread will try again
+                                // once it's reaped what's done.
+                                break;
+                            }
+
+                            if (result == 0)
+                            {
+                                break;
+                            }
+
+                            unsubmitted -= result;
+                        }
+
+                        // Anyone waiting for room in the ring can try again.
+                        condition.notify_all();
+                    }
+
+                    void reap_main()
+                    {
+                        std::vector<std::pair<Operation*, int32_t>> completed;
+
+                        while (true)
+                        {
+                            bool is_backed_up = false;
+
+                            {
+                                std::unique_lock<std::mutex> guard(lock);
+
+                                // Listen for the next wake up, and send everything that gathered
+                                // while we were waiting in one call.
+                                if ((!is_wake_armed) && (!is_full()))
+                                {
+                                    arm_wake();
+                                }
+
+                                flush();
+
+                                is_backed_up = unsubmitted > 0;
+
+                                if (is_backed_up)
+                                {
+                                    // The kernel wouldn't take the requests, give it a moment
+                                    // instead of waiting on it, then try again.
+                                    condition.wait_for(guard, std::chrono::milliseconds(1));
+                                }
+                            }
+
+                            // Wait for at least one completion.  When backed up only ask for them
+                            // without waiting, which has the kernel move any completions it's
+                            // holding into the ring so that we can reap them and make room.
+                            syscall(__NR_io_uring_enter,
+                                    ring_fd,
+                                    0,
+                                    is_backed_up ? 0 : 1,
+                                    IORING_ENTER_GETEVENTS,
+                                    nullptr,
+                                    0);
+
+                            bool was_woken = false;
+
+                            auto head = std::atomic_ref<unsigned>(*cq_head).load(
+                                                                     std::memory_order_relaxed);
+                            auto tail = std::atomic_ref<unsigned>(*cq_tail).load(
+                                                                     std::memory_order_acquire);
+
+                            for (; head != tail; ++head)
+                            {
+                                auto& cqe = cqes[head & cq_mask];
+
+                                if (cqe.user_data == wake_tag)
+                                {
+                                    was_woken = true;
+                                    continue;
+                                }
+
+                                completed.push_back({ reinterpret_cast<Operation*>(cqe.user_data),
+                                                      cqe.res });
+                            }
+
+                            std::atomic_ref<unsigned>(*cq_head).store(head,
+                                                                      std::memory_order_release);
+
+                            if (was_woken)
+                            {
+                                uint64_t value = 0;
+
+                                while (   (read(wake_fd, &value, sizeof(value)) == -1)
+                                       && (errno == EINTR))
+                                {
+                                }
+                            }
+
+                            {
+                                std::lock_guard<std::mutex> guard(lock);
+
+                                pending -= completed.size();
+
+                                if (was_woken)
+                                {
+                                    is_wake_armed = false;
+                                }
+
+                                // Anyone waiting for room for their completion can try again.
+                                condition.notify_all();
+                            }
+
+                            for (auto [ operation, result ] : completed)
+                            {
+                                if (result < 0)
+                                {
+                                    auto message = transfer_error(operation->is_read, -result);
+
+                                    operation->future->set_error(message);
+                                }
+                                else
+                                {
+                                    operation->future->set_value(static_cast<int64_t>(result));
+                                }
+
+                                delete operation;
+                            }
+
+                            completed.clear();
+                        }
+                    }
+            };
+
+
+            // The shared ring, or nullptr if io_uring isn't available.
+            IoUring* get_ring()
+            {
+                static IoUring* ring = []() -> IoUring*
+                    {
+                        auto new_ring = new IoUring();
+
+                        if (!new_ring->start())
+                        {
+                            delete new_ring;
+                            return nullptr;
+                        }
+
+                        return new_ring;
+                    }();
+
+                return ring;
+            }
+
+
+        #endif
+
+
+        FuturePtr start_transfer(InterpreterPtr& interpreter,
+                                 int fd,
+                                 ByteBufferPtr& buffer,
+                                 off_t offset,
+                                 bool is_read)
+        {
+            #if (HAS_IO_URING == 1)
+
+                if (auto ring = get_ring(); ring != nullptr)
+                {
+                    return ring->submit(fd, buffer, offset, is_read);
+                }
+
+            #endif
+
+            return transfer_on_task_pool(interpreter, fd, buffer, offset, is_read);
+        }
+
+
+    }
+
+
+    FuturePtr async_read(InterpreterPtr& interpreter, int fd, ByteBufferPtr& buffer, off_t offset)
+    {
+        return start_transfer(interpreter, fd, buffer, offset, true);
+    }
+
+
+    FuturePtr async_write(InterpreterPtr& interpreter, int fd, ByteBufferPtr& buffer, off_t offset)
+    {
+        return start_transfer(interpreter, fd, buffer, offset, false);
+    }
+
+
+    std::string async_io_backend()
+    {
+        #if (HAS_IO_URING == 1)
+
+            if (get_ring() != nullptr)
+            {
+                return "io_uring";
+            }
+
+        #endif
+
+        return "task-pool";
+    }
+
+
+}
+
+
+#endif // IS_UNIX
@@ -0,0 +1,32 @@
+
+#if defined(IS_UNIX)
+
+
+#pragma once
+
+
+namespace sorth::internal
+{
+
+
+    // Read into, or write out of, a byte buffer at the given offset in a file without waiting for
+    // it.  The future is completed with the number of bytes transferred, which can be short at
+    // the end of a file.  The buffer must not be used until then.
+    //
+    // On Linux the requests are sent through io_uring.  While earlier requests are still being
+    // processed, new ones are gathered up and sent to the kernel together, so a burst of small
+    // reads or writes costs a handful of system calls instead of one each.  Where io_uring isn't
+    // available, or is too old to hold on to completions that overflow it's ring, the requests
+    // are run on the task pool instead.
+    FuturePtr async_read(InterpreterPtr& interpreter, int fd, ByteBufferPtr& buffer, off_t offset);
+    FuturePtr async_write(InterpreterPtr& interpreter, int fd, ByteBufferPtr& buffer, off_t offset);
+
+
+    // The name of the backend that's handling async I/O, either "io_uring" or "task-pool".
+    std::string async_io_backend();
+
+
+}
+
+
+#endif // IS_UNIX
@@ -49,6 +49,8 @@ namespace sorth::internal
             auto index = interpreter->pop_as_size();
             auto new_value = interpreter->pop();
 
+            array->throw_if_frozen(interpreter);
+
             throw_if_out_of_bounds(interpreter, index, array->size(), "Array");
 
             (*array)[index] = new_value;
@@ -72,6 +74,8 @@ namespace sorth::internal
             auto index = interpreter->pop_as_size();
             auto value = interpreter->pop();
 
+            array->throw_if_frozen(interpreter);
+
             array->insert(index, value);
         }
 
@@ -81,6 +85,8 @@ namespace sorth::internal
             auto array = interpreter->pop_as_array();
             auto index = interpreter->pop_as_size();
 
+            array->throw_if_frozen(interpreter);
+
             throw_if_out_of_bounds(interpreter, index, array->size(), "Array");
 
             array->remove(index);
@@ -92,6 +98,8 @@ namespace sorth::internal
             auto array = interpreter->pop_as_array();
             auto new_size = interpreter->pop_as_size();
 
+            array->throw_if_frozen(interpreter);
+
             array->resize(new_size);
         }
 
@@ -101,6 +109,8 @@ namespace sorth::internal
             auto array_src = interpreter->pop_as_array();
             auto array_dest = interpreter->pop_as_array();
 
+            array_dest->throw_if_frozen(interpreter);
+
             auto orig_size = array_dest->size();
             auto new_size = orig_size + array_src->size();
 
@@ -130,6 +140,8 @@ namespace sorth::internal
             auto array = interpreter->pop_as_array();
             auto value = interpreter->pop();
 
+            array->throw_if_frozen(interpreter);
+
             array->push_front(value);
         }
 
@@ -138,6 +150,8 @@ namespace sorth::internal
             auto array = interpreter->pop_as_array();
             auto value = interpreter->pop();
 
+            array->throw_if_frozen(interpreter);
+
             array->push_back(value);
         }
 
@@ -145,6 +159,8 @@ namespace sorth::internal
         {
             auto array = interpreter->pop_as_array();
 
+            array->throw_if_frozen(interpreter);
+
             interpreter->push(array->pop_front(interpreter));
         }
 
@@ -152,10 +168,167 @@ namespace sorth::internal
         {
             auto array = interpreter->pop_as_array();
 
+            array->throw_if_frozen(interpreter);
+
             interpreter->push(array->pop_back(interpreter));
         }
 
 
+        // Call the word on a single item and get the value it leaves behind.
+        Value call_on_item(InterpreterPtr& interpreter, size_t word_index, const Value& item)
+        {
+            auto& handler = interpreter->get_handler_info(word_index);
+
+            interpreter->push(item);
+            handler.function(interpreter);
+
+            return interpreter->pop();
+        }
+
+
+        void word_array_map(InterpreterPtr& interpreter)
+        {
+            auto array = interpreter->pop_as_array();
+            auto word_index = interpreter->pop_as_size();
+            auto results = std::make_shared<Array>(array->size());
+
+            // Every chunk writes to it's own part of the new array.
+            task_run_chunks(interpreter,
+                           array->size(),
+                           [=](InterpreterPtr& worker, size_t start, size_t end)
+                           {
+                               for (auto i = start; i < end; ++i)
+                               {
+                                   (*results)[i] = call_on_item(worker, word_index, (*array)[i]);
+                               }
+
+                               return Value();
+                           });
+
+            interpreter->push(results);
+        }
+
+
+        void word_array_filter(InterpreterPtr& interpreter)
+        {
+            auto array = interpreter->pop_as_array();
+            auto word_index = interpreter->pop_as_size();
+
+            auto chunks = task_run_chunks(interpreter,
+                                         array->size(),
+                                         [=](InterpreterPtr& worker, size_t start, size_t end)
+                                         {
+                                             auto kept = std::make_shared<Array>(0);
+
+                                             for (auto i = start; i < end; ++i)
+                                             {
+                                                 auto& item = (*array)[i];
+
+                                                 if (call_on_item(worker, word_index, item))
+                                                 {
+                                                     kept->push_back(item);
+                                                 }
+                                             }
+
+                                             return Value(kept);
+                                         });
+
+            auto results = std::make_shared<Array>(0);
+
+            for (auto& chunk : chunks)
+            {
+                auto kept = chunk.as_array(interpreter);
+
+                for (size_t i = 0; i < kept->size(); ++i)
+                {
+                    results->push_back((*kept)[i]);
+                }
+            }
+
+            interpreter->push(results);
+        }
+
+
+        void word_array_reduce(InterpreterPtr& interpreter)
+        {
+            auto array = interpreter->pop_as_array();
+            auto word_index = interpreter->pop_as_size();
+            auto initial = interpreter->pop();
+
+            if (array->size() == 0)
+            {
+                interpreter->push(initial);
+                return;
+            }
+
+            auto combine = [word_index](InterpreterPtr& interpreter,
+                                        const Value& accumulator,
+                                        const Value& item)
+                {
+                    auto& handler = interpreter->get_handler_info(word_index);
+
+                    interpreter->push(accumulator);
+                    interpreter->push(item);
+                    handler.function(interpreter);
+
+                    return interpreter->pop();
+                };
+
+            // Each chunk is reduced starting from it's own first item, then the chunk's results
+            // are merged in order.  So the word has to be associative, but the initial value is
+            // only used once.
+            auto chunks = task_run_chunks(interpreter,
+                                         array->size(),
+                                         [=](InterpreterPtr& worker, size_t start, size_t end)
+                                         {
+                                             auto accumulator = (*array)[start];
+
+                                             for (auto i = start + 1; i < end; ++i)
+                                             {
+                                                 accumulator = combine(worker,
+                                                                       accumulator,
+                                                                       (*array)[i]);
+                                             }
+
+                                             return accumulator;
+                                         });
+
+            // The chunk results are merged on an interpreter of their own too, so none of the
+            // word's variable writes are kept.
+            auto merger = clone_interpreter(interpreter);
+            auto result = initial;
+
+            for (auto& chunk : chunks)
+            {
+                result = combine(merger, result, chunk);
+            }
+
+            interpreter->push(result);
+        }
+
+
+        void word_array_each(InterpreterPtr& interpreter)
+        {
+            auto array = interpreter->pop_as_array();
+            auto word_index = interpreter->pop_as_size();
+
+            task_run_chunks(interpreter,
+                           array->size(),
+                           [=](InterpreterPtr& worker, size_t start, size_t end)
+                           {
+                               auto& handler = worker->get_handler_info(word_index);
+
+                               for (auto i = start; i < end; ++i)
+                               {
+                                   worker->push((*array)[i]);
+                                   handler.function(worker);
+                               }
+
+                               return Value();
+                           });
+        }
+
+
     }
 
 
@@ -213,6 +386,26 @@ namespace sorth::internal
         ADD_NATIVE_WORD(interpreter, "[].pop_back!", word_pop_back,
             "Pop a value from the back of an array.",
             "array -- value");
+
+        ADD_NATIVE_WORD(interpreter, "[].map", word_array_map,
+            "Call the word on every item of the array and gather the results into a new array.  "
+            "The word runs on it's own interpreter, so it's variable writes aren't kept.",
+            "word-index array -- new-array");
+
+        ADD_NATIVE_WORD(interpreter, "[].filter", word_array_filter,
+            "Make a new array of the items that the word returns true for.  The word runs on it's "
+            "own interpreter, so it's variable writes aren't kept.",
+            "word-index array -- new-array");
+
+        ADD_NATIVE_WORD(interpreter, "[].reduce", word_array_reduce,
+            "Combine the items with an associative word ( accumulator item -- accumulator ).  "
+            "The word runs on it's own interpreter, so it's variable writes aren't kept.",
+            "initial word-index array -- result");
+
+        ADD_NATIVE_WORD(interpreter, "[].each", word_array_each,
+            "Call the word on every item in the array, the word should consume the item.  The "
+            "word runs on it's own interpreter, so it's variable writes aren't kept.",
+            "word-index array -- ");
     }
 
 
@@ -13,14 +13,15 @@ namespace sorth::internal
 
         void check_buffer_index(InterpreterPtr& interpreter,
                                 const ByteBufferPtr& buffer,
+                                size_t position,
                                 int64_t byte_size)
         {
-            if ((buffer->position() + byte_size) > buffer->size())
+            if ((position + byte_size) > buffer->size())
             {
                 std::stringstream stream;
 
-                stream << "Writing a value of size " << byte_size << " at a position of "
-                       << buffer->position() << " would exceed the buffer size, "
+                stream << "Accessing a value of size " << byte_size << " at a position of "
+                       << position << " would exceed the buffer size, "
                        << buffer->size() << ".";
 
                 throw_error(interpreter, stream.str());
@@ -28,6 +29,14 @@ namespace sorth::internal
         }
 
 
+        void check_buffer_index(InterpreterPtr& interpreter,
+                                const ByteBufferPtr& buffer,
+                                int64_t byte_size)
+        {
+            check_buffer_index(interpreter, buffer, buffer->position(), byte_size);
+        }
+
+
         void word_buffer_new(InterpreterPtr& interpreter)
         {
             auto size = interpreter->pop_as_size();
@@ -43,6 +52,7 @@ namespace sorth::internal
             auto buffer = interpreter->pop_as_byte_buffer();
             auto value = interpreter->pop_as_integer();
 
+            buffer->throw_if_frozen(interpreter);
             check_buffer_index(interpreter, buffer, byte_size);
             buffer->write_int(byte_size, value);
         }
@@ -54,6 +64,7 @@ namespace sorth::internal
             auto byte_size = interpreter->pop_as_size();
             auto buffer = interpreter->pop_as_byte_buffer();
 
+            buffer->throw_if_frozen(interpreter);
             check_buffer_index(interpreter, buffer, byte_size);
             interpreter->push(buffer->read_int(byte_size, is_signed));
         }
@@ -65,6 +76,7 @@ namespace sorth::internal
             auto buffer = interpreter->pop_as_byte_buffer();
             auto value = interpreter->pop_as_float();
 
+            buffer->throw_if_frozen(interpreter);
             check_buffer_index(interpreter, buffer, byte_size);
             buffer->write_float(byte_size, value);
         }
@@ -75,6 +87,7 @@ namespace sorth::internal
             auto byte_size = interpreter->pop_as_size();
             auto buffer = interpreter->pop_as_byte_buffer();
 
+            buffer->throw_if_frozen(interpreter);
             check_buffer_index(interpreter, buffer, byte_size);
             interpreter->push(buffer->read_float(byte_size));
         }
@@ -86,6 +99,7 @@ namespace sorth::internal
             auto buffer = interpreter->pop_as_byte_buffer();
             auto value = interpreter->pop_as_string();
 
+            buffer->throw_if_frozen(interpreter);
             check_buffer_index(interpreter, buffer, max_size);
             buffer->write_string(value, max_size);
         }
@@ -96,16 +110,52 @@ namespace sorth::internal
             auto max_size = interpreter->pop_as_size();
             auto buffer = interpreter->pop_as_byte_buffer();
 
+            buffer->throw_if_frozen(interpreter);
             check_buffer_index(interpreter, buffer, max_size);
             interpreter->push(buffer->read_string(max_size));
         }
 
 
+        void word_buffer_read_int_at(InterpreterPtr& interpreter)
+        {
+            auto is_signed = interpreter->pop_as_bool();
+            auto byte_size = interpreter->pop_as_size();
+            auto buffer = interpreter->pop_as_byte_buffer();
+            auto position = interpreter->pop_as_size();
+
+            check_buffer_index(interpreter, buffer, position, byte_size);
+            interpreter->push(buffer->read_int_at(position, byte_size, is_signed));
+        }
+
+
+        void word_buffer_read_float_at(InterpreterPtr& interpreter)
+        {
+            auto byte_size = interpreter->pop_as_size();
+            auto buffer = interpreter->pop_as_byte_buffer();
+            auto position = interpreter->pop_as_size();
+
+            check_buffer_index(interpreter, buffer, position, byte_size);
+            interpreter->push(buffer->read_float_at(position, byte_size));
+        }
+
+
+        void word_buffer_read_string_at(InterpreterPtr& interpreter)
+        {
+            auto max_size = interpreter->pop_as_size();
+            auto buffer = interpreter->pop_as_byte_buffer();
+            auto position = interpreter->pop_as_size();
+
+            check_buffer_index(interpreter, buffer, position, max_size);
+            interpreter->push(buffer->read_string_at(position, max_size));
+        }
+
+
         void word_buffer_set_position(InterpreterPtr& interpreter)
         {
             auto buffer = interpreter->pop_as_byte_buffer();
             auto new_position = interpreter->pop_as_size();
 
+            buffer->throw_if_frozen(interpreter);
             buffer->set_position(new_position);
         }
 
@@ -132,7 +182,7 @@ namespace sorth::internal
             "value buffer byte_size -- ");
 
         ADD_NATIVE_WORD(interpreter, "buffer.int@", word_buffer_read_int,
-            "Read an integer of a given size from the buffer.",
+            "Read an integer of a given size from the buffer, moving the buffer pointer.",
             "buffer byte_size is_signed -- value");
 
         ADD_NATIVE_WORD(interpreter, "buffer.float!", word_buffer_write_float,
@@ -140,7 +190,7 @@ namespace sorth::internal
             "value buffer byte_size -- ");
 
         ADD_NATIVE_WORD(interpreter, "buffer.float@", word_buffer_read_float,
-            "read a float of a given size from the buffer.",
+            "read a float of a given size from the buffer, moving the buffer pointer.",
             "buffer byte_size -- value");
 
         ADD_NATIVE_WORD(interpreter, "buffer.string!", word_buffer_write_string,
@@ -148,11 +198,23 @@ namespace sorth::internal
             "value buffer size -- ");
 
         ADD_NATIVE_WORD(interpreter, "buffer.string@", word_buffer_read_string,
-            "Read a string of a given max size from the buffer.",
+            "Read a string of a given max size from the buffer, moving the buffer pointer.",
             "buffer size -- value");
 
+        ADD_NATIVE_WORD(interpreter, "buffer.int-at@", word_buffer_read_int_at,
+            "Read an integer from a position in the buffer without moving the buffer pointer.",
+            "position buffer byte_size is_signed -- value");
+
+        ADD_NATIVE_WORD(interpreter, "buffer.float-at@", word_buffer_read_float_at,
+            "Read a float from a position in the buffer without moving the buffer pointer.",
+            "position buffer byte_size -- value");
+
+        ADD_NATIVE_WORD(interpreter, "buffer.string-at@", word_buffer_read_string_at,
+            "Read a string from a position in the buffer without moving the buffer pointer.",
+            "position buffer size -- value");
+
         ADD_NATIVE_WORD(interpreter, "buffer.position!", word_buffer_set_position,
-            "Set the position of the buffer pointer.",
+            "Set the position of the buffer pointer.  Frozen buffers can't be moved.",
             "position buffer -- ");
 
         ADD_NATIVE_WORD(interpreter, "buffer.position@", word_buffer_get_position,
@@ -0,0 +1,138 @@
+#include "sorth.h"
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        // Get the channels out of an array of them.
+        std::vector<ChannelPtr> pop_channels(InterpreterPtr& interpreter)
+        {
+            auto array = interpreter->pop_as_array();
+            std::vector<ChannelPtr> channels;
+
+            channels.reserve(array->size());
+
+            for (size_t i = 0; i < array->size(); ++i)
+            {
+                channels.push_back((*array)[i].as_channel(interpreter));
+            }
+
+            return channels;
+        }
+
+
+        void push_selection(InterpreterPtr& interpreter, const Channel::Selection& selection)
+        {
+            if (!selection)
+            {
+                interpreter->push(Value());
+                interpreter->push((int64_t)-1);
+
+                return;
+            }
+
+            auto& [ index, value ] = *selection;
+
+            interpreter->push(value);
+            interpreter->push(index);
+        }
+
+
+        void word_channel_new(InterpreterPtr& interpreter)
+        {
+            auto capacity = interpreter->pop_as_integer();
+
+            throw_error_if(capacity <= 0, interpreter, "Channel capacity must be positive.");
+
+            interpreter->push(std::make_shared<Channel>(capacity));
+        }
+
+
+        void word_channel_push(InterpreterPtr& interpreter)
+        {
+            auto channel = interpreter->pop().as_channel(interpreter);
+            auto value = interpreter->pop();
+
+            channel->push(value);
+        }
+
+
+        void word_channel_pop(InterpreterPtr& interpreter)
+        {
+            auto channel = interpreter->pop().as_channel(interpreter);
+
+            interpreter->push(channel->pop());
+        }
+
+
+        void word_channel_depth(InterpreterPtr& interpreter)
+        {
+            auto channel = interpreter->pop().as_channel(interpreter);
+
+            interpreter->push(channel->depth());
+        }
+
+
+        void word_channel_select(InterpreterPtr& interpreter)
+        {
+            auto channels = pop_channels(interpreter);
+
+            throw_error_if(channels.empty(),
+                           interpreter,
+                           "Can not select on an empty channel list.");
+
+            push_selection(interpreter, Channel::select(channels));
+        }
+
+
+        void word_channel_select_for(InterpreterPtr& interpreter)
+        {
+            auto milliseconds = interpreter->pop_as_integer();
+
+            throw_error_if(milliseconds < 0, interpreter, "Timeout can not be negative.");
+
+            auto channels = pop_channels(interpreter);
+            auto timeout = std::chrono::milliseconds(milliseconds);
+
+            push_selection(interpreter, Channel::select(channels, timeout));
+        }
+
+
+    }
+
+
+    void register_channel_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "channel.new", word_channel_new,
+            "Create a new channel that can hold up to the given number of values.",
+            "capacity -- channel");
+
+        ADD_NATIVE_WORD(interpreter, "channel.push", word_channel_push,
+            "Send a value to a channel, blocking while the channel is full.",
+            "value channel -- ");
+
+        ADD_NATIVE_WORD(interpreter, "channel.pop", word_channel_pop,
+            "Receive a value from a channel, blocking until one is available.",
+            "channel -- value");
+
+        ADD_NATIVE_WORD(interpreter, "channel.depth", word_channel_depth,
+            "How many values are waiting in the channel.",
+            "channel -- depth");
+
+        ADD_NATIVE_WORD(interpreter, "channel.select", word_channel_select,
+            "Receive a value from whichever channel in the array has one first.",
+            "channels -- value index");
+
+        ADD_NATIVE_WORD(interpreter, "channel.select-for", word_channel_select_for,
+            "Like channel.select, but give up after the milliseconds pass.  Index is -1 if so.",
+            "channels milliseconds -- value index");
+    }
+
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+
+
+namespace sorth::internal
+{
+
+
+    void register_channel_words(InterpreterPtr& interpreter);
+
+
+}
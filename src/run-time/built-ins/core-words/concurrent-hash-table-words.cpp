@@ -0,0 +1,213 @@
+#include "sorth.h"
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        ConcurrentHashTablePtr pop_table(InterpreterPtr& interpreter)
+        {
+            return interpreter->pop().as_concurrent_hash_table(interpreter);
+        }
+
+
+        void word_ctable_new(InterpreterPtr& interpreter)
+        {
+            interpreter->push(std::make_shared<ConcurrentHashTable>());
+        }
+
+
+        void word_ctable_insert(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+            auto value = interpreter->pop();
+
+            table->insert(key, value);
+        }
+
+
+        void word_ctable_find(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+
+            auto [ found, value ] = table->get(key);
+
+            if (!found)
+            {
+                std::stringstream stream;
+
+                stream << "Value, " << key << ", does not exist in the table.";
+
+                throw_error(interpreter, stream.str());
+            }
+
+            interpreter->push(value);
+        }
+
+
+        void word_ctable_exists(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+
+            auto [ found, value ] = table->get(key);
+
+            interpreter->push(found);
+        }
+
+
+        void word_ctable_remove(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+
+            interpreter->push(table->remove(key));
+        }
+
+
+        void word_ctable_get_or_insert(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+            auto value = interpreter->pop();
+
+            interpreter->push(table->get_or_insert(key, value));
+        }
+
+
+        void word_ctable_update(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+            auto word_index = interpreter->pop_as_size();
+
+            auto& handler = interpreter->get_handler_info(word_index);
+
+            // The word is run without holding any locks, so if another thread changes the value
+            // in the meantime we start over with the new value.
+            while (true)
+            {
+                auto [ found, current ] = table->get(key);
+
+                interpreter->push(current);
+                handler.function(interpreter);
+
+                auto updated = interpreter->pop();
+                auto expected = found ? std::optional<Value>(current) : std::nullopt;
+
+                if (table->compare_exchange(key, expected, updated))
+                {
+                    interpreter->push(updated);
+                    break;
+                }
+            }
+        }
+
+
+        void word_ctable_add(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto key = interpreter->pop();
+            auto amount = interpreter->pop();
+
+            throw_error_if(!amount.is_numeric(), interpreter, "Expected a numeric amount to add.");
+
+            interpreter->push(table->add(interpreter, key, amount));
+        }
+
+
+        void word_ctable_size(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+
+            interpreter->push(table->size());
+        }
+
+
+        void word_ctable_snapshot(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+
+            interpreter->push(table->snapshot());
+        }
+
+
+        void word_ctable_iterate(InterpreterPtr& interpreter)
+        {
+            auto table = pop_table(interpreter);
+            auto word_index = interpreter->pop_as_size();
+
+            auto& handler = interpreter->get_handler_info(word_index);
+
+            // Iterate over a copy, so that the word is free to change the table as it goes.
+            auto items = table->snapshot();
+
+            for (const auto& item : items->get_items())
+            {
+                interpreter->push(item.first);
+                interpreter->push(item.second);
+
+                handler.function(interpreter);
+            }
+        }
+
+
+    }
+
+
+    void register_concurrent_hash_table_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "ctable.new", word_ctable_new,
+            "Create a new hash table that can be shared between threads.",
+            " -- new_table");
+
+        ADD_NATIVE_WORD(interpreter, "ctable!", word_ctable_insert,
+            "Write a value to a given key in the table.",
+            "value key table -- ");
+
+        ADD_NATIVE_WORD(interpreter, "ctable@", word_ctable_find,
+            "Read a value from a given key in the table.",
+            "key table -- value");
+
+        ADD_NATIVE_WORD(interpreter, "ctable?", word_ctable_exists,
+            "Check if a given key exists in the table.",
+            "key table -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.remove", word_ctable_remove,
+            "Remove a key from the table, returning true if it was there.",
+            "key table -- was-removed");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.get-or-insert", word_ctable_get_or_insert,
+            "Get the key's value, first inserting the given value if the key isn't there.",
+            "value key table -- value");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.update", word_ctable_update,
+            "Atomically replace a value with the result of ( old -- new ), may run more than once.",
+            "word_index key table -- new_value");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.add", word_ctable_add,
+            "Atomically add to the key's numeric value, a missing key counts as zero.",
+            "amount key table -- new_value");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.size@", word_ctable_size,
+            "Get the number of items in the table.",
+            "table -- size");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.snapshot", word_ctable_snapshot,
+            "Copy the table's current contents into a regular hash table.",
+            "table -- hash_table");
+
+        ADD_NATIVE_WORD(interpreter, "ctable.iterate", word_ctable_iterate,
+            "Iterate through a copy of the table and call a word for each item.",
+            "word_index table -- ");
+    }
+
+
+}
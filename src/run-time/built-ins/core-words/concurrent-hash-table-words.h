@@ -0,0 +1,12 @@
+#pragma once
+
+
+
+namespace sorth::internal
+{
+
+
+    void register_concurrent_hash_table_words(InterpreterPtr& interpreter);
+
+
+}
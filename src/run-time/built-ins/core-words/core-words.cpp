@@ -8,12 +8,18 @@
 #include "array-words.h"
 #include "byte-buffer-words.h"
 #include "byte-code-words.h"
+#include "channel-words.h"
+#include "concurrent-hash-table-words.h"
+#include "coroutine-words.h"
+#include "future-words.h"
 #include "hash-table-words.h"
 #include "interpreter-words.h"
+#include "jit-words.h"
 #include "math-logic-words.h"
 #include "stack-words.h"
 #include "string-words.h"
 #include "structure-words.h"
+#include "task-words.h"
 #include "token-words.h"
 #include "value-type-words.h"
 #include "word-creation-words.h"
@@ -34,17 +40,26 @@ namespace sorth
         register_array_words(interpreter);
         register_buffer_words(interpreter);
         register_bytecode_words(interpreter);
+        register_channel_words(interpreter);
+        register_concurrent_hash_table_words(interpreter);
+        register_coroutine_words(interpreter);
+        register_future_words(interpreter);
         register_hash_table_words(interpreter);
         register_interpreter_words(interpreter);
         register_math_logic_words(interpreter);
         register_stack_words(interpreter);
         register_string_words(interpreter);
         register_structure_words(interpreter);
+        register_task_words(interpreter);
         register_token_words(interpreter);
         register_value_type_words(interpreter);
         register_word_creation_words(interpreter);
         register_word_words(interpreter);
 
+        #if (SORTH_LLVM_FOUND == 1)
+            register_jit_words(interpreter);
+        #endif
+
         register_word_info_struct(LOCATION_HERE(), interpreter);
 
 
@@ -58,9 +73,9 @@ namespace sorth
     {
         sorth::ArrayPtr array = std::make_shared<sorth::Array>(argc - args);
 
-        for (int i = args; i < argc - args; ++i)
+        for (int i = args; i < argc; ++i)
         {
-            (*array)[i] = std::string(argv[i + 2]);
+            (*array)[i - args] = std::string(argv[i]);
         }
 
         ADD_NATIVE_WORD(interpreter, "sorth.args",
@@ -0,0 +1,96 @@
+#include "sorth.h"
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        void word_coroutine_new(InterpreterPtr& interpreter)
+        {
+            auto name = interpreter->pop_as_string();
+            auto input = interpreter->pop();
+            auto [ found, word ] = interpreter->find_word(name);
+
+            if (!found)
+            {
+                throw_error(interpreter, "Could not start coroutine, word " + name + " not found.");
+            }
+
+            interpreter->push(coroutine_spawn(interpreter, word, input));
+        }
+
+
+        void word_yield(InterpreterPtr&)
+        {
+            coroutine_yield();
+        }
+
+
+        void word_await(InterpreterPtr& interpreter)
+        {
+            auto future = interpreter->pop().as_future(interpreter);
+
+            interpreter->push(coroutine_await(interpreter, future));
+        }
+
+
+        void word_coroutine_budget(InterpreterPtr& interpreter)
+        {
+            auto instructions = interpreter->pop_as_integer();
+
+            throw_error_if(instructions < 0, interpreter,
+                           "Instruction budget can not be negative.");
+
+            coroutine_set_budget(static_cast<size_t>(instructions));
+        }
+
+
+        void word_coroutine_count(InterpreterPtr& interpreter)
+        {
+            interpreter->push(coroutine_count());
+        }
+
+
+        void word_coroutine_is_running(InterpreterPtr& interpreter)
+        {
+            interpreter->push(coroutine_is_running());
+        }
+
+
+    }
+
+
+    void register_coroutine_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "coroutine.new", word_coroutine_new,
+            "Run the named word as a coroutine on this thread and return it's future.",
+            "input word-name -- future");
+
+        ADD_NATIVE_WORD(interpreter, "yield", word_yield,
+            "Let the other coroutines on this thread run for a while.",
+            " -- ");
+
+        ADD_NATIVE_WORD(interpreter, "await", word_await,
+            "Wait for a future, letting this thread's coroutines run in the meantime.",
+            "future -- result");
+
+        ADD_NATIVE_WORD(interpreter, "coroutine.budget!", word_coroutine_budget,
+            "Preempt coroutines started from now on after this many instructions, 0 for never.",
+            "instructions -- ");
+
+        ADD_NATIVE_WORD(interpreter, "coroutine.count", word_coroutine_count,
+            "How many of this thread's coroutines haven't finished yet.",
+            " -- count");
+
+        ADD_NATIVE_WORD(interpreter, "coroutine.running?", word_coroutine_is_running,
+            "Is the calling code running inside of a coroutine?",
+            " -- bool");
+    }
+
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+
+
+namespace sorth::internal
+{
+
+
+    void register_coroutine_words(InterpreterPtr& interpreter);
+
+
+}
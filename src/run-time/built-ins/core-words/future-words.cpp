@@ -0,0 +1,149 @@
+#include "sorth.h"
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        // Get the futures out of an array of them.
+        std::vector<FuturePtr> pop_futures(InterpreterPtr& interpreter)
+        {
+            auto array = interpreter->pop_as_array();
+            std::vector<FuturePtr> futures;
+
+            futures.reserve(array->size());
+
+            for (size_t i = 0; i < array->size(); ++i)
+            {
+                futures.push_back((*array)[i].as_future(interpreter));
+            }
+
+            return futures;
+        }
+
+
+        std::chrono::milliseconds pop_timeout(InterpreterPtr& interpreter)
+        {
+            auto milliseconds = interpreter->pop_as_integer();
+
+            throw_error_if(milliseconds < 0, interpreter, "Timeout can not be negative.");
+
+            return std::chrono::milliseconds(milliseconds);
+        }
+
+
+        void word_future_wait(InterpreterPtr& interpreter)
+        {
+            auto future = interpreter->pop().as_future(interpreter);
+
+            interpreter->push(task_wait(future));
+        }
+
+
+        void word_future_wait_for(InterpreterPtr& interpreter)
+        {
+            auto timeout = pop_timeout(interpreter);
+            auto future = interpreter->pop().as_future(interpreter);
+
+            interpreter->push(task_wait_for(future, timeout));
+        }
+
+
+        void word_future_wait_all(InterpreterPtr& interpreter)
+        {
+            auto futures = pop_futures(interpreter);
+            auto results = std::make_shared<Array>(futures.size());
+
+            std::optional<std::string> error;
+
+            // Wait for all of the futures before reporting an error, so that nothing is still
+            // running when we do.
+            for (size_t i = 0; i < futures.size(); ++i)
+            {
+                try
+                {
+                    (*results)[i] = task_wait(futures[i]);
+                }
+                catch (const std::exception& e)
+                {
+                    if (!error)
+                    {
+                        error = e.what();
+                    }
+                }
+            }
+
+            if (error)
+            {
+                throw_error(*error);
+            }
+
+            interpreter->push(results);
+        }
+
+
+        void word_future_wait_any(InterpreterPtr& interpreter)
+        {
+            auto futures = pop_futures(interpreter);
+
+            throw_error_if(futures.empty(), interpreter, "Can not wait on an empty future list.");
+
+            interpreter->push(task_wait_any(futures).value());
+        }
+
+
+        void word_future_wait_any_for(InterpreterPtr& interpreter)
+        {
+            auto timeout = pop_timeout(interpreter);
+            auto futures = pop_futures(interpreter);
+            auto index = task_wait_any(futures, timeout);
+
+            interpreter->push(index ? static_cast<int64_t>(*index) : -1);
+        }
+
+
+        void word_future_is_ready(InterpreterPtr& interpreter)
+        {
+            auto future = interpreter->pop().as_future(interpreter);
+
+            interpreter->push(future->is_ready());
+        }
+
+
+    }
+
+
+    void register_future_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "future.wait", word_future_wait,
+            "Wait for a future to complete and get it's value.  If it's word failed, so does this.",
+            "future -- result");
+
+        ADD_NATIVE_WORD(interpreter, "future.wait-for", word_future_wait_for,
+            "Wait up to the given number of milliseconds for a future to complete.",
+            "future milliseconds -- completed?");
+
+        ADD_NATIVE_WORD(interpreter, "future.wait-all", word_future_wait_all,
+            "Wait for all of the futures in an array and get an array of their results.",
+            "futures -- results");
+
+        ADD_NATIVE_WORD(interpreter, "future.wait-any", word_future_wait_any,
+            "Wait for any one of the futures in an array to complete and get it's index.",
+            "futures -- index");
+
+        ADD_NATIVE_WORD(interpreter, "future.wait-any-for", word_future_wait_any_for,
+            "Wait up to the given milliseconds for any of the futures, -1 if none completed.",
+            "futures milliseconds -- index");
+
+        ADD_NATIVE_WORD(interpreter, "future.ready?", word_future_is_ready,
+            "Has the future completed yet?",
+            "future -- bool");
+    }
+
+
+}
@@ -24,6 +24,7 @@ namespace sorth::internal
             auto key = interpreter->pop();
             auto value = interpreter->pop();
 
+            table->throw_if_frozen(interpreter);
             table->insert(key, value);
         }
 
@@ -64,6 +65,8 @@ namespace sorth::internal
             auto hash_src = interpreter->pop_as_hash_table();
             auto hash_dest = interpreter->pop_as_hash_table();
 
+            hash_dest->throw_if_frozen(interpreter);
+
             for (auto entry : hash_src->get_items())
             {
                 auto key = entry.first;
@@ -102,9 +102,9 @@ namespace sorth::internal
                 std::cout << "Thread " << item.word_thread->get_id()
                         << " word " << info.name << ", (" << item.word.handler_index << "), "
 
-                        << "I/O queues (" << item.inputs.depth() << "/"
-                                            << item.outputs.depth() << ")"
-                        << (item.thead_deleted ? " has completed." : " is running.")
+                        << "I/O queues (" << item.handle->inputs->depth() << "/"
+                                            << item.handle->outputs->depth() << ")"
+                        << (item.handle->result->is_ready() ? " has completed." : " is running.")
                         << std::endl;
             }
         }
@@ -120,26 +120,49 @@ namespace sorth::internal
                 throw_error(interpreter, "Could not start thread, word " + name + " not found.");
             }
 
-            auto id = interpreter->execute_word_threaded(word);
-            interpreter->push(id);
+            auto handle = interpreter->execute_word_threaded(word);
+            interpreter->push(handle);
         }
 
 
+        void word_thread_async(InterpreterPtr& interpreter)
+        {
+            auto name = interpreter->pop_as_string();
+            auto [ found, word ] = interpreter->find_word(name);
+
+            if (!found)
+            {
+                throw_error(interpreter, "Could not start thread, word " + name + " not found.");
+            }
+
+            interpreter->push(interpreter->execute_word_async(word));
+        }
+
+
+        // The handle leads straight to the thread's queues, so these don't need to go through
+        // the interpreter's thread list.
         void word_thread_push_to(InterpreterPtr& interpreter)
         {
-            auto id = interpreter->pop_as_thread_id();
+            auto handle = interpreter->pop().as_thread_handle(interpreter);
             auto value = interpreter->pop();
 
-            interpreter->thread_push_input(id, value);
+            handle->inputs->push(value);
         }
 
 
         void word_thread_pop_from(InterpreterPtr& interpreter)
         {
-            auto id = interpreter->pop_as_thread_id();
-            auto value = interpreter->thread_pop_output(id);
+            auto handle = interpreter->pop().as_thread_handle(interpreter);
+
+            interpreter->push(handle->outputs->pop());
+        }
+
+
+        void word_thread_result(InterpreterPtr& interpreter)
+        {
+            auto handle = interpreter->pop().as_thread_handle(interpreter);
 
-            interpreter->push(value);
+            interpreter->push(handle->result);
         }
 
 
@@ -160,6 +183,45 @@ namespace sorth::internal
         }
 
 
+        void word_thread_push_many(InterpreterPtr& interpreter)
+        {
+            auto count = interpreter->pop_as_integer();
+
+            throw_error_if(   (count < 0)
+                           || (count > interpreter->depth()),
+                           interpreter,
+                           "Bad value count for thread.push-many.");
+
+            // Keep the values in the order they were on the stack, the deepest is pushed first.
+            std::vector<Value> values(count);
+
+            for (auto i = count - 1; i >= 0; --i)
+            {
+                values[i] = interpreter->pop();
+            }
+
+            auto id = std::this_thread::get_id();
+
+            interpreter->thread_push_outputs(id, values);
+        }
+
+
+        void word_thread_pop_many(InterpreterPtr& interpreter)
+        {
+            auto count = interpreter->pop_as_integer();
+
+            throw_error_if(count < 0, interpreter, "Bad value count for thread.pop-many.");
+
+            auto id = std::this_thread::get_id();
+            auto values = interpreter->thread_pop_inputs(id, count);
+
+            for (auto& value : values)
+            {
+                interpreter->push(value);
+            }
+        }
+
+
         void word_throw(InterpreterPtr& interpreter)
         {
             throw_error(interpreter, interpreter->pop_as_string());
@@ -429,16 +491,24 @@ namespace sorth::internal
             " -- ");
 
         ADD_NATIVE_WORD(interpreter, "thread.new", word_thread_new,
-            "Create a new thread and run the specified word and return the new thread id.",
-            "word-index -- thread-id");
+            "Create a new thread and run the specified word and return the new thread's handle.",
+            "word-index -- thread");
+
+        ADD_NATIVE_WORD(interpreter, "thread.async", word_thread_async,
+            "Create a new thread to run the word and return a future for the value it returns.",
+            "word-name -- future");
 
         ADD_NATIVE_WORD(interpreter, "thread.push-to", word_thread_push_to,
             "Push the top value to another thread's input stack.",
-            "value thread-id -- ");
+            "value thread -- ");
 
         ADD_NATIVE_WORD(interpreter, "thread.pop-from", word_thread_pop_from,
             "Pop a value off of the threads input queue, block if there's nothing available.",
-            "thread-id -- input-value");
+            "thread -- input-value");
+
+        ADD_NATIVE_WORD(interpreter, "thread.result", word_thread_result,
+            "Get the future for the value the thread's word returns.",
+            "thread -- future");
 
         ADD_NATIVE_WORD(interpreter, "thread.push", word_thread_push,
             "Push the top value onto the thread's output queue.",
@@ -448,6 +518,14 @@ namespace sorth::internal
             "Pop from another thread's output stack and push onto the local data stack.",
             " -- value");
 
+        ADD_NATIVE_WORD(interpreter, "thread.push-many", word_thread_push_many,
+            "Push count values onto the thread's output queue, the deepest value first.",
+            "values... count -- ");
+
+        ADD_NATIVE_WORD(interpreter, "thread.pop-many", word_thread_pop_many,
+            "Pop count values from the thread's input queue, blocking until they're available.",
+            "count -- values...");
+
         ADD_NATIVE_WORD(interpreter, "throw", word_throw,
             "Throw an exception with the given message.",
             "message -- ");
@@ -468,15 +546,15 @@ namespace sorth::internal
             "Set the exit code for the interpreter.",
             "exit-code -- ");
 
-        ADD_NATIVE_WORD(interpreter, "none", word_none,
+        ADD_NATIVE_NO_THROW_WORD(interpreter, "none", word_none,
             "Push the value none onto the data stack.",
             " -- none");
 
-        ADD_NATIVE_WORD(interpreter, "true", word_true,
+        ADD_NATIVE_NO_THROW_WORD(interpreter, "true", word_true,
             "Push the value true onto the data stack.",
             " -- true");
 
-        ADD_NATIVE_WORD(interpreter, "false", word_false,
+        ADD_NATIVE_NO_THROW_WORD(interpreter, "false", word_false,
             "Push the value false onto the data stack.",
             " -- false");
 
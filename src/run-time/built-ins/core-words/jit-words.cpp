@@ -0,0 +1,304 @@
+#include "sorth.h"
+
+#include <iomanip>
+
+#include "jit-words.h"
+
+
+
+#if (SORTH_LLVM_FOUND == 1)
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        int64_t pop_opt_level(InterpreterPtr& interpreter)
+        {
+            auto level = interpreter->pop_as_integer();
+
+            if ((level < 0) || (level > 3))
+            {
+                throw_error(interpreter, "JIT optimization level must be from 0 to 3.");
+            }
+
+            return level;
+        }
+
+
+        void print_time(const std::string& label, std::chrono::nanoseconds time)
+        {
+            std::chrono::duration<double, std::milli> milliseconds = time;
+
+            std::cout << std::left << std::setw(24) << label
+                      << std::right << std::fixed << std::setprecision(3)
+                      << milliseconds.count() << " ms" << std::endl;
+        }
+
+
+        void word_jit_opt_level_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().opt_level);
+        }
+
+
+        void word_jit_opt_level_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+
+            settings.opt_level = pop_opt_level(interpreter);
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_immediate_opt_level_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().immediate_opt_level);
+        }
+
+
+        void word_jit_immediate_opt_level_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+
+            settings.immediate_opt_level = pop_opt_level(interpreter);
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_passes_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().passes);
+        }
+
+
+        void word_jit_passes_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+
+            settings.passes = interpreter->pop_as_string();
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_promote_locals_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().promote_locals);
+        }
+
+
+        void word_jit_promote_locals_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+
+            settings.promote_locals = interpreter->pop_as_bool();
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_immediate_threshold_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().immediate_threshold);
+        }
+
+
+        void word_jit_immediate_threshold_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+            auto count = interpreter->pop_as_integer();
+
+            if (count < 0)
+            {
+                throw_error(interpreter, "JIT immediate word threshold must be 0 or more.");
+            }
+
+            settings.immediate_threshold = count;
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_threads_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().compile_threads);
+        }
+
+
+        void word_jit_threads_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+            auto count = interpreter->pop_as_integer();
+
+            if (count < 0)
+            {
+                throw_error(interpreter, "JIT compile thread count must be 0 or more.");
+            }
+
+            settings.compile_threads = count;
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_lazy_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().lazy_words);
+        }
+
+
+        void word_jit_lazy_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+
+            settings.lazy_words = interpreter->pop_as_bool();
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_debug_read(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().capture_code);
+        }
+
+
+        void word_jit_debug_write(InterpreterPtr& interpreter)
+        {
+            auto settings = get_jit_settings();
+
+            settings.capture_code = interpreter->pop_as_bool();
+            set_jit_settings(settings);
+        }
+
+
+        void word_jit_is_host_cpu(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().use_host_cpu);
+        }
+
+
+        void word_jit_is_perf_enabled(InterpreterPtr& interpreter)
+        {
+            interpreter->push(get_jit_settings().perf_map);
+        }
+
+
+        void word_jit_stats(InterpreterPtr& interpreter)
+        {
+            auto stats = get_jit_stats();
+
+            std::cout << std::left << std::setw(24) << "Modules compiled:"
+                      << stats.modules << std::endl
+                      << std::left << std::setw(24) << "Functions compiled:"
+                      << stats.functions << std::endl
+                      << std::left << std::setw(24) << "Words deferred:"
+                      << stats.deferred_words << std::endl;
+
+            print_time("IR generation time:", stats.ir_generation_time);
+            print_time("Optimization time:", stats.optimization_time);
+            print_time("Code generation time:", stats.code_generation_time);
+        }
+
+
+        void word_jit_reset_stats(InterpreterPtr& interpreter)
+        {
+            reset_jit_stats();
+        }
+
+
+    }
+
+
+    void register_jit_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.opt-level@", word_jit_opt_level_read,
+            "Get the optimization level, 0 to 3, used for JIT compiled scripts.",
+            " -- level");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.opt-level!", word_jit_opt_level_write,
+            "Set the optimization level, 0 to 3, used for JIT compiled scripts.",
+            "level -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.immediate-opt-level@",
+            word_jit_immediate_opt_level_read,
+            "Get the optimization level, 0 to 3, used for JIT compiled immediate words.",
+            " -- level");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.immediate-opt-level!",
+            word_jit_immediate_opt_level_write,
+            "Set the optimization level, 0 to 3, used for JIT compiled immediate words.",
+            "level -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.immediate-threshold@",
+            word_jit_immediate_threshold_read,
+            "Get how many calls an immediate word is interpreted for before it's JIT compiled.",
+            " -- count");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.immediate-threshold!",
+            word_jit_immediate_threshold_write,
+            "Set how many calls an immediate word is interpreted for before it's JIT compiled.",
+            "count -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.passes@", word_jit_passes_read,
+            "Get the custom LLVM pass pipeline used for scripts, empty if using the default.",
+            " -- passes");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.passes!", word_jit_passes_write,
+            "Set a custom LLVM pass pipeline for scripts, an empty string restores the default.",
+            "passes -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.promote-locals@", word_jit_promote_locals_read,
+            "Are word local variables that never escape their word kept out of the interpreter?",
+            " -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.promote-locals!", word_jit_promote_locals_write,
+            "Enable or disable keeping non-escaping word local variables out of the interpreter.",
+            "bool -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.threads@", word_jit_threads_read,
+            "Get the most threads used to compile a script, 0 means one per CPU core.",
+            " -- count");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.threads!", word_jit_threads_write,
+            "Set the most threads used to compile a script, 0 means one per CPU core.",
+            "count -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.lazy@", word_jit_lazy_read,
+            "Are a script's words JIT compiled on their first call instead of at load time?",
+            " -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.lazy!", word_jit_lazy_write,
+            "Enable or disable JIT compiling a script's words on their first call.",
+            "bool -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.debug@", word_jit_debug_read,
+            "Is the IR and machine code of newly JITed words being kept for sorth.show-ir/asm?",
+            " -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.debug!", word_jit_debug_write,
+            "Enable or disable keeping the IR and machine code of newly JITed words.",
+            "bool -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.host-cpu?", word_jit_is_host_cpu,
+            "Is the JIT generating code for the host CPU instead of a generic one?",
+            " -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.perf?", word_jit_is_perf_enabled,
+            "Is JITed code being reported to the Linux perf profiling tools?",
+            " -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.stats", word_jit_stats,
+            "Print out how much work the JIT engine has done so far.",
+            " -- ");
+
+        ADD_NATIVE_WORD(interpreter, "sorth.jit.reset-stats", word_jit_reset_stats,
+            "Clear the JIT engine's compile statistics.",
+            " -- ");
+    }
+
+
+}
+
+
+#endif
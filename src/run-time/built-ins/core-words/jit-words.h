@@ -0,0 +1,18 @@
+#pragma once
+
+
+
+#if (SORTH_LLVM_FOUND == 1)
+
+
+namespace sorth::internal
+{
+
+
+    void register_jit_words(InterpreterPtr& interpreter);
+
+
+}
+
+
+#endif
@@ -238,23 +238,23 @@ namespace sorth::internal
     void register_math_logic_words(InterpreterPtr& interpreter)
     {
         // Math ops.
-        ADD_NATIVE_WORD(interpreter, "+", word_add,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "+", word_add, WordIntrinsic::add,
             "Add 2 numbers or strings together.",
             "a b -- result");
 
-        ADD_NATIVE_WORD(interpreter, "-", word_subtract,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "-", word_subtract, WordIntrinsic::subtract,
             "Subtract 2 numbers.",
             "a b -- result");
 
-        ADD_NATIVE_WORD(interpreter, "*", word_multiply,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "*", word_multiply, WordIntrinsic::multiply,
             "Multiply 2 numbers.",
             "a b -- result");
 
-        ADD_NATIVE_WORD(interpreter, "/", word_divide,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "/", word_divide, WordIntrinsic::divide,
             "Divide 2 numbers.",
             "a b -- result");
 
-        ADD_NATIVE_WORD(interpreter, "%", word_mod,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "%", word_mod, WordIntrinsic::mod,
             "Mod 2 numbers.",
             "a b -- result");
 
@@ -268,21 +268,21 @@ namespace sorth::internal
             "Logically compare 2 values.",
             "a b -- bool");
 
-        ADD_NATIVE_WORD(interpreter, "'", word_logic_not,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "'", word_logic_not, WordIntrinsic::logic_not,
             "Logically invert a boolean value.",
             "bool -- bool");
 
 
         // Bitwise operator words.
-        ADD_NATIVE_WORD(interpreter, "&", word_bit_and,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "&", word_bit_and, WordIntrinsic::bit_and,
             "Bitwise AND two numbers together.",
             "a b -- result");
 
-        ADD_NATIVE_WORD(interpreter, "|", word_bit_or,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "|", word_bit_or, WordIntrinsic::bit_or,
             "Bitwise OR two numbers together.",
             "a b -- result");
 
-        ADD_NATIVE_WORD(interpreter, "^", word_bit_xor,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "^", word_bit_xor, WordIntrinsic::bit_xor,
             "Bitwise XOR two numbers together.",
             "a b -- result");
 
@@ -300,23 +300,24 @@ namespace sorth::internal
 
 
         // Equality words.
-        ADD_NATIVE_WORD(interpreter, "=", word_equal,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "=", word_equal, WordIntrinsic::equal,
             "Are 2 values equal?",
             "a b -- bool");
 
-        ADD_NATIVE_WORD(interpreter, ">=", word_greater_equal,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, ">=", word_greater_equal,
+            WordIntrinsic::greater_equal,
             "Is one value greater or equal to another?",
             "a b -- bool");
 
-        ADD_NATIVE_WORD(interpreter, "<=", word_less_equal,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "<=", word_less_equal, WordIntrinsic::less_equal,
             "Is one value less than or equal to another?",
             "a b -- bool");
 
-        ADD_NATIVE_WORD(interpreter, ">", word_greater,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, ">", word_greater, WordIntrinsic::greater,
             "Is one value greater than another?",
             "a b -- bool");
 
-        ADD_NATIVE_WORD(interpreter, "<", word_less,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "<", word_less, WordIntrinsic::less,
             "Is one value less than another?",
             "a b -- bool");
     }
@@ -91,31 +91,31 @@ namespace sorth::internal
 
     void register_stack_words(InterpreterPtr& interpreter)
     {
-        ADD_NATIVE_WORD(interpreter, "dup", word_dup,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "dup", word_dup, WordIntrinsic::dup,
             "Duplicate the top value on the data stack.",
             "value -- value value");
 
-        ADD_NATIVE_WORD(interpreter, "drop", word_drop,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "drop", word_drop, WordIntrinsic::drop,
             "Discard the top value on the data stack.",
             "value -- ");
 
-        ADD_NATIVE_WORD(interpreter, "swap", word_swap,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "swap", word_swap, WordIntrinsic::swap,
             "Swap the top 2 values on the data stack.",
             "a b -- b a");
 
-        ADD_NATIVE_WORD(interpreter, "over", word_over,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "over", word_over, WordIntrinsic::over,
             "Make a copy of the top value and place the copy under the second.",
             "a b -- b a b");
 
-        ADD_NATIVE_WORD(interpreter, "rot", word_rot,
+        ADD_NATIVE_INTRINSIC_WORD(interpreter, "rot", word_rot, WordIntrinsic::rot,
             "Rotate the top 3 values on the stack.",
             "a b c -- c a b");
 
-        ADD_NATIVE_WORD(interpreter, "stack.depth", word_stack_depth,
+        ADD_NATIVE_NO_THROW_WORD(interpreter, "stack.depth", word_stack_depth,
             "Get the current depth of the stack.",
             " -- depth");
 
-        ADD_NATIVE_WORD(interpreter, "stack.max-depth", word_max_stack_depth,
+        ADD_NATIVE_NO_THROW_WORD(interpreter, "stack.max-depth", word_max_stack_depth,
             "Get the maximum depth of the stack.",
             " -- depth");
 
@@ -58,6 +58,7 @@ namespace sorth::internal
             auto object = interpreter->pop_as_structure();
             auto field_index = interpreter->pop_as_size();
 
+            object->throw_if_frozen(interpreter);
             object->fields[field_index] = interpreter->pop();
         }
 
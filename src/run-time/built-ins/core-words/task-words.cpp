@@ -0,0 +1,221 @@
+#include "sorth.h"
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        void word_task_spawn(InterpreterPtr& interpreter)
+        {
+            auto name = interpreter->pop_as_string();
+            auto input = interpreter->pop();
+            auto [ found, word ] = interpreter->find_word(name);
+
+            if (!found)
+            {
+                throw_error(interpreter, "Could not spawn task, word " + name + " not found.");
+            }
+
+            interpreter->push(task_spawn(interpreter, word, input));
+        }
+
+
+        void word_task_wait(InterpreterPtr& interpreter)
+        {
+            auto future = interpreter->pop().as_future(interpreter);
+
+            interpreter->push(task_wait(future));
+        }
+
+
+        void word_task_workers(InterpreterPtr& interpreter)
+        {
+            interpreter->push(task_worker_count());
+        }
+
+
+        // The body of a parallel loop is either a word's index or a block of byte code compiled by
+        // pdo.
+        struct LoopBody
+        {
+            std::optional<ByteCode> code;
+            size_t word_index;
+        };
+
+
+        LoopBody pop_loop_body(InterpreterPtr& interpreter)
+        {
+            auto body = interpreter->pop();
+
+            if (body.is_byte_code())
+            {
+                return { .code = body.as_byte_code(interpreter), .word_index = 0 };
+            }
+
+            return { .code = std::nullopt, .word_index = (size_t)body.as_integer(interpreter) };
+        }
+
+
+        // Run the loop body, giving it the loop index on the stack.
+        void call_loop_body(InterpreterPtr& interpreter, const LoopBody& body, int64_t index)
+        {
+            interpreter->push(index);
+
+            if (body.code)
+            {
+                interpreter->execute_code("pdo", *body.code);
+            }
+            else
+            {
+                auto& handler = interpreter->get_handler_info(body.word_index);
+                handler.function(interpreter);
+            }
+        }
+
+
+        // Pop the loop range and get the number of iterations it covers.
+        std::tuple<int64_t, size_t> pop_loop_range(InterpreterPtr& interpreter)
+        {
+            auto end = interpreter->pop_as_integer();
+            auto start = interpreter->pop_as_integer();
+
+            return { start, end > start ? end - start : 0 };
+        }
+
+
+        void word_parallel_for(InterpreterPtr& interpreter)
+        {
+            auto body = pop_loop_body(interpreter);
+            auto [ start, count ] = pop_loop_range(interpreter);
+
+            task_run_chunks(interpreter,
+                            count,
+                            [=](InterpreterPtr& worker, size_t first, size_t last)
+                            {
+                                // Any variables defined by the loop body only last as long as
+                                // the chunk.
+                                worker->mark_context();
+
+                                try
+                                {
+                                    for (auto i = first; i < last; ++i)
+                                    {
+                                        call_loop_body(worker, body, start + i);
+                                    }
+                                }
+                                catch (...)
+                                {
+                                    worker->release_context();
+                                    throw;
+                                }
+
+                                worker->release_context();
+
+                                return Value();
+                            });
+        }
+
+
+        void word_parallel_reduce(InterpreterPtr& interpreter)
+        {
+            auto merge_index = interpreter->pop_as_size();
+            auto body = pop_loop_body(interpreter);
+            auto [ start, count ] = pop_loop_range(interpreter);
+            auto initial = interpreter->pop();
+
+            auto merge = [merge_index](InterpreterPtr& interpreter, const Value& a, const Value& b)
+                {
+                    auto& handler = interpreter->get_handler_info(merge_index);
+
+                    interpreter->push(a);
+                    interpreter->push(b);
+                    handler.function(interpreter);
+
+                    return interpreter->pop();
+                };
+
+            if (count == 0)
+            {
+                interpreter->push(initial);
+                return;
+            }
+
+            // Each chunk merges the values of it's own iterations, then the chunk's results are
+            // merged into the initial value in order.  So the merge word has to be associative.
+            auto chunks = task_run_chunks(interpreter,
+                                          count,
+                                          [=](InterpreterPtr& worker, size_t first, size_t last)
+                                          {
+                                              worker->mark_context();
+
+                                              try
+                                              {
+                                                  call_loop_body(worker, body, start + first);
+                                                  auto result = worker->pop();
+
+                                                  for (auto i = first + 1; i < last; ++i)
+                                                  {
+                                                      call_loop_body(worker, body, start + i);
+                                                      result = merge(worker, result, worker->pop());
+                                                  }
+
+                                                  worker->release_context();
+
+                                                  return result;
+                                              }
+                                              catch (...)
+                                              {
+                                                  worker->release_context();
+                                                  throw;
+                                              }
+                                          });
+
+            // The chunk results are merged on an interpreter of their own as well, so the merge
+            // word's variable writes aren't kept either.
+            auto merger = clone_interpreter(interpreter);
+            auto result = initial;
+
+            for (auto& chunk : chunks)
+            {
+                result = merge(merger, result, chunk);
+            }
+
+            interpreter->push(result);
+        }
+
+
+    }
+
+
+    void register_task_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "task.spawn", word_task_spawn,
+            "Run the named word on the task pool with the given input and return it's future.",
+            "input word-name -- future");
+
+        ADD_NATIVE_WORD(interpreter, "task.wait", word_task_wait,
+            "Wait for a task to complete and get it's result.  If the task failed, so does this.",
+            "future -- result");
+
+        ADD_NATIVE_WORD(interpreter, "task.workers", word_task_workers,
+            "How many worker threads the task pool has.",
+            " -- count");
+
+        ADD_NATIVE_WORD(interpreter, "parallel.for", word_parallel_for,
+            "Call the word with each index from start up to end, split across the task pool.  "
+            "The word runs on the pool's interpreters, so it's variable writes aren't kept.",
+            "start end word-index -- ");
+
+        ADD_NATIVE_WORD(interpreter, "parallel.reduce", word_parallel_reduce,
+            "Call the word ( index -- value ) for each index and merge the values together.  "
+            "Both words run on interpreters of their own, so their variable writes aren't kept.",
+            "initial start end word-index merge-word-index -- result");
+    }
+
+
+}
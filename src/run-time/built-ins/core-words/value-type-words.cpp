@@ -75,6 +75,38 @@ namespace sorth::internal
         }
 
 
+        void word_value_is_future(InterpreterPtr& interpreter)
+        {
+            auto value = interpreter->pop();
+
+            interpreter->push(value.is_future());
+        }
+
+
+        void word_value_is_thread(InterpreterPtr& interpreter)
+        {
+            auto value = interpreter->pop();
+
+            interpreter->push(value.is_thread_handle());
+        }
+
+
+        void word_value_is_channel(InterpreterPtr& interpreter)
+        {
+            auto value = interpreter->pop();
+
+            interpreter->push(value.is_channel());
+        }
+
+
+        void word_value_is_concurrent_hash_table(InterpreterPtr& interpreter)
+        {
+            auto value = interpreter->pop();
+
+            interpreter->push(value.is_concurrent_hash_table());
+        }
+
+
         void word_value_copy(InterpreterPtr& interpreter)
         {
             auto original = interpreter->pop();
@@ -83,6 +115,23 @@ namespace sorth::internal
         }
 
 
+        void word_value_freeze(InterpreterPtr& interpreter)
+        {
+            auto value = interpreter->pop();
+
+            value.freeze();
+            interpreter->push(value);
+        }
+
+
+        void word_value_is_frozen(InterpreterPtr& interpreter)
+        {
+            auto value = interpreter->pop();
+
+            interpreter->push(value.is_frozen());
+        }
+
+
     }
 
 
@@ -116,9 +165,34 @@ namespace sorth::internal
             "Is the value a hash table?",
             "value -- bool");
 
+        ADD_NATIVE_WORD(interpreter, "value.is-future?", word_value_is_future,
+            "Is the value a future?",
+            "value -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "value.is-thread?", word_value_is_thread,
+            "Is the value a thread handle?",
+            "value -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "value.is-channel?", word_value_is_channel,
+            "Is the value a channel?",
+            "value -- bool");
+
+        ADD_NATIVE_WORD(interpreter, "value.is-ctable?", word_value_is_concurrent_hash_table,
+            "Is the value a concurrent hash table?",
+            "value -- bool");
+
         ADD_NATIVE_WORD(interpreter, "value.copy", word_value_copy,
             "Create a new value that's a copy of another.  Deep copy as required.",
             "value -- new_copy");
+
+        ADD_NATIVE_WORD(interpreter, "value.freeze", word_value_freeze,
+            "Make a value and everything it holds read only, so that it can be safely shared "
+            "between threads.  Use value.copy to get a copy that can be changed again.",
+            "value -- value");
+
+        ADD_NATIVE_WORD(interpreter, "value.frozen?", word_value_is_frozen,
+            "Is the value read only?  Numbers, strings, and the like always are.",
+            "value -- bool");
     }
 
 
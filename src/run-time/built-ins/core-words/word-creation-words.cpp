@@ -73,6 +73,77 @@ namespace sorth::internal
         };
 
 
+        #if (SORTH_LLVM_FOUND == 1)
+
+
+        // Handler for immediate words in JIT mode.  The word's byte-code is interpreted until the
+        // word has been called often enough to make compiling it worth the cost, after which the
+        // JITed version of the word is used.
+        class TieredWord
+        {
+            private:
+                struct State
+                {
+                    // Only one thread gets to compile the word.
+                    std::mutex lock;
+                    std::atomic<bool> is_compiled = false;
+                    std::atomic<int64_t> calls = 0;
+
+                    int64_t threshold;
+                    Construction construction;
+
+                    // The byte-code version of the word, and the JITed version once it's compiled.
+                    WordFunction interpreted;
+                    WordFunction compiled;
+                };
+
+                std::shared_ptr<State> state;
+
+            public:
+                TieredWord(const Construction& construction,
+                           const WordFunction& interpreted,
+                           int64_t threshold)
+                : state(std::make_shared<State>())
+                {
+                    state->threshold = threshold;
+                    state->construction = construction;
+                    state->interpreted = interpreted;
+                }
+
+            public:
+                void operator ()(InterpreterPtr& interpreter)
+                {
+                    if (!state->is_compiled.load(std::memory_order_acquire))
+                    {
+                        auto calls = state->calls.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                        if (calls < state->threshold)
+                        {
+                            state->interpreted(interpreter);
+                            return;
+                        }
+
+                        std::lock_guard<std::mutex> lock(state->lock);
+
+                        if (!state->is_compiled.load(std::memory_order_relaxed))
+                        {
+                            state->compiled = jit_immediate_word(interpreter, state->construction);
+                            state->compiled.set_intrinsic(state->construction.intrinsic);
+
+                            // The interpreter keeps it's own copy of the byte-code.
+                            state->construction.code.clear();
+                            state->is_compiled.store(true, std::memory_order_release);
+                        }
+                    }
+
+                    state->compiled(interpreter);
+                }
+        };
+
+
+        #endif
+
+
         void word_start_word(InterpreterPtr& interpreter)
         {
             const auto& token = interpreter->compile_context().get_next_token();
@@ -98,10 +169,25 @@ namespace sorth::internal
             #if (SORTH_LLVM_FOUND == 1)
             if (interpreter->get_execution_mode() == ExecutionMode::jit)
             {
-                // If the word is not immediate, then we can cache the construction to be JIT compiled
-                // when the whole script is compiled.
-                if (construction.execution_context == ExecutionContext::run_time)
+                auto script_word = ScriptWord(construction.name,
+                                              construction.code,
+                                              construction.location,
+                                              construction.context_management);
+
+                if (construction.jit_policy == WordJitPolicy::never)
                 {
+                    // The word has asked to always be interpreted.  Make sure that an earlier
+                    // definition of the word doesn't get compiled in it's place.
+                    interpreter->compile_context().word_jit_cache.erase(construction.name);
+
+                    handler = script_word;
+                    handler.set_byte_code(std::move(construction.code));
+                }
+                else if (construction.execution_context == ExecutionContext::run_time)
+                {
+                    // If the word is not immediate, then we can cache the construction to be JIT
+                    // compiled when the whole script is compiled.
+                    //
                     // Add the construction to the JIT cache.
                     interpreter->compile_context().word_jit_cache[construction.name] = construction;
 
@@ -109,17 +195,28 @@ namespace sorth::internal
                     // the JITed handler when the script is compiled.
                     //
                     // However in the mean time, immediate words may need these words, byte-code or not.
-                    auto script_word = ScriptWord(construction.name,
-                                                  construction.code,
-                                                  construction.location,
-                                                  construction.context_management);
                     handler = script_word;
                     handler.set_byte_code(std::move(construction.code));
                 }
                 else
                 {
-                    // Otherwise we need to JIT compile the word now in it's own module.
-                    handler = jit_immediate_word(interpreter, construction);
+                    auto threshold = get_jit_settings().immediate_threshold;
+
+                    if (   (construction.jit_policy == WordJitPolicy::always)
+                        || (threshold == 0))
+                    {
+                        // The word is to be compiled right away in it's own module.
+                        handler = jit_immediate_word(interpreter, construction);
+                    }
+                    else
+                    {
+                        // Immediate words are usually only run a few times, so interpret them
+                        // until they've proven that they're worth compiling.
+                        handler = TieredWord(construction,
+                                             WordFunction::Handler(script_word),
+                                             threshold);
+                    }
+
                     handler.set_byte_code(std::move(construction.code));
                 }
             }
@@ -145,6 +242,9 @@ namespace sorth::internal
                 handler.set_byte_code(std::move(construction.code));
             }
 
+            // Let the JIT know if the word can be treated as one of it's intrinsic operations.
+            handler.set_intrinsic(construction.intrinsic);
+
             // Register the word either byte-code or JITed with the interpreter.
             interpreter->add_word(construction.name,
                                   handler,
@@ -177,6 +277,67 @@ namespace sorth::internal
         }
 
 
+        void word_intrinsic(InterpreterPtr& interpreter)
+        {
+            static const std::unordered_map<std::string, WordIntrinsic> intrinsics =
+                {
+                    { "add",           WordIntrinsic::add           },
+                    { "subtract",      WordIntrinsic::subtract      },
+                    { "multiply",      WordIntrinsic::multiply      },
+                    { "divide",        WordIntrinsic::divide        },
+                    { "mod",           WordIntrinsic::mod           },
+                    { "increment",     WordIntrinsic::increment     },
+                    { "decrement",     WordIntrinsic::decrement     },
+                    { "bit_and",       WordIntrinsic::bit_and       },
+                    { "bit_or",        WordIntrinsic::bit_or        },
+                    { "bit_xor",       WordIntrinsic::bit_xor       },
+                    { "logic_not",     WordIntrinsic::logic_not     },
+                    { "equal",         WordIntrinsic::equal         },
+                    { "not_equal",     WordIntrinsic::not_equal     },
+                    { "greater_equal", WordIntrinsic::greater_equal },
+                    { "less_equal",    WordIntrinsic::less_equal    },
+                    { "greater",       WordIntrinsic::greater       },
+                    { "less",          WordIntrinsic::less          },
+                    { "dup",           WordIntrinsic::dup           },
+                    { "drop",          WordIntrinsic::drop          },
+                    { "swap",          WordIntrinsic::swap          },
+                    { "over",          WordIntrinsic::over          },
+                    { "rot",           WordIntrinsic::rot           },
+                    { "increment_variable", WordIntrinsic::increment_variable },
+                    { "decrement_variable", WordIntrinsic::decrement_variable }
+                };
+
+            const auto& token = interpreter->compile_context().get_next_token();
+            auto iter = intrinsics.find(token.text);
+
+            throw_error_if(iter == intrinsics.end(),
+                        interpreter,
+                        "Unknown intrinsic operation " + token.text + ".");
+
+            interpreter->compile_context().construction().intrinsic = iter->second;
+        }
+
+
+        void word_jit_policy(InterpreterPtr& interpreter)
+        {
+            static const std::unordered_map<std::string, WordJitPolicy> policies =
+                {
+                    { "auto",   WordJitPolicy::automatic },
+                    { "always", WordJitPolicy::always    },
+                    { "never",  WordJitPolicy::never     }
+                };
+
+            const auto& token = interpreter->compile_context().get_next_token();
+            auto iter = policies.find(token.text);
+
+            throw_error_if(iter == policies.end(),
+                        interpreter,
+                        "Unknown JIT policy " + token.text + ".");
+
+            interpreter->compile_context().construction().jit_policy = iter->second;
+        }
+
+
         void word_description(InterpreterPtr& interpreter)
         {
             const auto& token = interpreter->compile_context().get_next_token();
@@ -226,6 +387,15 @@ namespace sorth::internal
             "Disable automatic context management for the word.",
             " -- ");
 
+        ADD_NATIVE_IMMEDIATE_WORD(interpreter, "intrinsic:", word_intrinsic,
+            "Mark the current word as behaving like one of the JIT's intrinsic operations for "
+            "numeric values.",
+            "intrinsic: <operation>");
+
+        ADD_NATIVE_IMMEDIATE_WORD(interpreter, "jit:", word_jit_policy,
+            "Choose how the JIT treats the current word, one of auto, always, or never.",
+            "jit: <policy>");
+
         ADD_NATIVE_IMMEDIATE_WORD(interpreter, "description:", word_description,
             "Give a new word it's description.",
             " -- ");
@@ -0,0 +1,845 @@
+#include "sorth.h"
+
+
+#if defined(IS_UNIX)
+
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <queue>
+#include <deque>
+
+#if defined(__linux__)
+
+    #include <sys/epoll.h>
+
+#else
+
+    #include <poll.h>
+
+#endif
+
+
+
+namespace sorth
+{
+
+
+    using namespace internal;
+
+
+    namespace
+    {
+
+
+        using Clock = std::chrono::steady_clock;
+
+
+        // An fd that has become ready, as reported by the OS.
+        struct PollEvent
+        {
+            int fd;
+            bool is_readable;
+            bool is_writable;
+        };
+
+
+        #if defined(__linux__)
+
+
+            // Watch the fds with epoll, so that the cost of waiting doesn't grow with the number
+            // of fds being watched.
+            class Poller
+            {
+                private:
+                    int epoll_fd;
+                    std::vector<struct epoll_event> events;
+
+                public:
+                    Poller()
+                    : epoll_fd(epoll_create1(EPOLL_CLOEXEC)),
+                      events(64)
+                    {
+                    }
+
+                    Poller(const Poller& poller) = delete;
+
+                    ~Poller()
+                    {
+                        if (epoll_fd != -1)
+                        {
+                            close(epoll_fd);
+                        }
+                    }
+
+                public:
+                    Poller& operator =(const Poller& poller) = delete;
+
+                public:
+                    void watch(InterpreterPtr& interpreter,
+                               int fd,
+                               bool is_new,
+                               bool want_read,
+                               bool want_write)
+                    {
+                        throw_error_if(epoll_fd == -1, interpreter,
+                                       "Could not create the event loop's epoll fd.");
+
+                        struct epoll_event event;
+
+                        memset(&event, 0, sizeof(event));
+
+                        if (want_read)
+                        {
+                            event.events |= EPOLLIN;
+                        }
+
+                        if (want_write)
+                        {
+                            event.events |= EPOLLOUT;
+                        }
+
+                        event.data.fd = fd;
+
+                        auto result = epoll_ctl(epoll_fd,
+                                                is_new ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                                                fd,
+                                                &event);
+
+                        throw_error_if(result == -1, interpreter,
+                                       "Could not watch fd, " + std::string(strerror(errno)) + ".");
+                    }
+
+                    void forget(int fd)
+                    {
+                        // The fd may have already been closed, which removes it for us.
+                        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+                    }
+
+                    void wait(int timeout, std::vector<PollEvent>& ready)
+                    {
+                        auto count = epoll_wait(epoll_fd, events.data(), events.size(), timeout);
+
+                        for (int i = 0; i < count; ++i)
+                        {
+                            auto flags = events[i].events;
+
+                            // Errors and hang ups are passed on as readable and writable, so that
+                            // the callback sees the failure when it next reads or writes.
+                            bool has_failed = (flags & (EPOLLERR | EPOLLHUP)) != 0;
+
+                            ready.push_back({
+                                    .fd = events[i].data.fd,
+                                    .is_readable = has_failed || ((flags & EPOLLIN) != 0),
+                                    .is_writable = has_failed || ((flags & EPOLLOUT) != 0)
+                                });
+                        }
+
+                        // If we filled the buffer, there are likely even more fds ready.
+                        if ((count > 0) && (static_cast<size_t>(count) == events.size()))
+                        {
+                            events.resize(events.size() * 2);
+                        }
+                    }
+            };
+
+
+        #else
+
+
+            // Systems without epoll fall back to poll.
+            class Poller
+            {
+                private:
+                    std::unordered_map<int, short> watched;
+                    std::vector<struct pollfd> fds;
+
+                public:
+                    void watch(InterpreterPtr& interpreter,
+                               int fd,
+                               bool is_new,
+                               bool want_read,
+                               bool want_write)
+                    {
+                        watched[fd] = (want_read ? POLLIN : 0) | (want_write ? POLLOUT : 0);
+                    }
+
+                    void forget(int fd)
+                    {
+                        watched.erase(fd);
+                    }
+
+                    void wait(int timeout, std::vector<PollEvent>& ready)
+                    {
+                        fds.clear();
+
+                        for (const auto& [ fd, flags ] : watched)
+                        {
+                            fds.push_back({ .fd = fd, .events = flags, .revents = 0 });
+                        }
+
+                        auto count = poll(fds.data(), fds.size(), timeout);
+
+                        for (size_t i = 0; (count > 0) && (i < fds.size()); ++i)
+                        {
+                            auto flags = fds[i].revents;
+
+                            if (flags == 0)
+                            {
+                                continue;
+                            }
+
+                            bool has_failed = (flags & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+
+                            ready.push_back({
+                                    .fd = fds[i].fd,
+                                    .is_readable = has_failed || ((flags & POLLIN) != 0),
+                                    .is_writable = has_failed || ((flags & POLLOUT) != 0)
+                                });
+                        }
+                    }
+            };
+
+
+        #endif
+
+
+        // The words to call when an fd is ready.
+        struct Watch
+        {
+            std::optional<int64_t> on_readable;
+            std::optional<int64_t> on_writable;
+        };
+
+
+        struct Timer
+        {
+            Clock::time_point due;
+
+            // Repeating timers are rescheduled this long after they fire, one shot timers have no
+            // interval.
+            std::optional<Clock::duration> interval;
+
+            int64_t word_index;
+        };
+
+
+        // Something that's ready for it's callback to be run.
+        struct ReadyItem
+        {
+            enum class Kind { readable, writable, timer };
+
+            Kind kind;
+
+            // The fd or timer id.
+            int64_t id;
+        };
+
+
+        // Each OS thread gets it's own event loop.  The OS tells us which fds are ready, and those
+        // along with any timers that are due are placed on a ready queue.  Callbacks are then run
+        // one at a time from the queue, so a callback that adds or removes fds never disturbs the
+        // events that are already waiting to be handled.
+        class EventLoop
+        {
+            private:
+                Poller poller;
+                std::unordered_map<int, Watch> watches;
+
+                // Timers are kept in a queue ordered by when they're due.  Canceled timers are
+                // simply dropped from the timer table and skipped when they reach the front.
+                using TimerEntry = std::pair<Clock::time_point, int64_t>;
+                using TimerQueue = std::priority_queue<TimerEntry,
+                                                       std::vector<TimerEntry>,
+                                                       std::greater<TimerEntry>>;
+
+                TimerQueue timer_queue;
+                std::unordered_map<int64_t, Timer> timers;
+                int64_t next_timer_id;
+
+                std::deque<ReadyItem> ready;
+                std::vector<PollEvent> events;
+
+                bool is_stopping;
+
+            public:
+                EventLoop()
+                : poller(),
+                  watches(),
+                  timer_queue(),
+                  timers(),
+                  next_timer_id(1),
+                  ready(),
+                  events(),
+                  is_stopping(false)
+                {
+                }
+
+            public:
+                void watch(InterpreterPtr& interpreter, int fd, int64_t word_index, bool is_read)
+                {
+                    set_non_blocking(interpreter, fd);
+
+                    auto iter = watches.find(fd);
+                    bool is_new = iter == watches.end();
+
+                    auto watch = is_new ? Watch() : iter->second;
+
+                    if (is_read)
+                    {
+                        watch.on_readable = word_index;
+                    }
+                    else
+                    {
+                        watch.on_writable = word_index;
+                    }
+
+                    poller.watch(interpreter,
+                                 fd,
+                                 is_new,
+                                 watch.on_readable.has_value(),
+                                 watch.on_writable.has_value());
+
+                    watches[fd] = watch;
+                }
+
+                void unwatch(InterpreterPtr& interpreter, int fd, bool is_read, bool is_write)
+                {
+                    auto iter = watches.find(fd);
+
+                    if (iter == watches.end())
+                    {
+                        return;
+                    }
+
+                    auto& watch = iter->second;
+
+                    if (is_read)
+                    {
+                        watch.on_readable.reset();
+                    }
+
+                    if (is_write)
+                    {
+                        watch.on_writable.reset();
+                    }
+
+                    if ((!watch.on_readable) && (!watch.on_writable))
+                    {
+                        poller.forget(fd);
+                        watches.erase(iter);
+                    }
+                    else
+                    {
+                        poller.watch(interpreter,
+                                     fd,
+                                     false,
+                                     watch.on_readable.has_value(),
+                                     watch.on_writable.has_value());
+                    }
+                }
+
+                int64_t add_timer(std::chrono::milliseconds delay,
+                                  bool is_repeating,
+                                  int64_t word_index)
+                {
+                    auto id = next_timer_id++;
+                    auto due = Clock::now() + delay;
+
+                    timers[id] =
+                        {
+                            .due = due,
+                            .interval = is_repeating ? std::optional<Clock::duration>(delay)
+                                                     : std::nullopt,
+                            .word_index = word_index
+                        };
+
+                    timer_queue.push({ due, id });
+
+                    return id;
+                }
+
+                void cancel_timer(int64_t id)
+                {
+                    timers.erase(id);
+                }
+
+                void stop()
+                {
+                    is_stopping = true;
+                }
+
+                // Keep dispatching events until there's nothing left to wait for, or the loop has
+                // been stopped.
+                void run(InterpreterPtr& interpreter)
+                {
+                    is_stopping = false;
+
+                    while (   (!is_stopping)
+                           && ((!watches.empty()) || (!timers.empty()) || (!ready.empty())))
+                    {
+                        run_once(interpreter, std::nullopt);
+                    }
+
+                    is_stopping = false;
+                }
+
+                // Wait for events, up to the timeout, then run the callbacks for everything that
+                // was ready.  Returns the number of callbacks that were run.
+                size_t run_once(InterpreterPtr& interpreter,
+                                std::optional<std::chrono::milliseconds> timeout)
+                {
+                    if (ready.empty())
+                    {
+                        poll_events(timeout);
+                    }
+
+                    // Only run what's ready now, anything queued by the callbacks waits for the
+                    // next pass.
+                    auto count = ready.size();
+                    size_t dispatched = 0;
+
+                    for (size_t i = 0; (i < count) && (!is_stopping); ++i)
+                    {
+                        auto item = ready.front();
+
+                        ready.pop_front();
+
+                        if (dispatch(interpreter, item))
+                        {
+                            ++dispatched;
+                        }
+                    }
+
+                    return dispatched;
+                }
+
+            private:
+                void set_non_blocking(InterpreterPtr& interpreter, int fd)
+                {
+                    auto flags = fcntl(fd, F_GETFL);
+
+                    if ((flags != -1) && ((flags & O_NONBLOCK) == 0))
+                    {
+                        flags = fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+                    }
+
+                    throw_error_if(flags == -1, interpreter,
+                                   "Could not make fd non-blocking, "
+                                   + std::string(strerror(errno)) + ".");
+                }
+
+                // How long we can wait for fds before the next timer is due, in milliseconds, or -1
+                // to wait for as long as it takes.
+                int time_until_next_timer(std::optional<std::chrono::milliseconds> timeout)
+                {
+                    drop_canceled_timers();
+
+                    std::optional<Clock::duration> wait = timeout;
+
+                    if (!timer_queue.empty())
+                    {
+                        auto until_due = timer_queue.top().first - Clock::now();
+
+                        if ((!wait) || (until_due < *wait))
+                        {
+                            wait = until_due;
+                        }
+                    }
+
+                    if (!wait)
+                    {
+                        return -1;
+                    }
+
+                    if (*wait <= Clock::duration::zero())
+                    {
+                        return 0;
+                    }
+
+                    // Round up, so that we don't wake up just before the timer is due.
+                    return static_cast<int>(
+                        std::chrono::ceil<std::chrono::milliseconds>(*wait).count());
+                }
+
+                void poll_events(std::optional<std::chrono::milliseconds> timeout)
+                {
+                    auto wait = time_until_next_timer(timeout);
+
+                    // Don't sleep forever if there's nothing that could ever wake us.
+                    if ((watches.empty()) && (wait == -1))
+                    {
+                        return;
+                    }
+
+                    events.clear();
+                    poller.wait(wait, events);
+
+                    for (const auto& event : events)
+                    {
+                        if (event.is_readable)
+                        {
+                            ready.push_back({ .kind = ReadyItem::Kind::readable, .id = event.fd });
+                        }
+
+                        if (event.is_writable)
+                        {
+                            ready.push_back({ .kind = ReadyItem::Kind::writable, .id = event.fd });
+                        }
+                    }
+
+                    queue_due_timers();
+                }
+
+                void queue_due_timers()
+                {
+                    auto now = Clock::now();
+
+                    while ((!timer_queue.empty()) && (timer_queue.top().first <= now))
+                    {
+                        auto [ due, id ] = timer_queue.top();
+                        timer_queue.pop();
+
+                        auto iter = timers.find(id);
+
+                        if ((iter == timers.end()) || (iter->second.due != due))
+                        {
+                            continue;
+                        }
+
+                        ready.push_back({ .kind = ReadyItem::Kind::timer, .id = id });
+                    }
+                }
+
+                void drop_canceled_timers()
+                {
+                    while (   (!timer_queue.empty())
+                           && (timers.find(timer_queue.top().second) == timers.end()))
+                    {
+                        timer_queue.pop();
+                    }
+                }
+
+                // Run the item's callback, returns false if there wasn't one to run.
+                bool dispatch(InterpreterPtr& interpreter, const ReadyItem& item)
+                {
+                    // The fd or timer may have been removed by an earlier callback after it was
+                    // queued.
+                    if (item.kind == ReadyItem::Kind::timer)
+                    {
+                        auto iter = timers.find(item.id);
+
+                        if (iter == timers.end())
+                        {
+                            return false;
+                        }
+
+                        auto& timer = iter->second;
+                        auto word_index = timer.word_index;
+
+                        if (timer.interval)
+                        {
+                            // If we've fallen behind, skip the missed ticks rather than firing
+                            // them all at once.
+                            timer.due = std::max(timer.due + *timer.interval,
+                                                 Clock::now() + *timer.interval / 2);
+                            timer_queue.push({ timer.due, item.id });
+                        }
+                        else
+                        {
+                            timers.erase(iter);
+                        }
+
+                        interpreter->push(item.id);
+                        interpreter->execute_word(word_index);
+
+                        return true;
+                    }
+
+                    auto iter = watches.find(static_cast<int>(item.id));
+
+                    if (iter == watches.end())
+                    {
+                        return false;
+                    }
+
+                    auto word_index = item.kind == ReadyItem::Kind::readable
+                                      ? iter->second.on_readable
+                                      : iter->second.on_writable;
+
+                    if (!word_index)
+                    {
+                        return false;
+                    }
+
+                    interpreter->push(item.id);
+                    interpreter->execute_word(*word_index);
+
+                    return true;
+                }
+        };
+
+
+        EventLoop& get_event_loop()
+        {
+            thread_local EventLoop event_loop;
+
+            return event_loop;
+        }
+
+
+        int pop_fd(InterpreterPtr& interpreter)
+        {
+            auto fd = interpreter->pop_as_integer();
+
+            throw_error_if(fd < 0, interpreter, "Invalid fd.");
+
+            return static_cast<int>(fd);
+        }
+
+
+        std::chrono::milliseconds pop_milliseconds(InterpreterPtr& interpreter)
+        {
+            auto milliseconds = interpreter->pop_as_integer();
+
+            throw_error_if(milliseconds < 0, interpreter, "Time can not be negative.");
+
+            return std::chrono::milliseconds(milliseconds);
+        }
+
+
+        void word_event_on_readable(InterpreterPtr& interpreter)
+        {
+            auto word_index = interpreter->pop_as_integer();
+            auto fd = pop_fd(interpreter);
+
+            get_event_loop().watch(interpreter, fd, word_index, true);
+        }
+
+
+        void word_event_on_writable(InterpreterPtr& interpreter)
+        {
+            auto word_index = interpreter->pop_as_integer();
+            auto fd = pop_fd(interpreter);
+
+            get_event_loop().watch(interpreter, fd, word_index, false);
+        }
+
+
+        void word_event_remove_readable(InterpreterPtr& interpreter)
+        {
+            get_event_loop().unwatch(interpreter, pop_fd(interpreter), true, false);
+        }
+
+
+        void word_event_remove_writable(InterpreterPtr& interpreter)
+        {
+            get_event_loop().unwatch(interpreter, pop_fd(interpreter), false, true);
+        }
+
+
+        void word_event_remove(InterpreterPtr& interpreter)
+        {
+            get_event_loop().unwatch(interpreter, pop_fd(interpreter), true, true);
+        }
+
+
+        void word_event_timer(InterpreterPtr& interpreter)
+        {
+            auto word_index = interpreter->pop_as_integer();
+            auto delay = pop_milliseconds(interpreter);
+
+            interpreter->push(get_event_loop().add_timer(delay, false, word_index));
+        }
+
+
+        void word_event_interval(InterpreterPtr& interpreter)
+        {
+            auto word_index = interpreter->pop_as_integer();
+            auto delay = pop_milliseconds(interpreter);
+
+            throw_error_if(delay.count() == 0, interpreter, "Interval must be at least 1ms.");
+
+            interpreter->push(get_event_loop().add_timer(delay, true, word_index));
+        }
+
+
+        void word_event_cancel(InterpreterPtr& interpreter)
+        {
+            get_event_loop().cancel_timer(interpreter->pop_as_integer());
+        }
+
+
+        void word_event_loop(InterpreterPtr& interpreter)
+        {
+            get_event_loop().run(interpreter);
+        }
+
+
+        void word_event_run_once(InterpreterPtr& interpreter)
+        {
+            auto timeout = pop_milliseconds(interpreter);
+
+            interpreter->push(get_event_loop().run_once(interpreter, timeout));
+        }
+
+
+        void word_event_stop(InterpreterPtr&)
+        {
+            get_event_loop().stop();
+        }
+
+
+        void word_event_read(InterpreterPtr& interpreter)
+        {
+            auto fd = pop_fd(interpreter);
+            auto max_size = interpreter->pop_as_size();
+
+            std::string buffer(max_size, '\0');
+            ssize_t result;
+
+            do
+            {
+                errno = 0;
+                result = read(fd, buffer.data(), max_size);
+            }
+            while ((result == -1) && (errno == EINTR));
+
+            bool is_open = true;
+
+            if (result == -1)
+            {
+                throw_error_if((errno != EAGAIN) && (errno != EWOULDBLOCK),
+                               interpreter,
+                               "FD could not be read from " + std::string(strerror(errno)) + ".");
+
+                result = 0;
+            }
+            else if ((result == 0) && (max_size > 0))
+            {
+                // The other end has been closed.
+                is_open = false;
+            }
+
+            buffer.resize(result);
+
+            interpreter->push(buffer);
+            interpreter->push(is_open);
+        }
+
+
+        void word_event_write(InterpreterPtr& interpreter)
+        {
+            auto fd = pop_fd(interpreter);
+            auto value = interpreter->pop();
+
+            std::string text;
+            const void* data;
+            size_t size;
+
+            if (value.is_byte_buffer())
+            {
+                auto buffer = value.as_byte_buffer(interpreter);
+
+                data = buffer->data_ptr();
+                size = buffer->size();
+            }
+            else
+            {
+                text = value.as_string(interpreter);
+                data = text.data();
+                size = text.size();
+            }
+
+            ssize_t result;
+
+            do
+            {
+                errno = 0;
+                result = write(fd, data, size);
+            }
+            while ((result == -1) && (errno == EINTR));
+
+            if (result == -1)
+            {
+                throw_error_if((errno != EAGAIN) && (errno != EWOULDBLOCK),
+                               interpreter,
+                               "FD could not be written to " + std::string(strerror(errno)) + ".");
+
+                result = 0;
+            }
+
+            interpreter->push(static_cast<int64_t>(result));
+        }
+
+
+    }
+
+
+    SORTH_API void register_event_words(InterpreterPtr& interpreter)
+    {
+        ADD_NATIVE_WORD(interpreter, "event.on-readable", word_event_on_readable,
+                        "Call the word ( fd -- ) whenever the fd has data to read.  The fd is made "
+                        "non-blocking.",
+                        "fd word-index -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.on-writable", word_event_on_writable,
+                        "Call the word ( fd -- ) whenever the fd can be written to.  The fd is "
+                        "made non-blocking.",
+                        "fd word-index -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.remove-readable", word_event_remove_readable,
+                        "Stop watching the fd for data to read.",
+                        "fd -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.remove-writable", word_event_remove_writable,
+                        "Stop watching the fd for room to write.",
+                        "fd -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.remove", word_event_remove,
+                        "Stop watching the fd altogether.  Do this before closing it.",
+                        "fd -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.timer", word_event_timer,
+                        "Call the word ( timer-id -- ) once, after the given number of "
+                        "milliseconds.",
+                        "milliseconds word-index -- timer-id");
+
+        ADD_NATIVE_WORD(interpreter, "event.interval", word_event_interval,
+                        "Call the word ( timer-id -- ) every given number of milliseconds.",
+                        "milliseconds word-index -- timer-id");
+
+        ADD_NATIVE_WORD(interpreter, "event.cancel", word_event_cancel,
+                        "Cancel a timer before it next fires.",
+                        "timer-id -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.loop", word_event_loop,
+                        "Run this thread's event loop until nothing is left to watch or "
+                        "event.stop is called.",
+                        " -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.run-once", word_event_run_once,
+                        "Wait up to the timeout for events and run their callbacks, returning "
+                        "how many ran.",
+                        "milliseconds -- count");
+
+        ADD_NATIVE_WORD(interpreter, "event.stop", word_event_stop,
+                        "Stop the event loop once the current callback returns.",
+                        " -- ");
+
+        ADD_NATIVE_WORD(interpreter, "event.read", word_event_read,
+                        "Read whatever is available from a non-blocking fd, up to the max size.  "
+                        "The flag is false once the other end has closed.",
+                        "max-size fd -- string is-open?");
+
+        ADD_NATIVE_WORD(interpreter, "event.write", word_event_write,
+                        "Write as much of a string or buffer as a non-blocking fd will take, "
+                        "returning how many bytes were written.",
+                        "value fd -- count");
+    }
+
+
+}
+
+
+#endif // IS_UNIX
@@ -0,0 +1,18 @@
+
+#if defined(IS_UNIX)
+
+
+#pragma once
+
+
+namespace sorth
+{
+
+
+    SORTH_API void register_event_words(InterpreterPtr& interpreter);
+
+
+}
+
+
+#endif // IS_UNIX
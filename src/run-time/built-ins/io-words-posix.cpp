@@ -179,6 +179,70 @@ namespace sorth
         }
 
 
+        void word_socket_listen(InterpreterPtr& interpreter)
+        {
+            auto path = interpreter->pop_as_string();
+
+            struct sockaddr_un address;
+            struct stat stat_buffer;
+
+            throw_error_if(path.size() >= sizeof(address.sun_path), interpreter,
+                           "Socket path is too long.");
+
+            // Clear away a socket left behind by an earlier run, but leave anything else alone.
+            if ((stat(path.c_str(), &stat_buffer) == 0) && (S_ISSOCK(stat_buffer.st_mode)))
+            {
+                unlink(path.c_str());
+            }
+
+            auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+            throw_error_if(fd == -1, interpreter,
+                           "Could not open socket fd, " + std::string(strerror(errno)) + ".");
+
+            memset(&address, 0, sizeof(struct sockaddr_un));
+
+            address.sun_family = AF_UNIX;
+            strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+            if (   (bind(fd, (struct sockaddr*)&address, sizeof(address)) == -1)
+                || (listen(fd, SOMAXCONN) == -1))
+            {
+                auto message = std::string(strerror(errno));
+
+                close(fd);
+                throw_error(interpreter, "Could not listen on socket, " + message + ".");
+            }
+
+            interpreter->push((int64_t)fd);
+        }
+
+
+        void word_socket_accept(InterpreterPtr& interpreter)
+        {
+            int fd = (int)interpreter->pop_as_integer();
+            int client_fd;
+
+            do
+            {
+                errno = 0;
+                client_fd = accept(fd, nullptr, nullptr);
+            }
+            while ((client_fd == -1) && (errno == EINTR));
+
+            // A non-blocking socket can be woken up for a connection that's been dropped before
+            // we got to it, that isn't an error for the listening socket.
+            throw_error_if(   (client_fd == -1)
+                           && (errno != EAGAIN)
+                           && (errno != EWOULDBLOCK)
+                           && (errno != ECONNABORTED),
+                           interpreter,
+                           "Could not accept connection, " + std::string(strerror(errno)) + ".");
+
+            interpreter->push((int64_t)client_fd);
+        }
+
+
         void word_file_size_read(InterpreterPtr& interpreter)
         {
             struct stat buffer;
@@ -373,6 +437,44 @@ namespace sorth
             call_write(interpreter, fd, buffer, total_size);
         }
 
+
+
+        // Get the buffer, offset, and fd for an async read or write.
+        std::tuple<ByteBufferPtr, off_t, int> pop_async_request(InterpreterPtr& interpreter)
+        {
+            int fd = (int)interpreter->pop_as_integer();
+            auto offset = interpreter->pop_as_integer();
+            auto buffer = interpreter->pop_as_byte_buffer();
+
+            throw_error_if(offset < 0, interpreter, "File offset can not be negative.");
+
+            return { buffer, (off_t)offset, fd };
+        }
+
+
+        void word_file_read_async(InterpreterPtr& interpreter)
+        {
+            auto [ buffer, offset, fd ] = pop_async_request(interpreter);
+
+            buffer->throw_if_frozen(interpreter);
+
+            interpreter->push(async_read(interpreter, fd, buffer, offset));
+        }
+
+
+        void word_file_write_async(InterpreterPtr& interpreter)
+        {
+            auto [ buffer, offset, fd ] = pop_async_request(interpreter);
+
+            interpreter->push(async_write(interpreter, fd, buffer, offset));
+        }
+
+
+        void word_file_async_backend(InterpreterPtr& interpreter)
+        {
+            interpreter->push(async_io_backend());
+        }
+
     }
 
 
@@ -395,6 +497,15 @@ namespace sorth
                         "Connect to Unix domain socket at the given path.",
                         "path -- fd");
 
+        ADD_NATIVE_WORD(interpreter, "socket.listen", word_socket_listen,
+                        "Create a Unix domain socket at the given path and listen for connections.",
+                        "path -- fd");
+
+        ADD_NATIVE_WORD(interpreter, "socket.accept", word_socket_accept,
+                        "Accept the next connection on a listening socket.  Gives -1 if a "
+                        "non-blocking socket had no connection waiting after all.",
+                        "fd -- client-fd");
+
 
         ADD_NATIVE_WORD(interpreter, "file.size@", word_file_size_read,
                         "Return the size of a file represented by a fd.",
@@ -440,6 +551,21 @@ namespace sorth
                         "string fd -- ");
 
 
+        ADD_NATIVE_WORD(interpreter, "file.read-async", word_file_read_async,
+                        "Start filling the buffer from the file at the given offset.  The future "
+                        "gives the number of bytes read.",
+                        "buffer offset fd -- future");
+
+        ADD_NATIVE_WORD(interpreter, "file.write-async", word_file_write_async,
+                        "Start writing the buffer to the file at the given offset.  The future "
+                        "gives the number of bytes written.",
+                        "buffer offset fd -- future");
+
+        ADD_NATIVE_WORD(interpreter, "file.async-backend", word_file_async_backend,
+                        "Which backend is handling the async file words, io_uring or task-pool.",
+                        " -- name");
+
+
         ADD_NATIVE_WORD(interpreter, "file.r/o", [](auto intr) { intr->push((int64_t)O_RDONLY); },
                         "Constant for opening a file as read only.",
                         " -- flag");
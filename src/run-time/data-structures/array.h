@@ -6,7 +6,7 @@ namespace sorth
 {
 
 
-    class Array
+    class Array : public Freezable
     {
         private:
             std::vector<Value> items;
@@ -6,89 +6,311 @@ namespace sorth
 {
 
 
-    BlockingValueQueue::BlockingValueQueue()
-    : item_lock(),
-      condition(),
-      items()
+    namespace
     {
+
+
+        // How many times a thread retries a push or pop before going to sleep.  Messages usually
+        // arrive quickly in a busy pipeline, so a short spin avoids the cost of sleeping and
+        // waking.
+        constexpr size_t spin_limit = 128;
+
+
+        size_t round_up_capacity(size_t capacity)
+        {
+            size_t result = 2;
+
+            while (result < capacity)
+            {
+                result <<= 1;
+            }
+
+            return result;
+        }
+
+
+        // Spin until the limit has been hit, returns true once it's time to go to sleep instead.
+        bool spin(size_t& spins)
+        {
+            if (spins < spin_limit)
+            {
+                ++spins;
+                std::this_thread::yield();
+
+                return false;
+            }
+
+            return true;
+        }
+
+
     }
 
 
-    BlockingValueQueue::BlockingValueQueue(const BlockingValueQueue& queue)
-    : item_lock(),
-      condition(),
-      items()
+    BlockingValueQueue::BlockingValueQueue(size_t capacity)
+    : cells(),
+      mask(round_up_capacity(capacity) - 1),
+      push_position(0),
+      pop_position(0),
+      push_count(0),
+      waiting_consumers(0),
+      pop_count(0),
+      waiting_producers(0)
     {
-        std::lock_guard<std::mutex> lock(const_cast<BlockingValueQueue&>(queue).item_lock);
+        cells = std::make_unique<Cell[]>(mask + 1);
 
-        items = queue.items;
+        for (size_t i = 0; i <= mask; ++i)
+        {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
     }
 
 
-    BlockingValueQueue::BlockingValueQueue(BlockingValueQueue&& queue)
-    : item_lock(),
-      condition(),
-      items()
+    int64_t BlockingValueQueue::depth()
     {
-        std::lock_guard<std::mutex> lock(queue.item_lock);
+        auto popped = pop_position.load(std::memory_order_acquire);
+        auto pushed = push_position.load(std::memory_order_acquire);
+
+        return pushed > popped ? pushed - popped : 0;
+    }
 
-        items = std::move(queue.items);
+
+    size_t BlockingValueQueue::capacity() const
+    {
+        return mask + 1;
     }
 
 
-    BlockingValueQueue& BlockingValueQueue::operator =(const BlockingValueQueue& queue)
+    void BlockingValueQueue::push(Value& value)
     {
-        if (&queue != this)
+        size_t spins = 0;
+
+        while (!try_push(value))
         {
-            std::lock_guard<std::mutex> lock(const_cast<BlockingValueQueue&>(queue).item_lock);
-            std::lock_guard<std::mutex> lock2(item_lock);
+            if (spin(spins))
+            {
+                wait_for_space();
+            }
+        }
+
+        wake_consumers();
+    }
+
+
+    Value BlockingValueQueue::pop()
+    {
+        Value value;
+        size_t spins = 0;
 
-            items = queue.items;
+        while (!try_pop(value))
+        {
+            if (spin(spins))
+            {
+                wait_for_value();
+            }
         }
 
-        return *this;
+        wake_producers();
+
+        return value;
     }
 
-    BlockingValueQueue& BlockingValueQueue::operator =(BlockingValueQueue&& queue)
+
+    bool BlockingValueQueue::pop_ready(Value& value)
     {
-        if (&queue != this)
+        if (!try_pop(value))
         {
-            std::lock_guard<std::mutex> lock(queue.item_lock);
-            std::lock_guard<std::mutex> lock2(item_lock);
+            return false;
+        }
+
+        wake_producers();
+
+        return true;
+    }
+
 
-            items = std::move(queue.items);
+    void BlockingValueQueue::push_many(std::vector<Value>& values)
+    {
+        for (auto& value : values)
+        {
+            size_t spins = 0;
+
+            while (!try_push(value))
+            {
+                // Make sure that the consumers know about what we've already pushed before we
+                // wait for them to make room.
+                wake_consumers();
+
+                if (spin(spins))
+                {
+                    wait_for_space();
+                }
+            }
         }
 
-        return *this;
+        wake_consumers();
     }
 
 
-    int64_t BlockingValueQueue::depth()
+    std::vector<Value> BlockingValueQueue::pop_many(size_t count)
+    {
+        std::vector<Value> values(count);
+
+        for (auto& value : values)
+        {
+            size_t spins = 0;
+
+            while (!try_pop(value))
+            {
+                wake_producers();
+
+                if (spin(spins))
+                {
+                    wait_for_value();
+                }
+            }
+        }
+
+        wake_producers();
+
+        return values;
+    }
+
+
+    bool BlockingValueQueue::try_push(Value& value)
     {
-        std::lock_guard<std::mutex> lock(item_lock);
-        return items.size();
+        auto position = push_position.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto& cell = cells[position & mask];
+            auto sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                // The cell is free, try to claim it.
+                if (push_position.compare_exchange_weak(position,
+                                                        position + 1,
+                                                        std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The queue is full.
+                return false;
+            }
+            else
+            {
+                // Another producer got here first.
+                position = push_position.load(std::memory_order_relaxed);
+            }
+        }
     }
 
 
-    void BlockingValueQueue::push(Value& value)
+    bool BlockingValueQueue::try_pop(Value& value)
     {
-        std::lock_guard<std::mutex> lock(item_lock);
+        auto position = pop_position.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto& cell = cells[position & mask];
+            auto sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence)
+                              - static_cast<intptr_t>(position + 1);
 
-        items.push_front(value);
-        condition.notify_one();
+            if (difference == 0)
+            {
+                // There's a value in the cell, try to claim it.
+                if (pop_position.compare_exchange_weak(position,
+                                                       position + 1,
+                                                       std::memory_order_relaxed))
+                {
+                    // Move the value out so that the queue doesn't keep it's data alive.
+                    value = std::move(cell.value);
+                    cell.value = Value();
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The queue is empty.
+                return false;
+            }
+            else
+            {
+                // Another consumer got here first.
+                position = pop_position.load(std::memory_order_relaxed);
+            }
+        }
     }
 
 
-    Value BlockingValueQueue::pop()
+    void BlockingValueQueue::wait_for_value()
     {
-        std::unique_lock<std::mutex> lock(item_lock);
+        // Let the producers know that we're about to sleep, then check one last time that the
+        // queue is still empty.  A producer that pushes after our check will see that we're
+        // waiting and wake us up.
+        waiting_consumers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
 
-        condition.wait(lock, [this]() { return !items.empty(); });
+        auto seen = push_count.load(std::memory_order_seq_cst);
 
-        auto value = items.back();
-        items.pop_back();
+        if (depth() == 0)
+        {
+            push_count.wait(seen, std::memory_order_seq_cst);
+        }
 
-        return value;
+        waiting_consumers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+
+    void BlockingValueQueue::wait_for_space()
+    {
+        waiting_producers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto seen = pop_count.load(std::memory_order_seq_cst);
+
+        if (depth() >= static_cast<int64_t>(capacity()))
+        {
+            pop_count.wait(seen, std::memory_order_seq_cst);
+        }
+
+        waiting_producers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+
+    void BlockingValueQueue::wake_consumers()
+    {
+        // Only pay for the wake up if someone is actually sleeping.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiting_consumers.load(std::memory_order_relaxed) > 0)
+        {
+            push_count.fetch_add(1, std::memory_order_seq_cst);
+            push_count.notify_all();
+        }
+    }
+
+
+    void BlockingValueQueue::wake_producers()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiting_producers.load(std::memory_order_relaxed) > 0)
+        {
+            pop_count.fetch_add(1, std::memory_order_seq_cst);
+            pop_count.notify_all();
+        }
     }
 
 
@@ -6,29 +6,82 @@ namespace sorth
 {
 
 
+    // A bounded queue of values used to pass messages between interpreter threads.  The queue is a
+    // lock-free ring buffer that any number of threads can push to and pop from.  When the queue is
+    // empty, or full, the waiting thread spins for a short while before going to sleep until the
+    // other side has made progress.
+    //
+    // Because the queue is bounded a producer that gets too far ahead of it's consumer is slowed
+    // down to match, instead of the queue growing without limit.
     class BlockingValueQueue
     {
+        public:
+            // How many values a queue can hold by default before pushes start to block.
+            static constexpr size_t default_capacity = 4096;
+
+        private:
+            // Each slot in the ring carries a sequence number that tells pushes and pops whose turn
+            // it is to use the slot.
+            struct Cell
+            {
+                std::atomic<size_t> sequence;
+                Value value;
+            };
+
         private:
-            std::mutex item_lock;
-            std::condition_variable condition;
+            std::unique_ptr<Cell[]> cells;
+            size_t mask;
 
-            std::deque<Value> items;
+            // Keep the push and pop positions on separate cache lines so that the producers and
+            // consumers aren't fighting over the same line.
+            alignas(64) std::atomic<size_t> push_position;
+            alignas(64) std::atomic<size_t> pop_position;
+
+            // Used to put threads to sleep when the queue is empty or full.  The counters are
+            // bumped when there are sleeping threads that need to be woken up.
+            alignas(64) std::atomic<uint32_t> push_count;
+            std::atomic<uint32_t> waiting_consumers;
+
+            alignas(64) std::atomic<uint32_t> pop_count;
+            std::atomic<uint32_t> waiting_producers;
 
         public:
-            BlockingValueQueue();
-            BlockingValueQueue(const BlockingValueQueue& queue);
-            BlockingValueQueue(BlockingValueQueue&& queue);
+            BlockingValueQueue(size_t capacity = default_capacity);
+            BlockingValueQueue(const BlockingValueQueue& queue) = delete;
+            BlockingValueQueue(BlockingValueQueue&& queue) = delete;
 
         public:
-            BlockingValueQueue& operator =(const BlockingValueQueue& queue);
-            BlockingValueQueue& operator =(BlockingValueQueue&& queue);
+            BlockingValueQueue& operator =(const BlockingValueQueue& queue) = delete;
+            BlockingValueQueue& operator =(BlockingValueQueue&& queue) = delete;
 
         public:
             int64_t depth();
+            size_t capacity() const;
 
             void push(Value& value);
             Value pop();
+
+            // Pop a value only if there's one ready, never blocks.
+            bool pop_ready(Value& value);
+
+            // Push or pop a whole batch of values, waking up the other side once per batch instead
+            // of once per value.
+            void push_many(std::vector<Value>& values);
+            std::vector<Value> pop_many(size_t count);
+
+        private:
+            bool try_push(Value& value);
+            bool try_pop(Value& value);
+
+            void wait_for_value();
+            void wait_for_space();
+
+            void wake_consumers();
+            void wake_producers();
     };
 
 
+    using BlockingValueQueuePtr = std::shared_ptr<BlockingValueQueue>;
+
+
 }
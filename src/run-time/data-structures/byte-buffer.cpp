@@ -123,7 +123,8 @@ namespace sorth
 
 
     ByteBuffer::ByteBuffer(const ByteBuffer& buffer)
-    : owned(true),
+    : Freezable(),
+      owned(true),
       bytes(new unsigned char[buffer.byte_size]),
       byte_size(buffer.byte_size),
       current_position(buffer.current_position)
@@ -133,7 +134,8 @@ namespace sorth
 
 
     ByteBuffer::ByteBuffer(ByteBuffer&& buffer)
-    : owned(buffer.owned),
+    : Freezable(),
+      owned(buffer.owned),
       bytes(buffer.bytes),
       byte_size(buffer.byte_size),
       current_position(buffer.current_position)
@@ -276,21 +278,7 @@ namespace sorth
 
     int64_t ByteBuffer::read_int(size_t byte_size, bool is_signed)
     {
-        size_t value = 0;
-        void* data_ptr = position_ptr();
-        memcpy(&value, data_ptr, byte_size);
-
-        if (is_signed)
-        {
-            auto bit_size = byte_size * 8;
-            auto sign_flag = 1 << (bit_size - 1);
-
-            if ((value & sign_flag) != 0)
-            {
-                size_t negative_bits = 0xffffffffffffffff << (64 - bit_size);
-                value = value | negative_bits;
-            }
-        }
+        auto value = read_int_at(current_position, byte_size, is_signed);
 
         increment_position(byte_size);
 
@@ -319,20 +307,7 @@ namespace sorth
 
     double ByteBuffer::read_float(size_t byte_size)
     {
-        double new_value = 0.0;
-        void* data_ptr = position_ptr();
-
-        if (byte_size == 4)
-        {
-            float float_value = 0.0;
-
-            memcpy(&float_value, data_ptr, 4);
-            new_value = float_value;
-        }
-        else
-        {
-            memcpy(&new_value, data_ptr, 8);
-        }
+        auto new_value = read_float_at(current_position, byte_size);
 
         increment_position(byte_size);
 
@@ -351,34 +326,61 @@ namespace sorth
 
     std::string ByteBuffer::read_string(size_t max_size)
     {
-        std::string new_string;
-        void* data_ptr = nullptr;
-        char* buffer = nullptr;
+        auto new_string = read_string_at(current_position, max_size);
 
-        try
-        {
-            data_ptr = position_ptr();
-            buffer = static_cast<char*>(malloc(max_size + 1));
+        increment_position(max_size);
 
-            memset(buffer, 0, max_size + 1);
-            memcpy(buffer, data_ptr, max_size);
+        return new_string;
+    }
 
-            new_string = buffer;
-            increment_position(max_size);
 
-            free(buffer);
-        }
-        catch (...)
+    int64_t ByteBuffer::read_int_at(size_t position, size_t byte_size, bool is_signed) const
+    {
+        size_t value = 0;
+        memcpy(&value, &bytes[position], byte_size);
+
+        if (is_signed)
         {
-            if (buffer)
+            auto bit_size = byte_size * 8;
+            auto sign_flag = 1 << (bit_size - 1);
+
+            if ((value & sign_flag) != 0)
             {
-                free(buffer);
+                size_t negative_bits = 0xffffffffffffffff << (64 - bit_size);
+                value = value | negative_bits;
             }
+        }
+
+        return value;
+    }
+
+
+    double ByteBuffer::read_float_at(size_t position, size_t byte_size) const
+    {
+        double new_value = 0.0;
+        const void* data_ptr = &bytes[position];
 
-            throw;
+        if (byte_size == 4)
+        {
+            float float_value = 0.0;
+
+            memcpy(&float_value, data_ptr, 4);
+            new_value = float_value;
+        }
+        else
+        {
+            memcpy(&new_value, data_ptr, 8);
         }
 
-        return new_string;
+        return new_value;
+    }
+
+
+    std::string ByteBuffer::read_string_at(size_t position, size_t max_size) const
+    {
+        auto data_ptr = reinterpret_cast<const char*>(&bytes[position]);
+
+        return std::string(data_ptr, strnlen(data_ptr, max_size));
     }
 
 
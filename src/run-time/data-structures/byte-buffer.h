@@ -57,7 +57,7 @@ namespace sorth
 
 
 
-    class ByteBuffer : public Buffer
+    class ByteBuffer : public Buffer, public Freezable
     {
         private:
             bool owned;
@@ -101,6 +101,13 @@ namespace sorth
             virtual void write_string(const std::string& string, size_t max_size) override;
             virtual std::string read_string(size_t max_size) override;
 
+        public:
+            // Read values from a given offset without moving the buffer's position.  This is how
+            // a frozen buffer is read, as it's position can't be shared safely between threads.
+            int64_t read_int_at(size_t position, size_t byte_size, bool is_signed) const;
+            double read_float_at(size_t position, size_t byte_size) const;
+            std::string read_string_at(size_t position, size_t max_size) const;
+
         private:
             void reset();
     };
@@ -0,0 +1,199 @@
+
+#include "sorth.h"
+
+
+
+namespace sorth
+{
+
+
+    struct Channel::Selector
+    {
+        std::mutex lock;
+        std::condition_variable condition;
+        bool is_signaled = false;
+    };
+
+
+    namespace
+    {
+
+
+        // Rotates the channel that each select on this thread looks at first.
+        thread_local size_t next_select_start = 0;
+
+
+    }
+
+
+    std::ostream& operator <<(std::ostream& stream, const ChannelPtr& channel)
+    {
+        stream << "<channel " << channel->depth() << "/" << channel->capacity() << ">";
+
+        return stream;
+    }
+
+
+    Channel::Channel(size_t capacity)
+    : queue(capacity),
+      selector_lock(),
+      selectors(),
+      selector_count(0)
+    {
+    }
+
+
+    int64_t Channel::depth()
+    {
+        return queue.depth();
+    }
+
+
+    size_t Channel::capacity() const
+    {
+        return queue.capacity();
+    }
+
+
+    void Channel::push(Value& value)
+    {
+        queue.push(value);
+
+        // Only take the lock if there's a select waiting on this channel.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (selector_count.load(std::memory_order_relaxed) > 0)
+        {
+            wake_selectors();
+        }
+    }
+
+
+    Value Channel::pop()
+    {
+        return queue.pop();
+    }
+
+
+    Channel::Selection Channel::select(const std::vector<ChannelPtr>& channels, Timeout timeout)
+    {
+        if (channels.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto start = next_select_start++;
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+
+        if (timeout)
+        {
+            deadline = std::chrono::steady_clock::now() + *timeout;
+        }
+
+        auto try_receive = [&]() -> Selection
+            {
+                for (size_t i = 0; i < channels.size(); ++i)
+                {
+                    auto index = (start + i) % channels.size();
+                    Value value;
+
+                    if (channels[index]->queue.pop_ready(value))
+                    {
+                        return std::make_tuple(index, value);
+                    }
+                }
+
+                return std::nullopt;
+            };
+
+        while (true)
+        {
+            auto selection = try_receive();
+
+            if (selection)
+            {
+                return selection;
+            }
+
+            // Register with every channel, then check one last time before going to sleep.  A
+            // value pushed after our check will see that we're waiting and wake us up.
+            auto selector = std::make_shared<Selector>();
+
+            for (const auto& channel : channels)
+            {
+                channel->add_selector(selector);
+            }
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            selection = try_receive();
+
+            if (!selection)
+            {
+                std::unique_lock<std::mutex> lock(selector->lock);
+                auto is_signaled = [&selector]() { return selector->is_signaled; };
+
+                if (deadline)
+                {
+                    selector->condition.wait_until(lock, *deadline, is_signaled);
+                }
+                else
+                {
+                    selector->condition.wait(lock, is_signaled);
+                }
+            }
+
+            for (const auto& channel : channels)
+            {
+                channel->remove_selector(selector);
+            }
+
+            if (selection)
+            {
+                return selection;
+            }
+
+            // Another receiver may have beaten us to the value that woke us, so keep trying
+            // until the time runs out.
+            if (   (deadline)
+                && (std::chrono::steady_clock::now() >= *deadline))
+            {
+                return try_receive();
+            }
+        }
+    }
+
+
+    void Channel::add_selector(const SelectorPtr& selector)
+    {
+        std::lock_guard<std::mutex> lock(selector_lock);
+
+        selectors.push_back(selector);
+        selector_count.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+
+    void Channel::remove_selector(const SelectorPtr& selector)
+    {
+        std::lock_guard<std::mutex> lock(selector_lock);
+
+        std::erase(selectors, selector);
+        selector_count.store(selectors.size(), std::memory_order_seq_cst);
+    }
+
+
+    void Channel::wake_selectors()
+    {
+        std::lock_guard<std::mutex> lock(selector_lock);
+
+        for (auto& selector : selectors)
+        {
+            std::lock_guard<std::mutex> selector_guard(selector->lock);
+
+            selector->is_signaled = true;
+            selector->condition.notify_all();
+        }
+    }
+
+
+}
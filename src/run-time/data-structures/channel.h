@@ -0,0 +1,67 @@
+
+#pragma once
+
+
+namespace sorth
+{
+
+
+    // A channel is a bounded queue of values that any thread can send to or receive from.  Unlike
+    // a thread's own queues, a channel isn't tied to any one thread, and a receiver can wait on a
+    // whole group of channels at once with select.  This lets a single thread service many
+    // producers without polling each of them in turn.
+    class Channel
+    {
+        private:
+            // Used by select to sleep on a whole group of channels at once.
+            struct Selector;
+            using SelectorPtr = std::shared_ptr<Selector>;
+
+        public:
+            using Timeout = std::optional<std::chrono::milliseconds>;
+
+            // The index of the channel a value was received from and the value itself.
+            using Selection = std::optional<std::tuple<size_t, Value>>;
+
+        private:
+            BlockingValueQueue queue;
+
+            std::mutex selector_lock;
+            std::vector<SelectorPtr> selectors;
+            std::atomic<size_t> selector_count;
+
+        public:
+            Channel(size_t capacity = BlockingValueQueue::default_capacity);
+            Channel(const Channel& channel) = delete;
+            Channel(Channel&& channel) = delete;
+
+        public:
+            Channel& operator =(const Channel& channel) = delete;
+            Channel& operator =(Channel&& channel) = delete;
+
+        public:
+            int64_t depth();
+            size_t capacity() const;
+
+            void push(Value& value);
+            Value pop();
+
+        public:
+            // Wait for a value on any of the channels.  Each call starts looking at a different
+            // channel so that a busy channel can't starve the others.  If there's a timeout and it
+            // passes first, nothing is returned.
+            static Selection select(const std::vector<ChannelPtr>& channels,
+                                    Timeout timeout = std::nullopt);
+
+        private:
+            void add_selector(const SelectorPtr& selector);
+            void remove_selector(const SelectorPtr& selector);
+
+            void wake_selectors();
+    };
+
+
+    std::ostream& operator <<(std::ostream& stream, const ChannelPtr& channel);
+
+
+}
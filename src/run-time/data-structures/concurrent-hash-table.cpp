@@ -0,0 +1,194 @@
+#include "sorth.h"
+
+
+
+namespace sorth
+{
+
+
+    using namespace internal;
+
+
+    std::ostream& operator <<(std::ostream& stream, const ConcurrentHashTablePtr& table)
+    {
+        stream << table->snapshot();
+
+        return stream;
+    }
+
+
+    ConcurrentHashTable::ConcurrentHashTable()
+    : shards()
+    {
+    }
+
+
+    int64_t ConcurrentHashTable::size()
+    {
+        int64_t total = 0;
+
+        for (auto& shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.lock);
+
+            total += shard.items.size();
+        }
+
+        return total;
+    }
+
+
+    std::tuple<bool, Value> ConcurrentHashTable::get(const Value& key)
+    {
+        auto& shard = shard_for(key);
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+
+        auto iterator = shard.items.find(key);
+
+        if (iterator == shard.items.end())
+        {
+            return { false, Value() };
+        }
+
+        return { true, iterator->second };
+    }
+
+
+    void ConcurrentHashTable::insert(const Value& key, const Value& value)
+    {
+        auto& shard = shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+
+        shard.items.insert_or_assign(shareable(key), shareable(value));
+    }
+
+
+    bool ConcurrentHashTable::remove(const Value& key)
+    {
+        auto& shard = shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+
+        return shard.items.erase(key) > 0;
+    }
+
+
+    Value ConcurrentHashTable::get_or_insert(const Value& key, const Value& value)
+    {
+        auto& shard = shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+
+        auto iterator = shard.items.find(key);
+
+        if (iterator == shard.items.end())
+        {
+            iterator = shard.items.emplace(shareable(key), shareable(value)).first;
+        }
+
+        return iterator->second;
+    }
+
+
+    bool ConcurrentHashTable::compare_exchange(const Value& key,
+                                               const std::optional<Value>& expected,
+                                               const Value& desired)
+    {
+        auto& shard = shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+
+        auto iterator = shard.items.find(key);
+
+        if (!expected)
+        {
+            if (iterator != shard.items.end())
+            {
+                return false;
+            }
+
+            shard.items.emplace(shareable(key), shareable(desired));
+
+            return true;
+        }
+
+        // Containers are compared by identity, the stored value is frozen so it can only match
+        // the value that was read from the table, never a look-alike built by the caller.
+        if (   (iterator == shard.items.end())
+            || (!iterator->second.is_same(*expected)))
+        {
+            return false;
+        }
+
+        iterator->second = shareable(desired);
+
+        return true;
+    }
+
+
+    Value ConcurrentHashTable::add(const InterpreterPtr& interpreter,
+                                   const Value& key,
+                                   const Value& amount)
+    {
+        auto& shard = shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+
+        auto [ iterator, inserted ] = shard.items.try_emplace(shareable(key), (int64_t)0);
+        auto& total = iterator->second;
+
+        if (Value::either_is_float(total, amount))
+        {
+            total = total.as_float(interpreter) + amount.as_float(interpreter);
+        }
+        else
+        {
+            total = total.as_integer(interpreter) + amount.as_integer(interpreter);
+        }
+
+        return total;
+    }
+
+
+    HashTablePtr ConcurrentHashTable::snapshot()
+    {
+        auto table = std::make_shared<HashTable>();
+
+        for (auto& shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.lock);
+
+            for (const auto& [ key, value ] : shard.items)
+            {
+                table->insert(key, value);
+            }
+        }
+
+        return table;
+    }
+
+
+    Value ConcurrentHashTable::shareable(const Value& value)
+    {
+        if (value.is_frozen())
+        {
+            return value;
+        }
+
+        auto copy = value.deep_copy();
+
+        copy.freeze();
+
+        return copy;
+    }
+
+
+    ConcurrentHashTable::Shard& ConcurrentHashTable::shard_for(const Value& key)
+    {
+        // Mix the upper bits of the hash in, as some of the value hashes are poor in the lower
+        // ones.
+        auto hash = key.hash();
+
+        hash ^= hash >> 17;
+
+        return shards[hash & (shard_count - 1)];
+    }
+
+
+}
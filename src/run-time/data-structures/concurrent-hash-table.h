@@ -0,0 +1,77 @@
+#pragma once
+
+
+namespace sorth
+{
+
+
+    // A hash table that can be safely shared between threads.  The table is split into shards,
+    // each with it's own lock, so that threads working on different keys rarely wait on each
+    // other.  Reads only take a shared lock on their shard.
+    //
+    // Unlike the regular hash table, the concurrent table is always passed by reference, even
+    // between threads, so that every thread sees the same data.  The keys and values it holds
+    // are shared the same way, so anything that isn't frozen already is stored as a frozen copy.
+    // The caller's own value is left as it was.
+    class ConcurrentHashTable
+    {
+        private:
+            // The number of shards, a power of two so that a key's shard can be found with a mask.
+            static constexpr size_t shard_count = 64;
+
+            // Keep each shard on it's own cache line so that threads working on neighbouring
+            // shards aren't fighting over the same line.
+            struct alignas(64) Shard
+            {
+                std::shared_mutex lock;
+                std::unordered_map<Value, Value> items;
+            };
+
+        private:
+            std::array<Shard, shard_count> shards;
+
+        public:
+            ConcurrentHashTable();
+            ConcurrentHashTable(const ConcurrentHashTable& table) = delete;
+            ConcurrentHashTable(ConcurrentHashTable&& table) = delete;
+
+        public:
+            ConcurrentHashTable& operator =(const ConcurrentHashTable& table) = delete;
+            ConcurrentHashTable& operator =(ConcurrentHashTable&& table) = delete;
+
+        public:
+            int64_t size();
+
+            std::tuple<bool, Value> get(const Value& key);
+            void insert(const Value& key, const Value& value);
+            bool remove(const Value& key);
+
+            // Get the key's value, inserting the given value first if the key isn't in the table
+            // yet.  Either way the lookup and insert happen as one step.
+            Value get_or_insert(const Value& key, const Value& value);
+
+            // Replace the key's value only if it still matches the expected one.  No expected
+            // value means that the key is expected to not be in the table yet.
+            bool compare_exchange(const Value& key,
+                                  const std::optional<Value>& expected,
+                                  const Value& desired);
+
+            // Add to the numeric value of the key, treating a missing key as zero, and return the
+            // new total.
+            Value add(const InterpreterPtr& interpreter, const Value& key, const Value& amount);
+
+            // Take a copy of the table's contents as a regular hash table.
+            HashTablePtr snapshot();
+
+        private:
+            // Get a version of the value that's safe to hand out to every thread.
+            static Value shareable(const Value& value);
+
+            Shard& shard_for(const Value& key);
+    };
+
+
+    std::ostream& operator <<(std::ostream& stream, const ConcurrentHashTablePtr& table);
+
+
+}
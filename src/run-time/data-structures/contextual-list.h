@@ -1,4 +1,3 @@
-
 #pragma once
 
 
@@ -6,10 +5,110 @@ namespace sorth::internal
 {
 
 
+    // Identifies what a list or dictionary holds.  Every change gives the container a version that
+    // no other container will ever have, and a copy keeps the version of the original until one of
+    // them is changed.  So two containers with the same version are guaranteed to hold the same
+    // items.
+    class ContentVersion
+    {
+        public:
+            // The version of the contents at one point in time.
+            struct Stamp
+            {
+                uint64_t owner;
+                uint64_t change;
+
+                bool operator ==(const Stamp& stamp) const = default;
+            };
+
+        private:
+            // Each container numbers it's own changes.  It takes a new id from the shared counter
+            // when it's created or copied, so the counter is only touched once per clone instead
+            // of once per change.
+            uint64_t id;
+            uint64_t changes;
+
+            // The id and change number of the current contents.
+            uint64_t owner;
+            uint64_t change;
+
+            static inline std::atomic<uint64_t> next_id = 0;
+
+        public:
+            ContentVersion()
+            : id(++next_id),
+              changes(0),
+              owner(id),
+              change(0)
+            {
+            }
+
+            ContentVersion(const ContentVersion& version)
+            : id(++next_id),
+              changes(0),
+              owner(version.owner),
+              change(version.change)
+            {
+            }
+
+        public:
+            ContentVersion& operator =(const ContentVersion& version)
+            {
+                if (this != &version)
+                {
+                    id = ++next_id;
+                    changes = 0;
+                    owner = version.owner;
+                    change = version.change;
+                }
+
+                return *this;
+            }
+
+            bool operator ==(const ContentVersion& version) const
+            {
+                return stamp() == version.stamp();
+            }
+
+        public:
+            Stamp stamp() const
+            {
+                return { .owner = owner, .change = change };
+            }
+
+            // Record that the container's contents have changed.
+            void touch()
+            {
+                owner = id;
+                change = ++changes;
+            }
+
+            // Go back to an earlier version, once every change made since has been undone.  Later
+            // changes still get numbers of their own, as our change count only goes up.
+            void restore(const Stamp& stamp)
+            {
+                owner = stamp.owner;
+                change = stamp.change;
+            }
+    };
+
+
     // The contextual list allows the interpreter to keep track of various contexts or scopes.
     // Variables and other forms of data are kept track of by indexable lists.  The idea being that
     // the list can expand as new items are added.  We extend this concept with contexts or scopes
     // that when a given context is exited, all values in that context are forgotten.
+    //
+    // Copies of a list share their contexts with the original.  A shared context is only copied
+    // when one of the lists writes to it, so cloning an interpreter doesn't cost time proportional
+    // to the size of the loaded library.
+    //
+    // Copying a list marks it's contexts as shared in both lists, and once shared they're never
+    // written to in place again.  Going by the shared_ptr's use count instead would race with
+    // other threads that are still letting go of their copies.
+    //
+    // Releasing a context puts the list's version back to what it was when the context was marked,
+    // unless something outside of the context was written to in the meantime.  So calling a word
+    // doesn't count as a change.
 
     template <typename value_type>
     class ContextualList
@@ -21,44 +120,83 @@ namespace sorth::internal
                 size_t start_index;
             };
 
-            using ListStack = std::list<SubList>;
+            using SubListPtr = std::shared_ptr<SubList>;
+
+            struct Context
+            {
+                SubListPtr sub_list;
+
+                // Is this list the only one that can see the context?  Once cleared it's never
+                // set again.  Several threads can copy the same list at once, so it's cleared
+                // atomically, the sub-list itself isn't touched by the copies.
+                mutable std::atomic<bool> is_owned;
+
+                // The list's version from before the context was marked, and the lowest index
+                // that's been written to since.
+                ContentVersion::Stamp marked_version;
+                size_t lowest_write;
+
+                Context(const SubListPtr& new_sub_list,
+                        const ContentVersion::Stamp& new_marked_version)
+                : sub_list(new_sub_list),
+                  is_owned(true),
+                  marked_version(new_marked_version),
+                  lowest_write(std::numeric_limits<size_t>::max())
+                {
+                }
+
+                Context(const Context& context)
+                : sub_list(context.sub_list),
+                  is_owned(context.is_owned.load(std::memory_order_relaxed)),
+                  marked_version(context.marked_version),
+                  lowest_write(context.lowest_write)
+                {
+                }
+            };
+
+            using ListStack = std::list<Context>;
 
             ListStack stack;
+            ContentVersion current_version;
 
         public:
             ContextualList()
+            : stack(),
+              current_version()
             {
                 // Make sure we have an empty list ready to be populated.
                 mark_context();
             }
 
             ContextualList(const ContextualList& list)
+            : stack(list.share_contexts()),
+              current_version(list.current_version)
             {
-                // Crate a empty list.
-                mark_context();
-
-                // Merge the contexts from the source list into a single context here.
-                for (auto iter = list.stack.rbegin(); iter != list.stack.rend(); ++iter)
-                {
-                    stack.front().items.insert(stack.front().items.end(),
-                                               iter->items.begin(),
-                                               iter->items.end());
-                }
             }
 
+        public:
+            ContextualList& operator =(const ContextualList& list) = delete;
+
         public:
             size_t size() const
             {
-                return stack.front().start_index + stack.front().items.size();
+                return stack.front().sub_list->start_index + stack.front().sub_list->items.size();
+            }
+
+            const ContentVersion& version() const
+            {
+                return current_version;
             }
 
             size_t insert(const value_type& value)
             {
-                stack.front().items.push_back(value);
+                writable(stack.front()).items.push_back(value);
+                touch();
+
                 return size() - 1;
             }
 
-            value_type& operator [](size_t index)
+            const value_type& operator [](size_t index) const
             {
                 if (index >= size())
                 {
@@ -67,10 +205,35 @@ namespace sorth::internal
 
                 for (auto stack_iter = stack.begin(); stack_iter != stack.end(); ++stack_iter)
                 {
-                    if (index >= stack_iter->start_index)
+                    if (index >= stack_iter->sub_list->start_index)
                     {
-                        index -= stack_iter->start_index;
-                        return stack_iter->items[index];
+                        index -= stack_iter->sub_list->start_index;
+                        return stack_iter->sub_list->items[index];
+                    }
+                }
+
+                throw_error("Index not found.");
+            }
+
+            void set(size_t index, const value_type& value)
+            {
+                if (index >= size())
+                {
+                    throw_error("Index out of range.");
+                }
+
+                auto& top = stack.front();
+                top.lowest_write = std::min(top.lowest_write, index);
+
+                for (auto stack_iter = stack.begin(); stack_iter != stack.end(); ++stack_iter)
+                {
+                    if (index >= stack_iter->sub_list->start_index)
+                    {
+                        index -= stack_iter->sub_list->start_index;
+                        writable(*stack_iter).items[index] = value;
+                        touch();
+
+                        return;
                     }
                 }
 
@@ -84,15 +247,67 @@ namespace sorth::internal
 
                 if (!stack.empty())
                 {
-                    start_index = stack.front().start_index + stack.front().items.size();
+                    start_index = size();
                 }
 
-                stack.push_front({ .items = {}, .start_index = start_index });
+                auto sub_list = std::make_shared<SubList>(SubList { .items = {},
+                                                                    .start_index = start_index });
+
+                stack.emplace_front(sub_list, current_version.stamp());
+                touch();
             }
 
             void release_context()
             {
+                auto start_index = stack.front().sub_list->start_index;
+                auto lowest_write = stack.front().lowest_write;
+                auto marked_version = stack.front().marked_version;
+
                 stack.pop_front();
+
+                if (lowest_write >= start_index)
+                {
+                    // Everything that changed went away with the context.
+                    current_version.restore(marked_version);
+                }
+                else
+                {
+                    // The outer contexts were written to, let them know for when they're released.
+                    auto& top = stack.front();
+
+                    top.lowest_write = std::min(top.lowest_write, lowest_write);
+                    touch();
+                }
+            }
+
+        private:
+            void touch()
+            {
+                current_version.touch();
+            }
+
+            // Mark all of our contexts as shared, and return them for a new copy of the list.
+            ListStack share_contexts() const
+            {
+                for (auto& context : stack)
+                {
+                    context.is_owned.store(false, std::memory_order_relaxed);
+                }
+
+                return stack;
+            }
+
+            // Get a context we can write to, making our own copy of it first if it has ever been
+            // shared with another list.
+            static SubList& writable(Context& context)
+            {
+                if (!context.is_owned.load(std::memory_order_relaxed))
+                {
+                    context.sub_list = std::make_shared<SubList>(*context.sub_list);
+                    context.is_owned.store(true, std::memory_order_relaxed);
+                }
+
+                return *context.sub_list;
             }
     };
 
@@ -28,7 +28,7 @@ namespace sorth
     using DefinitionList = internal::ContextualList<DataObjectDefinitionPtr>;
 
 
-    struct DataObject
+    struct DataObject : public Freezable
     {
         DataObjectDefinitionPtr definition;  // Reference of the base definition.
         ValueList fields;                    // The actual values of the structure.
@@ -62,7 +62,26 @@ namespace sorth::internal
     }
 
 
+    Dictionary::Context::Context(const SubDictionaryPtr& new_sub_dictionary,
+                                 const ContentVersion::Stamp& new_marked_version)
+    : sub_dictionary(new_sub_dictionary),
+      is_owned(true),
+      marked_version(new_marked_version)
+    {
+    }
+
+
+    Dictionary::Context::Context(const Context& context)
+    : sub_dictionary(context.sub_dictionary),
+      is_owned(context.is_owned.load(std::memory_order_relaxed)),
+      marked_version(context.marked_version)
+    {
+    }
+
+
     Dictionary::Dictionary()
+    : stack(),
+      current_version()
     {
         // Start with an empty dictionary.
         mark_context();
@@ -70,21 +89,32 @@ namespace sorth::internal
 
 
     Dictionary::Dictionary(const Dictionary& dictionary)
+    : stack(dictionary.share_contexts()),
+      current_version(dictionary.current_version)
     {
-        // start with the empty dictionary.
-        mark_context();
+        // Share the other dictionary's sub-dictionaries, they're copied if either of us writes to
+        // them.
+    }
 
-        // Now merge all the sub dictionaries into this one.
-        for (auto iter = dictionary.stack.rbegin(); iter != dictionary.stack.rend(); ++iter)
-        {
-            stack.front().insert(iter->begin(), iter->end());
-        }
+
+    const ContentVersion& Dictionary::version() const
+    {
+        return current_version;
     }
 
 
     void Dictionary::insert(const std::string& text, const Word& value)
     {
-        auto& current_dictionary = stack.front();
+        // Make our own copy of the current sub-dictionary if it's ever been shared.
+        auto& context = stack.front();
+
+        if (!context.is_owned.load(std::memory_order_relaxed))
+        {
+            context.sub_dictionary = std::make_shared<SubDictionary>(*context.sub_dictionary);
+            context.is_owned.store(true, std::memory_order_relaxed);
+        }
+
+        auto& current_dictionary = *context.sub_dictionary;
         auto iter = current_dictionary.find(text);
 
         if (iter != current_dictionary.end())
@@ -95,6 +125,8 @@ namespace sorth::internal
         {
             current_dictionary.insert(SubDictionary::value_type(text, value));
         }
+
+        touch();
     }
 
 
@@ -102,9 +134,9 @@ namespace sorth::internal
     {
         for (auto stack_iter = stack.begin(); stack_iter != stack.end(); ++stack_iter)
         {
-            auto iter = stack_iter->find(word);
+            auto iter = stack_iter->sub_dictionary->find(word);
 
-            if (iter != stack_iter->end())
+            if (iter != stack_iter->sub_dictionary->end())
             {
                 return { true, iter->second };
             }
@@ -117,12 +149,14 @@ namespace sorth::internal
     void Dictionary::mark_context()
     {
         // Create a new dictionary.
-        stack.push_front({});
+        stack.emplace_front(std::make_shared<SubDictionary>(), current_version.stamp());
+        touch();
     }
 
 
     void Dictionary::release_context()
     {
+        current_version.restore(stack.front().marked_version);
         stack.pop_front();
 
         // There should always be at least one dictionary.  If there isn't something has
@@ -135,9 +169,9 @@ namespace sorth::internal
     {
         std::map<std::string, Word> new_dictionary;
 
-        for (const auto& sub_dictionary : stack)
+        for (const auto& context : stack)
         {
-            for (const auto& word_iter : sub_dictionary)
+            for (const auto& word_iter : *context.sub_dictionary)
             {
                 new_dictionary.insert(word_iter);
             }
@@ -147,4 +181,23 @@ namespace sorth::internal
     }
 
 
+    Dictionary::DictionaryStack Dictionary::share_contexts() const
+    {
+        // Several threads can copy the same unchanging dictionary at once, so the flags are
+        // cleared atomically.
+        for (auto& context : stack)
+        {
+            context.is_owned.store(false, std::memory_order_relaxed);
+        }
+
+        return stack;
+    }
+
+
+    void Dictionary::touch()
+    {
+        current_version.touch();
+    }
+
+
 }
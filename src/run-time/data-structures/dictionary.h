@@ -50,6 +50,21 @@ namespace sorth::internal
     };
 
 
+    // In JIT mode, how should a script defined word be executed?
+    enum class WordJitPolicy
+    {
+        // Let the JIT decide.  Run-time words are compiled with their script, immediate words are
+        // interpreted until they've been called often enough to be worth compiling.
+        automatic,
+
+        // Always JIT compile the word, immediate words are compiled as soon as they're defined.
+        always,
+
+        // Never JIT compile the word, it's byte-code is always interpreted.
+        never
+    };
+
+
     struct Word
     {
         // Should this word be executed at compile or at run-time?
@@ -84,19 +99,45 @@ namespace sorth::internal
     // Also note that the dictionary is implemented as a stack of dictionaries.  This allows the
     // Forth to contain scopes.  If a word is redefined in a higher scope, it effectively replaces
     // that word until that scope is released.
+    //
+    // Like the contextual list, copies of a dictionary share their sub-dictionaries until one of
+    // them is written to, and each change gives the dictionary a new version number.
     class Dictionary
     {
         private:
             using SubDictionary = std::unordered_map<std::string, Word>;
-            using DictionaryStack = std::list<SubDictionary>;
+            using SubDictionaryPtr = std::shared_ptr<SubDictionary>;
+
+            // Like the contextual list's contexts, a sub-dictionary that's ever been shared with
+            // a copy is never written to in place again.  Words are only ever added to the top
+            // sub-dictionary, so releasing a context always puts back the version from before it
+            // was marked.
+            struct Context
+            {
+                SubDictionaryPtr sub_dictionary;
+                mutable std::atomic<bool> is_owned;
+                ContentVersion::Stamp marked_version;
+
+                Context(const SubDictionaryPtr& new_sub_dictionary,
+                        const ContentVersion::Stamp& new_marked_version);
+                Context(const Context& context);
+            };
+
+            using DictionaryStack = std::list<Context>;
 
             DictionaryStack stack;
+            ContentVersion current_version;
 
         public:
             Dictionary();
             Dictionary(const Dictionary& dictionary);
 
         public:
+            Dictionary& operator =(const Dictionary& dictionary) = delete;
+
+        public:
+            const ContentVersion& version() const;
+
             void insert(const std::string& text, const Word& value);
             std::tuple<bool, Word> find(const std::string& word) const;
 
@@ -107,6 +148,10 @@ namespace sorth::internal
         public:
             std::map<std::string, Word> get_merged_dictionary() const;
 
+        private:
+            DictionaryStack share_contexts() const;
+            void touch();
+
         protected:
             friend std::ostream& operator <<(std::ostream& stream, const Dictionary& dictionary);
     };
@@ -0,0 +1,19 @@
+
+#include "sorth.h"
+
+
+
+namespace sorth
+{
+
+
+    void Freezable::throw_if_frozen(const InterpreterPtr& interpreter) const
+    {
+        if (is_frozen())
+        {
+            internal::throw_error(interpreter, "Can not modify a frozen value.");
+        }
+    }
+
+
+}
@@ -0,0 +1,51 @@
+
+#pragma once
+
+
+namespace sorth
+{
+
+
+    // Base for the values that can be frozen.  Once frozen a value can't be changed again, which
+    // makes it safe to share between threads by reference instead of copying it.  Copies of a
+    // frozen value start out unfrozen, so value.copy is the way to get a mutable version back.
+    class Freezable
+    {
+        private:
+            std::atomic<bool> frozen;
+
+        public:
+            Freezable()
+            : frozen(false)
+            {
+            }
+
+            Freezable(const Freezable&)
+            : frozen(false)
+            {
+            }
+
+            Freezable& operator =(const Freezable&)
+            {
+                // Assigning new contents doesn't change whether we can be modified.
+                return *this;
+            }
+
+        public:
+            bool is_frozen() const
+            {
+                return frozen.load(std::memory_order_acquire);
+            }
+
+            // Mark this value as frozen, returns false if it already was.
+            bool freeze()
+            {
+                return !frozen.exchange(true, std::memory_order_acq_rel);
+            }
+
+            // Raise an error if anything tries to change a frozen value.
+            void throw_if_frozen(const InterpreterPtr& interpreter) const;
+    };
+
+
+}
@@ -0,0 +1,198 @@
+
+#include "sorth.h"
+
+
+
+namespace sorth
+{
+
+
+    struct Future::Waiter
+    {
+        std::mutex lock;
+        std::condition_variable condition;
+        bool is_signaled = false;
+    };
+
+
+    std::ostream& operator <<(std::ostream& stream, const FuturePtr& future)
+    {
+        stream << "<future " << (future->is_ready() ? "complete" : "pending") << ">";
+
+        return stream;
+    }
+
+
+    Future::Future()
+    : item_lock(),
+      condition(),
+      is_complete(false),
+      result(),
+      error(),
+      waiters()
+    {
+    }
+
+
+    bool Future::is_ready() const
+    {
+        return is_complete.load(std::memory_order_acquire);
+    }
+
+
+    void Future::set_value(const Value& value)
+    {
+        std::lock_guard<std::mutex> lock(item_lock);
+
+        result = value;
+        complete();
+    }
+
+
+    void Future::set_error(const std::string& message)
+    {
+        std::lock_guard<std::mutex> lock(item_lock);
+
+        error = message;
+        complete();
+    }
+
+
+    void Future::wait()
+    {
+        if (is_ready())
+        {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(item_lock);
+
+        condition.wait(lock, [this]() { return is_ready(); });
+    }
+
+
+    bool Future::wait_for(std::chrono::milliseconds timeout)
+    {
+        if (is_ready())
+        {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(item_lock);
+
+        return condition.wait_for(lock, timeout, [this]() { return is_ready(); });
+    }
+
+
+    Value Future::get()
+    {
+        wait();
+
+        if (error)
+        {
+            internal::throw_error(*error);
+        }
+
+        return result;
+    }
+
+
+    std::optional<size_t> Future::wait_any(const std::vector<FuturePtr>& futures, Timeout timeout)
+    {
+        // Check for a completed future before we go through the trouble of registering with all
+        // of them.
+        for (size_t i = 0; i < futures.size(); ++i)
+        {
+            if (futures[i]->is_ready())
+            {
+                return i;
+            }
+        }
+
+        if (futures.empty())
+        {
+            return std::nullopt;
+        }
+
+        // Register with every future, any one of them completing will wake us up.
+        auto waiter = std::make_shared<Waiter>();
+
+        for (const auto& future : futures)
+        {
+            future->add_waiter(waiter);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(waiter->lock);
+            auto is_signaled = [&waiter]() { return waiter->is_signaled; };
+
+            if (timeout)
+            {
+                waiter->condition.wait_for(lock, *timeout, is_signaled);
+            }
+            else
+            {
+                waiter->condition.wait(lock, is_signaled);
+            }
+        }
+
+        for (const auto& future : futures)
+        {
+            future->remove_waiter(waiter);
+        }
+
+        for (size_t i = 0; i < futures.size(); ++i)
+        {
+            if (futures[i]->is_ready())
+            {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+
+    // Called with the item lock held, once the result or error has been set.
+    void Future::complete()
+    {
+        is_complete.store(true, std::memory_order_release);
+        condition.notify_all();
+
+        for (auto& waiter : waiters)
+        {
+            std::lock_guard<std::mutex> lock(waiter->lock);
+
+            waiter->is_signaled = true;
+            waiter->condition.notify_all();
+        }
+
+        waiters.clear();
+    }
+
+
+    void Future::add_waiter(const WaiterPtr& waiter)
+    {
+        std::lock_guard<std::mutex> lock(item_lock);
+
+        if (is_ready())
+        {
+            std::lock_guard<std::mutex> waiter_lock(waiter->lock);
+
+            waiter->is_signaled = true;
+            return;
+        }
+
+        waiters.push_back(waiter);
+    }
+
+
+    void Future::remove_waiter(const WaiterPtr& waiter)
+    {
+        std::lock_guard<std::mutex> lock(item_lock);
+
+        std::erase(waiters, waiter);
+    }
+
+
+}
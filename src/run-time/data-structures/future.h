@@ -0,0 +1,75 @@
+
+#pragma once
+
+
+namespace sorth
+{
+
+
+    // The eventual result of a word running on another thread.  The future is completed exactly
+    // once, either with the value the word left on the top of it's stack, or with the message of
+    // the error that stopped it.
+    class Future
+    {
+        public:
+            using Timeout = std::optional<std::chrono::milliseconds>;
+
+        private:
+            // Used by wait_any to sleep on a whole group of futures at once.
+            struct Waiter;
+            using WaiterPtr = std::shared_ptr<Waiter>;
+
+        private:
+            std::mutex item_lock;
+            std::condition_variable condition;
+
+            std::atomic<bool> is_complete;
+            Value result;
+            std::optional<std::string> error;
+
+            std::vector<WaiterPtr> waiters;
+
+        public:
+            Future();
+            Future(const Future& future) = delete;
+            Future(Future&& future) = delete;
+
+        public:
+            Future& operator =(const Future& future) = delete;
+            Future& operator =(Future&& future) = delete;
+
+        public:
+            bool is_ready() const;
+
+            void set_value(const Value& value);
+            void set_error(const std::string& message);
+
+            // Block until the future has been completed.
+            void wait();
+
+            // Block until the future has been completed or the timeout has passed.  Returns true
+            // if the future was completed.
+            bool wait_for(std::chrono::milliseconds timeout);
+
+            // Wait for the future and get it's value.  If the word failed it's error is rethrown,
+            // with the location and call stack of where it originally happened.
+            Value get();
+
+        public:
+            // Wait for the first of the futures to complete and return it's index.  If there's a
+            // timeout and it passes first, nothing is returned.
+            static std::optional<size_t> wait_any(const std::vector<FuturePtr>& futures,
+                                                  Timeout timeout = std::nullopt);
+
+        private:
+            void complete();
+
+            void add_waiter(const WaiterPtr& waiter);
+            void remove_waiter(const WaiterPtr& waiter);
+    };
+
+
+    std::ostream& operator <<(std::ostream& stream, const FuturePtr& future);
+
+
+}
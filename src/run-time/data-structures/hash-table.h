@@ -6,7 +6,7 @@ namespace sorth
 {
 
 
-    class HashTable
+    class HashTable : public Freezable
     {
         private:
             std::unordered_map<Value, Value> items;
@@ -0,0 +1,18 @@
+
+#include "sorth.h"
+
+
+
+namespace sorth
+{
+
+
+    std::ostream& operator <<(std::ostream& stream, const ThreadHandlePtr& handle)
+    {
+        stream << "<thread " << handle->id << ">";
+
+        return stream;
+    }
+
+
+}
@@ -0,0 +1,31 @@
+
+#pragma once
+
+
+namespace sorth
+{
+
+
+    // A handle to an interpreter thread.  The handle points straight at the thread's queues so
+    // that messages can be passed to and from the thread without looking it up in the
+    // interpreter's thread list.  Handles are ordinary values, so they can be passed to other
+    // threads to wire them together into pipelines.
+    struct ThreadHandle
+    {
+        // The id of the thread the handle refers to.
+        std::thread::id id;
+
+        // The thread's input and output queues.
+        BlockingValueQueuePtr inputs;
+        BlockingValueQueuePtr outputs;
+
+        // Completed with the value the word leaves on the top of the stack when the thread exits,
+        // or the error that stopped it.
+        FuturePtr result;
+    };
+
+
+    std::ostream& operator <<(std::ostream& stream, const ThreadHandlePtr& handle);
+
+
+}
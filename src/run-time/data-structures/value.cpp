@@ -96,6 +96,22 @@ namespace sorth
         {
             stream << std::get<internal::ByteCode>(value.value);
         }
+        else if (std::holds_alternative<FuturePtr>(value.value))
+        {
+            stream << std::get<FuturePtr>(value.value);
+        }
+        else if (std::holds_alternative<ThreadHandlePtr>(value.value))
+        {
+            stream << std::get<ThreadHandlePtr>(value.value);
+        }
+        else if (std::holds_alternative<ChannelPtr>(value.value))
+        {
+            stream << std::get<ChannelPtr>(value.value);
+        }
+        else if (std::holds_alternative<ConcurrentHashTablePtr>(value.value))
+        {
+            stream << std::get<ConcurrentHashTablePtr>(value.value);
+        }
         else
         {
             stream << "<unknown-value-type>";
@@ -164,6 +180,27 @@ namespace sorth
             return std::get<HashTablePtr>(lhs.value) <=> std::get<HashTablePtr>(rhs.value);
         }
 
+        if (std::holds_alternative<FuturePtr>(lhs.value))
+        {
+            return std::get<FuturePtr>(lhs.value) <=> std::get<FuturePtr>(rhs.value);
+        }
+
+        if (std::holds_alternative<ThreadHandlePtr>(lhs.value))
+        {
+            return std::get<ThreadHandlePtr>(lhs.value) <=> std::get<ThreadHandlePtr>(rhs.value);
+        }
+
+        if (std::holds_alternative<ChannelPtr>(lhs.value))
+        {
+            return std::get<ChannelPtr>(lhs.value) <=> std::get<ChannelPtr>(rhs.value);
+        }
+
+        if (std::holds_alternative<ConcurrentHashTablePtr>(lhs.value))
+        {
+            return   std::get<ConcurrentHashTablePtr>(lhs.value)
+                 <=> std::get<ConcurrentHashTablePtr>(rhs.value);
+        }
+
         return std::get<ByteBufferPtr>(lhs.value) <=> std::get<ByteBufferPtr>(rhs.value);
     }
 
@@ -255,6 +292,30 @@ namespace sorth
     }
 
 
+    Value::Value(const FuturePtr& value) noexcept
+    : value(value)
+    {
+    }
+
+
+    Value::Value(const ThreadHandlePtr& value) noexcept
+    : value(value)
+    {
+    }
+
+
+    Value::Value(const ChannelPtr& value) noexcept
+    : value(value)
+    {
+    }
+
+
+    Value::Value(const ConcurrentHashTablePtr& value) noexcept
+    : value(value)
+    {
+    }
+
+
     Value& Value::operator =(const None& none) noexcept
     {
         value = none;
@@ -350,18 +411,163 @@ namespace sorth
     }
 
 
+    Value& Value::operator =(const FuturePtr& new_value) noexcept
+    {
+        value = new_value;
+        return *this;
+    }
+
+
+    Value& Value::operator =(const ThreadHandlePtr& new_value) noexcept
+    {
+        value = new_value;
+        return *this;
+    }
+
+
+    Value& Value::operator =(const ChannelPtr& new_value) noexcept
+    {
+        value = new_value;
+        return *this;
+    }
+
+
+    Value& Value::operator =(const ConcurrentHashTablePtr& new_value) noexcept
+    {
+        value = new_value;
+        return *this;
+    }
+
+
     Value::operator bool() const noexcept
     {
         return as_bool();
     }
 
 
+    void Value::freeze() const
+    {
+        // Stop at anything that's already frozen, it's contents were frozen along with it.  This
+        // also keeps us from going in circles if the values refer to each other.
+        if (std::holds_alternative<ArrayPtr>(value))
+        {
+            auto& array = *std::get<ArrayPtr>(value);
+
+            if (array.freeze())
+            {
+                for (size_t i = 0; i < array.size(); ++i)
+                {
+                    array[i].freeze();
+                }
+            }
+        }
+        else if (std::holds_alternative<DataObjectPtr>(value))
+        {
+            auto& structure = *std::get<DataObjectPtr>(value);
+
+            if (structure.freeze())
+            {
+                for (const auto& field : structure.fields)
+                {
+                    field.freeze();
+                }
+            }
+        }
+        else if (std::holds_alternative<HashTablePtr>(value))
+        {
+            auto& table = *std::get<HashTablePtr>(value);
+
+            if (table.freeze())
+            {
+                for (const auto& [ key, value ] : table.get_items())
+                {
+                    key.freeze();
+                    value.freeze();
+                }
+            }
+        }
+        else if (std::holds_alternative<ByteBufferPtr>(value))
+        {
+            std::get<ByteBufferPtr>(value)->freeze();
+        }
+    }
+
+
+    bool Value::is_frozen() const
+    {
+        if (std::holds_alternative<ArrayPtr>(value))
+        {
+            return std::get<ArrayPtr>(value)->is_frozen();
+        }
+
+        if (std::holds_alternative<DataObjectPtr>(value))
+        {
+            return std::get<DataObjectPtr>(value)->is_frozen();
+        }
+
+        if (std::holds_alternative<HashTablePtr>(value))
+        {
+            return std::get<HashTablePtr>(value)->is_frozen();
+        }
+
+        if (std::holds_alternative<ByteBufferPtr>(value))
+        {
+            return std::get<ByteBufferPtr>(value)->is_frozen();
+        }
+
+        // Everything else is either immutable to begin with, or is meant to be shared and changed
+        // between threads.
+        return    (!std::holds_alternative<ConcurrentHashTablePtr>(value))
+               && (!std::holds_alternative<ChannelPtr>(value));
+    }
+
+
+    bool Value::is_same(const Value& other) const noexcept
+    {
+        if (value.index() != other.value.index())
+        {
+            return false;
+        }
+
+        if (std::holds_alternative<DataObjectPtr>(value))
+        {
+            return   std::get<DataObjectPtr>(value).get()
+                  == std::get<DataObjectPtr>(other.value).get();
+        }
+
+        if (std::holds_alternative<ArrayPtr>(value))
+        {
+            return   std::get<ArrayPtr>(value).get()
+                  == std::get<ArrayPtr>(other.value).get();
+        }
+
+        if (std::holds_alternative<HashTablePtr>(value))
+        {
+            return   std::get<HashTablePtr>(value).get()
+                  == std::get<HashTablePtr>(other.value).get();
+        }
+
+        if (std::holds_alternative<ByteBufferPtr>(value))
+        {
+            return   std::get<ByteBufferPtr>(value).get()
+                  == std::get<ByteBufferPtr>(other.value).get();
+        }
+
+        return *this == other;
+    }
+
+
     Value Value::deep_copy() const
     {
         if (std::holds_alternative<ArrayPtr>(value))
         {
             auto array = std::get<ArrayPtr>(value);
-            auto new_array = std::make_shared<Array>(*array);
+            auto new_array = std::make_shared<Array>(array->size());
+
+            for (size_t i = 0; i < array->size(); ++i)
+            {
+                (*new_array)[i] = (*array)[i].deep_copy();
+            }
 
             return new_array;
         }
@@ -397,7 +603,7 @@ namespace sorth
             auto byte_buffer = std::get<ByteBufferPtr>(value);
             auto new_byte_buffer = std::make_shared<ByteBuffer>(*byte_buffer);
 
-            return byte_buffer;
+            return new_byte_buffer;
         }
 
         return Value(*this);
@@ -496,6 +702,30 @@ namespace sorth
     }
 
 
+    bool Value::is_future() const noexcept
+    {
+        return std::holds_alternative<FuturePtr>(value);
+    }
+
+
+    bool Value::is_thread_handle() const noexcept
+    {
+        return std::holds_alternative<ThreadHandlePtr>(value);
+    }
+
+
+    bool Value::is_channel() const noexcept
+    {
+        return std::holds_alternative<ChannelPtr>(value);
+    }
+
+
+    bool Value::is_concurrent_hash_table() const noexcept
+    {
+        return std::holds_alternative<ConcurrentHashTablePtr>(value);
+    }
+
+
     bool Value::either_is_string(const Value& a, const Value& b) noexcept
     {
         return a.is_string() || b.is_string();
@@ -721,6 +951,50 @@ namespace sorth
     }
 
 
+    FuturePtr Value::as_future(const InterpreterPtr& interpreter) const
+    {
+        if (!std::holds_alternative<FuturePtr>(value))
+        {
+            throw_error(interpreter, "Expected future value.");
+        }
+
+        return std::get<FuturePtr>(value);
+    }
+
+
+    ThreadHandlePtr Value::as_thread_handle(const InterpreterPtr& interpreter) const
+    {
+        if (!std::holds_alternative<ThreadHandlePtr>(value))
+        {
+            throw_error(interpreter, "Expected thread handle value.");
+        }
+
+        return std::get<ThreadHandlePtr>(value);
+    }
+
+
+    ChannelPtr Value::as_channel(const InterpreterPtr& interpreter) const
+    {
+        if (!std::holds_alternative<ChannelPtr>(value))
+        {
+            throw_error(interpreter, "Expected channel value.");
+        }
+
+        return std::get<ChannelPtr>(value);
+    }
+
+
+    ConcurrentHashTablePtr Value::as_concurrent_hash_table(const InterpreterPtr& interpreter) const
+    {
+        if (!std::holds_alternative<ConcurrentHashTablePtr>(value))
+        {
+            throw_error(interpreter, "Expected concurrent hash table value.");
+        }
+
+        return std::get<ConcurrentHashTablePtr>(value);
+    }
+
+
     size_t Value::hash() const noexcept
     {
         if (std::holds_alternative<None>(value))
@@ -768,6 +1042,26 @@ namespace sorth
             return std::get<ByteBufferPtr>(value)->hash();
         }
 
+        if (std::holds_alternative<FuturePtr>(value))
+        {
+            return std::hash<FuturePtr>()(std::get<FuturePtr>(value));
+        }
+
+        if (std::holds_alternative<ThreadHandlePtr>(value))
+        {
+            return std::hash<ThreadHandlePtr>()(std::get<ThreadHandlePtr>(value));
+        }
+
+        if (std::holds_alternative<ChannelPtr>(value))
+        {
+            return std::hash<ChannelPtr>()(std::get<ChannelPtr>(value));
+        }
+
+        if (std::holds_alternative<ConcurrentHashTablePtr>(value))
+        {
+            return std::hash<ConcurrentHashTablePtr>()(std::get<ConcurrentHashTablePtr>(value));
+        }
+
         return 0;
     }
 
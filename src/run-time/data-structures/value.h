@@ -30,6 +30,18 @@ namespace sorth
     struct DataObject;
     using DataObjectPtr = std::shared_ptr<DataObject>;
 
+    class Future;
+    using FuturePtr = std::shared_ptr<Future>;
+
+    struct ThreadHandle;
+    using ThreadHandlePtr = std::shared_ptr<ThreadHandle>;
+
+    class Channel;
+    using ChannelPtr = std::shared_ptr<Channel>;
+
+    class ConcurrentHashTable;
+    using ConcurrentHashTablePtr = std::shared_ptr<ConcurrentHashTable>;
+
 
     namespace internal
     {
@@ -60,7 +72,11 @@ namespace sorth
                                            HashTablePtr,
                                            ByteBufferPtr,
                                            internal::Token,
-                                           internal::ByteCode>;
+                                           internal::ByteCode,
+                                           FuturePtr,
+                                           ThreadHandlePtr,
+                                           ChannelPtr,
+                                           ConcurrentHashTablePtr>;
 
         private:
             ValueType value;
@@ -84,6 +100,10 @@ namespace sorth
             Value(const ByteBufferPtr& value) noexcept;
             Value(const internal::Token& value) noexcept;
             Value(const internal::ByteCode& value) noexcept;
+            Value(const FuturePtr& value) noexcept;
+            Value(const ThreadHandlePtr& value) noexcept;
+            Value(const ChannelPtr& value) noexcept;
+            Value(const ConcurrentHashTablePtr& value) noexcept;
             Value(const Value& value) = default;
             Value(Value&& value) = default;
             ~Value() noexcept = default;
@@ -105,6 +125,10 @@ namespace sorth
             Value& operator =(const ByteBufferPtr& value) noexcept;
             Value& operator =(const internal::Token& value) noexcept;
             Value& operator =(const internal::ByteCode& value) noexcept;
+            Value& operator =(const FuturePtr& value) noexcept;
+            Value& operator =(const ThreadHandlePtr& value) noexcept;
+            Value& operator =(const ChannelPtr& value) noexcept;
+            Value& operator =(const ConcurrentHashTablePtr& value) noexcept;
 
             operator bool() const noexcept;
 
@@ -117,6 +141,15 @@ namespace sorth
         public:
             Value deep_copy() const;
 
+            // Freeze the value along with everything it refers to.  Values like numbers and
+            // strings are already immutable and are left as is.
+            void freeze() const;
+            bool is_frozen() const;
+
+            // Check if both are the very same value.  Unlike == the containers are compared by
+            // identity instead of by their contents.
+            bool is_same(const Value& other) const noexcept;
+
         public:
             bool is_none() const noexcept;
             bool is_numeric() const noexcept;
@@ -131,6 +164,10 @@ namespace sorth
             bool is_byte_buffer() const noexcept;
             bool is_token() const noexcept;
             bool is_byte_code() const noexcept;
+            bool is_future() const noexcept;
+            bool is_thread_handle() const noexcept;
+            bool is_channel() const noexcept;
+            bool is_concurrent_hash_table() const noexcept;
 
         public:
             static bool either_is_string(const Value& a, const Value& b) noexcept;
@@ -153,6 +190,11 @@ namespace sorth
             ByteBufferPtr as_byte_buffer(const InterpreterPtr& interpreter) const;
             internal::Token as_token(const InterpreterPtr& interpreter) const;
             internal::ByteCode as_byte_code(const InterpreterPtr& interpreter) const;
+            FuturePtr as_future(const InterpreterPtr& interpreter) const;
+            ThreadHandlePtr as_thread_handle(const InterpreterPtr& interpreter) const;
+            ChannelPtr as_channel(const InterpreterPtr& interpreter) const;
+            ConcurrentHashTablePtr as_concurrent_hash_table(
+                                                      const InterpreterPtr& interpreter) const;
 
         public:
             size_t hash() const noexcept;
@@ -53,16 +53,37 @@ namespace sorth::internal
 
 
     WordFunction::WordFunction()
+    :   intrinsic(WordIntrinsic::none),
+        no_throw(false)
     {
     }
 
     WordFunction::WordFunction(const Handler& function)
-    :   function(function)
+    :   function(function),
+        intrinsic(WordIntrinsic::none),
+        no_throw(false)
+    {
+    }
+
+    WordFunction::WordFunction(const Handler& function, WordIntrinsic intrinsic)
+    :   function(function),
+        intrinsic(intrinsic),
+        no_throw(false)
+    {
+    }
+
+    WordFunction::WordFunction(const Handler& function, WordIntrinsic intrinsic, bool no_throw)
+    :   function(function),
+        intrinsic(intrinsic),
+        no_throw(no_throw)
     {
     }
 
     WordFunction::WordFunction(const WordFunction& word_function)
     :   function(word_function.function),
+        intrinsic(word_function.intrinsic),
+        no_throw(word_function.no_throw),
+        direct_call_flag(word_function.direct_call_flag),
         byte_code(word_function.byte_code),
         ir(word_function.ir),
         asm_code(word_function.asm_code)
@@ -71,6 +92,9 @@ namespace sorth::internal
 
     WordFunction::WordFunction(WordFunction&& word_function)
     :   function(std::move(word_function.function)),
+        intrinsic(word_function.intrinsic),
+        no_throw(word_function.no_throw),
+        direct_call_flag(std::move(word_function.direct_call_flag)),
         byte_code(std::move(word_function.byte_code)),
         ir(std::move(word_function.ir)),
         asm_code(std::move(word_function.asm_code))
@@ -83,7 +107,11 @@ namespace sorth::internal
 
     WordFunction& WordFunction::operator =(const Handler& raw_function)
     {
+        invalidate_direct_calls();
+
         function = raw_function;
+        no_throw = false;
+        direct_call_flag.reset();
 
         return *this;
     }
@@ -91,6 +119,9 @@ namespace sorth::internal
     WordFunction& WordFunction::operator =(const WordFunction& word_function)
     {
         function = word_function.function;
+        intrinsic = word_function.intrinsic;
+        no_throw = word_function.no_throw;
+        direct_call_flag = word_function.direct_call_flag;
         byte_code = word_function.byte_code;
         ir = word_function.ir;
         asm_code = word_function.asm_code;
@@ -101,6 +132,9 @@ namespace sorth::internal
     WordFunction& WordFunction::operator =(WordFunction&& word_function)
     {
         function = std::move(word_function.function);
+        intrinsic = word_function.intrinsic;
+        no_throw = word_function.no_throw;
+        direct_call_flag = std::move(word_function.direct_call_flag);
         byte_code = std::move(word_function.byte_code);
         ir = std::move(word_function.ir);
         asm_code = std::move(word_function.asm_code);
@@ -108,7 +142,7 @@ namespace sorth::internal
         return *this;
     }
 
-    void WordFunction::operator ()(InterpreterPtr& interpreter)
+    void WordFunction::operator ()(InterpreterPtr& interpreter) const
     {
         function(interpreter);
     }
@@ -118,6 +152,39 @@ namespace sorth::internal
         return function;
     }
 
+    void WordFunction::set_intrinsic(WordIntrinsic new_intrinsic)
+    {
+        intrinsic = new_intrinsic;
+    }
+
+    WordIntrinsic WordFunction::get_intrinsic() const
+    {
+        return intrinsic;
+    }
+
+    void WordFunction::set_no_throw(bool is_no_throw)
+    {
+        no_throw = is_no_throw;
+    }
+
+    bool WordFunction::is_no_throw() const
+    {
+        return no_throw;
+    }
+
+    void WordFunction::set_direct_call_flag(const std::shared_ptr<std::atomic<bool>>& flag)
+    {
+        direct_call_flag = flag;
+    }
+
+    void WordFunction::invalidate_direct_calls()
+    {
+        if (direct_call_flag)
+        {
+            direct_call_flag->store(false);
+        }
+    }
+
     void WordFunction::set_byte_code(const ByteCode& code)
     {
         byte_code = code;
@@ -6,6 +6,49 @@ namespace sorth::internal
 {
 
 
+    // Words whose behavior on numeric values is well known.  When the JIT sees a call to a word
+    // tagged with one of these it can generate the operation inline, guarded on the types of the
+    // operands, instead of calling the word.  For any other types the word is called as usual.
+    //
+    // The stack words are tagged too, so that the JIT can shuffle values it's holding in registers
+    // without writing them back to the interpreter's stack.  As are the variable increment words,
+    // so that the JIT can recognize them being applied to local variables it's promoted.
+    enum class WordIntrinsic
+    {
+        none,
+
+        add,
+        subtract,
+        multiply,
+        divide,
+        mod,
+        increment,
+        decrement,
+
+        bit_and,
+        bit_or,
+        bit_xor,
+
+        logic_not,
+
+        equal,
+        not_equal,
+        greater_equal,
+        less_equal,
+        greater,
+        less,
+
+        dup,
+        drop,
+        swap,
+        over,
+        rot,
+
+        increment_variable,
+        decrement_variable
+    };
+
+
     class SORTH_API WordFunction
     {
         public:
@@ -13,6 +56,16 @@ namespace sorth::internal
 
         private:
             Handler function;
+            WordIntrinsic intrinsic;
+
+            // Set for native words that can never raise an error, JITed code can then call them
+            // without checking for one.
+            bool no_throw;
+
+            // Set when JITed code has been allowed to call this word's native code directly,
+            // bypassing the handler.  It's cleared if the word is replaced so that the callers go
+            // back to calling through the interpreter.
+            std::shared_ptr<std::atomic<bool>> direct_call_flag;
 
             std::optional<ByteCode> byte_code;
             std::optional<std::string> ir;
@@ -21,6 +74,8 @@ namespace sorth::internal
         public:
             WordFunction();
             WordFunction(const Handler& function);
+            WordFunction(const Handler& function, WordIntrinsic intrinsic);
+            WordFunction(const Handler& function, WordIntrinsic intrinsic, bool no_throw);
             WordFunction(const WordFunction& word_function);
             WordFunction(WordFunction&& word_function);
             ~WordFunction();
@@ -30,11 +85,20 @@ namespace sorth::internal
             WordFunction& operator =(const WordFunction& word_function);
             WordFunction& operator =(WordFunction&& word_function);
 
-            void operator ()(InterpreterPtr& interpreter);
+            void operator ()(InterpreterPtr& interpreter) const;
 
         public:
             Handler get_function() const;
 
+            void set_intrinsic(WordIntrinsic new_intrinsic);
+            WordIntrinsic get_intrinsic() const;
+
+            void set_no_throw(bool is_no_throw);
+            bool is_no_throw() const;
+
+            void set_direct_call_flag(const std::shared_ptr<std::atomic<bool>>& flag);
+            void invalidate_direct_calls();
+
             void set_byte_code(const ByteCode& code);
             void set_byte_code(const ByteCode&& code);
             const std::optional<ByteCode>& get_byte_code() const;
@@ -0,0 +1,530 @@
+
+#include "sorth.h"
+
+
+#if (IS_UNIX == 1)
+
+    // The ucontext routines are deprecated on macOS, they're still available but only if we ask
+    // for them.
+    #if (IS_MACOS == 1) && !defined(_XOPEN_SOURCE)
+
+        #define _XOPEN_SOURCE 600
+
+    #endif
+
+    #include <ucontext.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+
+#endif
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        // How much address space is reserved for each coroutine's machine stack.  The pages are
+        // only committed by the OS as the stack grows into them.
+        constexpr size_t stack_size = 1024 * 1024;
+
+
+        // Every coroutine starts here, on it's own machine stack.
+        void coroutine_main();
+
+
+        #if (IS_WINDOWS == 1)
+
+
+            // A machine context, either a coroutine's or the thread's own.  Windows calls these
+            // fibers.
+            class MachineContext
+            {
+                private:
+                    LPVOID fiber;
+                    bool is_owned;
+
+                public:
+                    MachineContext()
+                    : fiber(nullptr),
+                      is_owned(false)
+                    {
+                    }
+
+                    MachineContext(const MachineContext& context) = delete;
+
+                    ~MachineContext()
+                    {
+                        if (is_owned)
+                        {
+                            DeleteFiber(fiber);
+                        }
+                    }
+
+                public:
+                    MachineContext& operator =(const MachineContext& context) = delete;
+
+                public:
+                    // Create a new stack for a coroutine, that will start running at
+                    // coroutine_main when first switched to.
+                    void start()
+                    {
+                        fiber = CreateFiber(stack_size, fiber_main, nullptr);
+
+                        if (fiber == nullptr)
+                        {
+                            throw_error("Could not allocate a stack for the coroutine.");
+                        }
+
+                        is_owned = true;
+                    }
+
+                    // Save where we are in this context and jump to the other one.
+                    void switch_to(MachineContext& target)
+                    {
+                        // The thread has to be a fiber itself before it can switch to one.
+                        if (fiber == nullptr)
+                        {
+                            fiber = IsThreadAFiber() ? GetCurrentFiber()
+                                                     : ConvertThreadToFiber(nullptr);
+                        }
+
+                        SwitchToFiber(target.fiber);
+                    }
+
+                private:
+                    static VOID CALLBACK fiber_main(LPVOID)
+                    {
+                        coroutine_main();
+                    }
+            };
+
+
+        #else
+
+
+            // A machine context, either a coroutine's or the thread's own.
+            class MachineContext
+            {
+                private:
+                    ucontext_t context;
+
+                    void* stack;
+                    size_t allocation_size;
+
+                public:
+                    MachineContext()
+                    : context(),
+                      stack(nullptr),
+                      allocation_size(0)
+                    {
+                    }
+
+                    MachineContext(const MachineContext& context) = delete;
+
+                    ~MachineContext()
+                    {
+                        if (stack != nullptr)
+                        {
+                            munmap(stack, allocation_size);
+                        }
+                    }
+
+                public:
+                    MachineContext& operator =(const MachineContext& context) = delete;
+
+                public:
+                    // Create a new stack for a coroutine, that will start running at
+                    // coroutine_main when first switched to.
+                    void start()
+                    {
+                        auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+                        auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+                        // Don't have the OS set aside memory for pages the coroutine may never
+                        // use.
+                        #if defined(MAP_NORESERVE)
+
+                            flags |= MAP_NORESERVE;
+
+                        #endif
+
+                        allocation_size = stack_size + page_size;
+                        stack = mmap(nullptr,
+                                     allocation_size,
+                                     PROT_READ | PROT_WRITE,
+                                     flags,
+                                     -1,
+                                     0);
+
+                        if (stack == MAP_FAILED)
+                        {
+                            stack = nullptr;
+                            throw_error("Could not allocate a stack for the coroutine.");
+                        }
+
+                        // Leave a guard page at the bottom of the stack, so that a coroutine that
+                        // overflows it's stack crashes instead of quietly trashing memory.
+                        mprotect(stack, page_size, PROT_NONE);
+
+                        getcontext(&context);
+
+                        context.uc_stack.ss_sp = static_cast<char*>(stack) + page_size;
+                        context.uc_stack.ss_size = stack_size;
+                        context.uc_link = nullptr;
+
+                        makecontext(&context, coroutine_main, 0);
+                    }
+
+                    // Save where we are in this context and jump to the other one.
+                    void switch_to(MachineContext& target)
+                    {
+                        swapcontext(&context, &target.context);
+                    }
+            };
+
+
+        #endif
+
+
+        enum class State
+        {
+            // The coroutine can be run as soon as it's turn comes up.
+            ready,
+
+            // The coroutine is waiting for a future to complete.
+            waiting,
+
+            // The coroutine's word has returned, or failed.
+            finished
+        };
+
+
+        struct Coroutine
+        {
+            // The coroutine's own interpreter, which holds it's data stack and call stack.
+            InterpreterPtr interpreter;
+
+            // The word to run and the value that it's given to work on.
+            Word word;
+            Value input;
+
+            // Where the word's result goes.
+            FuturePtr result;
+
+            State state;
+            FuturePtr waiting_on;
+
+            MachineContext context;
+        };
+
+
+        using CoroutinePtr = std::shared_ptr<Coroutine>;
+
+
+        // Each OS thread schedules it's own coroutines.  They're run in the order they were
+        // started, each running until it yields, waits on a future, or finishes.
+        class Scheduler
+        {
+            private:
+                std::list<CoroutinePtr> coroutines;
+
+                // The coroutine that's running right now, if any.
+                Coroutine* current;
+
+                // The thread's own context, where the scheduler runs between coroutines.
+                MachineContext context;
+
+                size_t instruction_budget;
+
+            public:
+                Scheduler()
+                : coroutines(),
+                  current(nullptr),
+                  context(),
+                  instruction_budget(0)
+                {
+                }
+
+                // Coroutines that haven't finished by the time the thread exits are dropped
+                // without being unwound, running them again this late could touch thread state
+                // that's already gone.  Their futures are failed so that nothing waits on them
+                // forever, and their interpreters and inputs are released along with them.  Only
+                // what their own stack frames were holding on to is lost with the stacks.
+                ~Scheduler()
+                {
+                    for (auto& coroutine : coroutines)
+                    {
+                        coroutine->result->set_error("The coroutine's thread exited before it "
+                                                     "finished.");
+                    }
+                }
+
+            public:
+                FuturePtr spawn(InterpreterPtr& interpreter, const Word& word, const Value& input)
+                {
+                    auto coroutine = std::make_shared<Coroutine>();
+
+                    coroutine->interpreter = clone_interpreter(interpreter);
+                    coroutine->word = word;
+                    coroutine->input = input;
+                    coroutine->result = std::make_shared<Future>();
+                    coroutine->state = State::ready;
+
+                    coroutine->interpreter->set_instruction_budget(instruction_budget);
+                    coroutine->context.start();
+
+                    coroutines.push_back(coroutine);
+
+                    return coroutine->result;
+                }
+
+                bool is_running() const
+                {
+                    return current != nullptr;
+                }
+
+                void yield()
+                {
+                    if (current != nullptr)
+                    {
+                        suspend(State::ready);
+                    }
+                    else
+                    {
+                        run_ready();
+                    }
+                }
+
+                Value await(InterpreterPtr& interpreter, const FuturePtr& future)
+                {
+                    if (current != nullptr)
+                    {
+                        auto& coroutine = *current;
+
+                        while (!future->is_ready())
+                        {
+                            coroutine.waiting_on = future;
+                            suspend(State::waiting);
+                        }
+
+                        coroutine.waiting_on.reset();
+                    }
+                    else
+                    {
+                        while (!future->is_ready())
+                        {
+                            if (!run_ready())
+                            {
+                                wait_for_progress(interpreter, future);
+                            }
+                        }
+                    }
+
+                    return future->get();
+                }
+
+                void set_budget(size_t instructions)
+                {
+                    instruction_budget = instructions;
+                }
+
+                size_t count() const
+                {
+                    return coroutines.size();
+                }
+
+                // Run the current coroutine's word, called on the coroutine's own stack.
+                void run_current()
+                {
+                    auto& coroutine = *current;
+                    auto& interpreter = coroutine.interpreter;
+
+                    try
+                    {
+                        interpreter->push(coroutine.input);
+                        coroutine.input = Value();
+
+                        interpreter->execute_word(coroutine.word);
+                        coroutine.result->set_value(interpreter->is_stack_empty()
+                                                    ? Value()
+                                                    : interpreter->pop());
+                    }
+                    catch (const std::exception& error)
+                    {
+                        coroutine.result->set_error(error.what());
+                    }
+                    catch (...)
+                    {
+                        coroutine.result->set_error("Coroutine exited with an unknown error.");
+                    }
+
+                    interpreter->clear_stack();
+                }
+
+                // Leave a coroutine that's done for good.  It's stack is freed by the scheduler
+                // once we're off of it.
+                [[noreturn]] void finish()
+                {
+                    suspend(State::finished);
+
+                    // A finished coroutine is never resumed.
+                    std::terminate();
+                }
+
+            private:
+                // Switch from the running coroutine back to the scheduler, until it's this
+                // coroutine's turn again.
+                void suspend(State state)
+                {
+                    auto& coroutine = *current;
+
+                    coroutine.state = state;
+                    coroutine.context.switch_to(context);
+                }
+
+                // Switch from the scheduler to a coroutine until it gives up the thread again.
+                void resume(Coroutine& coroutine)
+                {
+                    current = &coroutine;
+                    coroutine.state = State::ready;
+
+                    context.switch_to(coroutine.context);
+
+                    current = nullptr;
+                }
+
+                // Give each coroutine that can make progress a turn, returns false if none of them
+                // could.  Coroutines started along the way get their first turn in this pass.
+                bool run_ready()
+                {
+                    bool has_run = false;
+                    auto iter = coroutines.begin();
+
+                    while (iter != coroutines.end())
+                    {
+                        auto& coroutine = **iter;
+
+                        if (   (coroutine.state == State::ready)
+                            || (   (coroutine.state == State::waiting)
+                                && (coroutine.waiting_on->is_ready())))
+                        {
+                            resume(coroutine);
+                            has_run = true;
+                        }
+
+                        if (coroutine.state == State::finished)
+                        {
+                            iter = coroutines.erase(iter);
+                        }
+                        else
+                        {
+                            ++iter;
+                        }
+                    }
+
+                    return has_run;
+                }
+
+                // None of the coroutines can run, so sleep until one of the futures that we or
+                // they are waiting on completes.
+                void wait_for_progress(InterpreterPtr& interpreter, const FuturePtr& future)
+                {
+                    std::vector<FuturePtr> futures = { future };
+                    bool is_deadlocked = is_coroutine_result(future);
+
+                    for (const auto& coroutine : coroutines)
+                    {
+                        futures.push_back(coroutine->waiting_on);
+                        is_deadlocked = is_deadlocked
+                                        && is_coroutine_result(coroutine->waiting_on);
+                    }
+
+                    // If everyone is waiting on one of this thread's coroutines, nothing is ever
+                    // going to complete.
+                    if (is_deadlocked)
+                    {
+                        throw_error(interpreter,
+                                    "Coroutines are deadlocked waiting on each other.");
+                    }
+
+                    Future::wait_any(futures);
+                }
+
+                bool is_coroutine_result(const FuturePtr& future) const
+                {
+                    for (const auto& coroutine : coroutines)
+                    {
+                        if (coroutine->result == future)
+                        {
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+        };
+
+
+        Scheduler& get_scheduler()
+        {
+            thread_local Scheduler scheduler;
+
+            return scheduler;
+        }
+
+
+        void coroutine_main()
+        {
+            auto& scheduler = get_scheduler();
+
+            scheduler.run_current();
+            scheduler.finish();
+        }
+
+
+    }
+
+
+    FuturePtr coroutine_spawn(InterpreterPtr& interpreter, const Word& word, const Value& input)
+    {
+        return get_scheduler().spawn(interpreter, word, input);
+    }
+
+
+    bool coroutine_is_running()
+    {
+        return get_scheduler().is_running();
+    }
+
+
+    void coroutine_yield()
+    {
+        get_scheduler().yield();
+    }
+
+
+    Value coroutine_await(InterpreterPtr& interpreter, const FuturePtr& future)
+    {
+        return get_scheduler().await(interpreter, future);
+    }
+
+
+    void coroutine_set_budget(size_t instructions)
+    {
+        get_scheduler().set_budget(instructions);
+    }
+
+
+    size_t coroutine_count()
+    {
+        return get_scheduler().count();
+    }
+
+
+}
@@ -0,0 +1,48 @@
+
+#pragma once
+
+
+namespace sorth::internal
+{
+
+
+    // Run a word as a coroutine on the calling OS thread.  Coroutines are scheduled cooperatively,
+    // they only give up the thread when they yield or await a future that isn't ready yet.  Each
+    // coroutine gets it's own interpreter, cloned from the one that started it, and with it it's
+    // own data stack and call stack.  The coroutine's machine stack is reserved up front but only
+    // touched as it's used, so thousands of coroutines can be waiting on I/O at once without
+    // needing thousands of OS threads.
+    //
+    // Coroutines don't run until the thread that started them awaits a future or yields.  The
+    // returned future is completed with the value left on the top of the coroutine's stack, or
+    // with the error that stopped it.  If the thread exits first the future fails, the coroutine
+    // is never resumed.
+    FuturePtr coroutine_spawn(InterpreterPtr& interpreter, const Word& word, const Value& input);
+
+
+    // Is the calling code running inside of a coroutine?
+    bool coroutine_is_running();
+
+
+    // From within a coroutine, give the other coroutines on this thread a chance to run.  From
+    // outside of a coroutine, run each of the coroutines that are ready once.
+    void coroutine_yield();
+
+
+    // Wait for a future and get it's value, rethrowing it's error if it failed.  A coroutine
+    // waiting on a future lets the thread's other coroutines run in the meantime, and code outside
+    // of a coroutine runs the thread's coroutines until the future is ready.
+    Value coroutine_await(InterpreterPtr& interpreter, const FuturePtr& future);
+
+
+    // Coroutines started on this thread from now on are made to yield after running this many
+    // byte code instructions, so that a busy coroutine can't starve the others.  Zero turns off
+    // preemption, which is the default.
+    void coroutine_set_budget(size_t instructions);
+
+
+    // How many coroutines started on this thread haven't finished yet.
+    size_t coroutine_count();
+
+
+}
@@ -43,6 +43,10 @@ namespace sorth
         using PathList = std::list<std::filesystem::path>;
 
 
+        // Where to write the object file when a script is being compiled ahead of time.
+        using ObjectPath = std::optional<std::filesystem::path>;
+
+
         class InterpreterImpl : public Interpreter,
                                 public std::enable_shared_from_this<Interpreter>
         {
@@ -60,6 +64,11 @@ namespace sorth
                 bool is_showing_bytecode;
                 bool is_showing_run_code;
 
+                // When running as a preemptible coroutine, how many instructions we run before
+                // yielding and how many are left to go.
+                size_t instruction_budget;
+                size_t instructions_remaining;
+
                 ValueStack stack;
 
                 Location current_location;
@@ -73,6 +82,11 @@ namespace sorth
                 ThreadMap thread_map;
                 std::mutex sub_thread_lock;
 
+                // If this interpreter is running a sub-thread's word, this is that thread's own
+                // handle.  This way the thread can reach it's queues without looking itself up in
+                // the thread map.
+                ThreadHandlePtr thread_handle;
+
                 CompileContextStack compile_contexts;
 
             public:
@@ -88,12 +102,18 @@ namespace sorth
                 virtual void release_context() override;
 
             public:
-                void process_source(SourceBuffer& buffer);
+                void process_source(SourceBuffer& buffer,
+                                    const ObjectPath& object_path);
+                void process_source(const std::filesystem::path& path,
+                                    const ObjectPath& object_path);
 
                 virtual void process_source(const std::filesystem::path& path) override;
                 virtual void process_source(const std::string& name,
                                             const std::string& source_text) override;
 
+                virtual void compile_source(const std::filesystem::path& path,
+                                            const std::filesystem::path& object_path) override;
+
                 virtual int get_exit_code() const override;
                 virtual void set_exit_code(int new_exit_code) override;
 
@@ -109,6 +129,9 @@ namespace sorth
                 virtual void halt() override;
                 virtual void clear_halt_flag() override;
 
+                virtual void set_instruction_budget(size_t budget) override;
+                virtual void spend_instruction_budget(size_t instructions) override;
+
                 virtual const CallStack& get_call_stack() const override;
 
                 virtual void call_stack_push(const std::string& name,
@@ -117,16 +140,19 @@ namespace sorth
                 virtual void call_stack_pop() override;
 
                 virtual std::tuple<bool, Word> find_word(const std::string& word) override;
-                virtual WordHandlerInfo& get_handler_info(size_t index) override;
+                virtual const WordHandlerInfo& get_handler_info(size_t index) override;
+                virtual size_t handler_count() const override;
+                virtual const ContentVersion& handlers_version() const override;
 
             private:
-                void append_new_thread(const SubThreadInfo& info);
+                SubThreadInfo start_thread(const internal::Word& word);
                 void remove_thread(const std::thread::id& id);
 
             public:
                 virtual std::list<SubThreadInfo> sub_threads() override;
 
-                virtual std::thread::id execute_word_threaded(const internal::Word& word) override;
+                virtual ThreadHandlePtr execute_word_threaded(const internal::Word& word) override;
+                virtual FuturePtr execute_word_async(const internal::Word& word) override;
 
                 virtual void execute_word(int64_t word_index) override;
                 virtual void execute_word(const std::string& word) override;
@@ -173,9 +199,17 @@ namespace sorth
                 virtual void thread_push_output(std::thread::id& id, Value& value) override;
                 virtual Value thread_pop_output(std::thread::id& id) override;
 
+                virtual void thread_push_outputs(std::thread::id& id,
+                                                 std::vector<Value>& values) override;
+                virtual std::vector<Value> thread_pop_inputs(std::thread::id& id,
+                                                             size_t count) override;
+
             private:
                 SubThreadInfo& get_thread_info(const std::thread::id& id);
 
+                BlockingValueQueuePtr input_queue(const std::thread::id& id);
+                BlockingValueQueuePtr output_queue(const std::thread::id& id);
+
             public:
                 virtual Value pick(int64_t index) override;
                 virtual void push_to(int64_t index) override;
@@ -225,7 +259,9 @@ namespace sorth
           is_interpreter_quitting(false),
           exit_code(EXIT_SUCCESS),
           is_showing_bytecode(false),
-          is_showing_run_code(false)
+          is_showing_run_code(false),
+          instruction_budget(0),
+          instructions_remaining(0)
         {
         }
 
@@ -238,6 +274,8 @@ namespace sorth
           exit_code(0),
           is_showing_bytecode(false),
           is_showing_run_code(false),
+          instruction_budget(0),
+          instructions_remaining(0),
           stack(),
           current_location(interpreter.current_location),
           call_stack(),
@@ -276,7 +314,8 @@ namespace sorth
         }
 
 
-        void InterpreterImpl::process_source(SourceBuffer& buffer)
+        void InterpreterImpl::process_source(SourceBuffer& buffer,
+                                             const ObjectPath& object_path)
         {
             // Make sure that the compiler context is properly created and freed.
             class CompileContextManager
@@ -320,6 +359,20 @@ namespace sorth
             };
 
 
+            // Compiling ahead of time needs the script's words cached as they are for the JIT.
+            if (   (object_path)
+                && (   (SORTH_LLVM_FOUND == 0)
+                    || (execution_mode != ExecutionMode::jit)))
+            {
+                throw_error("Compiling ahead of time is only available in JIT mode, when sorth is "
+                            "built with LLVM.");
+            }
+
+            #if (SORTH_LLVM_FOUND == 1)
+                // Any words created while compiling the script are given handlers from here on.
+                auto first_handler = handler_count();
+            #endif
+
             // Now byte-code compile the script.  If we are also JITing the script, then we will
             // cache the non-immediate words for JIT compilation later as a whole module to allow
             // for greater optimization.
@@ -340,6 +393,18 @@ namespace sorth
                     // Get a shared pointer to ourselves.
                     auto this_ptr = shared_from_this();
 
+                    // If we're compiling ahead of time the script is written out instead of run.
+                    if (object_path)
+                    {
+                        aot_compile_module(this_ptr,
+                                           name,
+                                           code,
+                                           compile_contexts.top().word_jit_cache,
+                                           first_handler,
+                                           object_path.value());
+                        return;
+                    }
+
                     // JIT compile the script's top level function handler and all of the script's
                     // non-immediate words that have been cached during the byte-code compilation
                     // phase.
@@ -371,6 +436,20 @@ namespace sorth
 
 
         void InterpreterImpl::process_source(const std::filesystem::path& path)
+        {
+            process_source(path, std::nullopt);
+        }
+
+
+        void InterpreterImpl::compile_source(const std::filesystem::path& path,
+                                             const std::filesystem::path& object_path)
+        {
+            process_source(path, object_path);
+        }
+
+
+        void InterpreterImpl::process_source(const std::filesystem::path& path,
+                                             const ObjectPath& object_path)
         {
             // Make sure that the search path is properly managed.  If this script happens to
             // include other scripts, we want to make sure that it can find it's relative scripts.
@@ -409,7 +488,7 @@ namespace sorth
             SearchPathManager search_path_manager(*this, base_path);
 
             // Now compile/execute the script.
-            process_source(source);
+            process_source(source, object_path);
         }
 
 
@@ -418,7 +497,7 @@ namespace sorth
         {
             // Create a source buffer for this script and then compile/execute it.
             SourceBuffer source(name, source_text);
-            process_source(source);
+            process_source(source, std::nullopt);
         }
 
 
@@ -477,6 +556,32 @@ namespace sorth
         }
 
 
+        void InterpreterImpl::set_instruction_budget(size_t budget)
+        {
+            instruction_budget = budget;
+            instructions_remaining = budget;
+        }
+
+
+        void InterpreterImpl::spend_instruction_budget(size_t instructions)
+        {
+            if (instruction_budget == 0)
+            {
+                return;
+            }
+
+            if (instructions_remaining <= instructions)
+            {
+                instructions_remaining = instruction_budget;
+                coroutine_yield();
+            }
+            else
+            {
+                instructions_remaining -= instructions;
+            }
+        }
+
+
         const CallStack& InterpreterImpl::get_call_stack() const
         {
             return call_stack;
@@ -489,7 +594,7 @@ namespace sorth
         }
 
 
-        WordHandlerInfo& InterpreterImpl::get_handler_info(size_t index)
+        const WordHandlerInfo& InterpreterImpl::get_handler_info(size_t index)
         {
             throw_error_if(index >= word_handlers.size(), shared_from_this(),
                            "Handler index is out of range.");
@@ -498,18 +603,15 @@ namespace sorth
         }
 
 
-        void InterpreterImpl::append_new_thread(const SubThreadInfo& info)
+        size_t InterpreterImpl::handler_count() const
         {
-            if (parent_interpreter)
-            {
-                auto actual = std::reinterpret_pointer_cast<InterpreterImpl>(parent_interpreter);
-                actual->append_new_thread(info);
-            }
-            else
-            {
-                std::lock_guard<std::mutex> guard(sub_thread_lock);
-                thread_map.insert(ThreadMap::value_type(info.word_thread->get_id(), info));
-            }
+            return word_handlers.size();
+        }
+
+
+        const ContentVersion& InterpreterImpl::handlers_version() const
+        {
+            return word_handlers.version();
         }
 
 
@@ -522,26 +624,17 @@ namespace sorth
             }
             else
             {
-                auto& info = get_thread_info(id);
-
-                if (info.outputs.depth() == 0)
-                {
-                    std::lock_guard<std::mutex> guard(sub_thread_lock);
-
-                    auto thread = thread_map[id];
+                std::lock_guard<std::mutex> guard(sub_thread_lock);
 
-                    thread.word_thread->join();
+                auto iterator = thread_map.find(id);
 
-                    if (thread_map.contains(id))
-                    {
-                        thread_map.erase(id);
-                    }
-                }
-                else
+                if (iterator != thread_map.end())
                 {
-                    std::lock_guard<std::mutex> guard(sub_thread_lock);
-
-                    info.thead_deleted = true;
+                    // We're being called from the exiting thread itself, so it can't be joined.
+                    // Let it finish on it's own instead.  Any outputs it left behind are still
+                    // reachable through it's handle.
+                    iterator->second.word_thread->detach();
+                    thread_map.erase(iterator);
                 }
             }
         }
@@ -567,13 +660,26 @@ namespace sorth
         }
 
 
-        std::thread::id InterpreterImpl::execute_word_threaded(const internal::Word& word)
+        ThreadHandlePtr InterpreterImpl::execute_word_threaded(const internal::Word& word)
+        {
+            return start_thread(word).handle;
+        }
+
+
+        FuturePtr InterpreterImpl::execute_word_async(const internal::Word& word)
+        {
+            return start_thread(word).handle->result;
+        }
+
+
+        SubThreadInfo InterpreterImpl::start_thread(const internal::Word& word)
         {
             // If this interpreter has a parent, request it to spawn the thread so that they are
             // all tracked in the same place.
             if (parent_interpreter)
             {
-                return parent_interpreter->execute_word_threaded(word);
+                auto actual = std::reinterpret_pointer_cast<InterpreterImpl>(parent_interpreter);
+                return actual->start_thread(word);
             }
 
             // Capture the pointer to this interpreter then clone itself to run in the sub
@@ -581,37 +687,68 @@ namespace sorth
             auto this_ptr = std::static_pointer_cast<Interpreter>(shared_from_this());
             auto child_interpreter = clone_interpreter(this_ptr);
 
+            // Create the thread's queues and give the child direct access to them.
+            auto handle = std::make_shared<ThreadHandle>(ThreadHandle
+                {
+                    .id = {},
+                    .inputs = std::make_shared<BlockingValueQueue>(),
+                    .outputs = std::make_shared<BlockingValueQueue>(),
+                    .result = std::make_shared<Future>()
+                });
+
+            auto result = handle->result;
+
+            {
+                auto child = std::reinterpret_pointer_cast<InterpreterImpl>(child_interpreter);
+
+                child->thread_handle = handle;
+            }
+
+            // Hold the thread lock until the new thread has been registered, otherwise a short
+            // lived thread could try to remove itself before it's been added.
+            std::lock_guard<std::mutex> guard(sub_thread_lock);
+
             // Spawn the new thread.
             auto word_thread = std::make_shared<std::thread>([=]()
                 {
+                    // Get a proper reference to the sub-thread interpreter.
+                    auto child = std::reinterpret_pointer_cast<InterpreterImpl>(child_interpreter);
+
                     try
                     {
-                        // Get a proper reference to the sub-thread interpreter.
-                        auto child =
-                              std::reinterpret_pointer_cast<InterpreterImpl>(child_interpreter);
-
-                        // Execute the requested word.
+                        // Execute the requested word, and pass along whatever it left on the top
+                        // of the stack.
                         child->execute_word(word);
-
-                        // Before we exit clear up the thread reference.
-                        child->remove_thread(std::this_thread::get_id());
+                        result->set_value(child->is_stack_empty() ? Value() : child->pop());
+                    }
+                    catch (const std::exception& error)
+                    {
+                        // The error message already carries the location and call stack of where
+                        // the error happened, keep it so that whoever is waiting can report it.
+                        result->set_error(error.what());
                     }
                     catch (...)
                     {
-                        // TODO: Catch the exception and possibly store that with the thread
-                        //       info.
+                        result->set_error("Thread exited with an unknown error.");
                     }
+
+                    // Before we exit clear up the thread reference.
+                    child->remove_thread(std::this_thread::get_id());
                 });
 
-            // Register the thread.
-            append_new_thread(
+            handle->id = word_thread->get_id();
+
+            SubThreadInfo info =
                 {
                     .word = word,
                     .word_thread = word_thread,
-                    .thead_deleted = false
-                });
+                    .handle = handle
+                };
+
+            // Register the thread.
+            thread_map.insert(ThreadMap::value_type(word_thread->get_id(), info));
 
-            return word_thread->get_id();
+            return info;
         }
 
 
@@ -730,6 +867,13 @@ namespace sorth
                         break;
                     }
 
+                    if (   (instruction_budget > 0)
+                        && (--instructions_remaining == 0))
+                    {
+                        instructions_remaining = instruction_budget;
+                        coroutine_yield();
+                    }
+
                     if (is_showing_run_code)
                     {
                         std::cout << std::setw(6) << pc << " " << operation << std::endl;
@@ -1172,53 +1316,49 @@ namespace sorth
 
         int64_t InterpreterImpl::thread_input_depth(std::thread::id id)
         {
-            return get_thread_info(id).inputs.depth();
+            return input_queue(id)->depth();
         }
 
 
         void InterpreterImpl::thread_push_input(std::thread::id& id, Value& value)
         {
-            get_thread_info(id).inputs.push(value);
+            input_queue(id)->push(value);
         }
 
 
         Value InterpreterImpl::thread_pop_input(std::thread::id& id)
         {
-            return get_thread_info(id).inputs.pop();
+            return input_queue(id)->pop();
         }
 
 
         int64_t InterpreterImpl::thread_output_depth(std::thread::id id)
         {
-            return get_thread_info(id).outputs.depth();
+            return output_queue(id)->depth();
         }
 
 
         void InterpreterImpl::thread_push_output(std::thread::id& id, Value& value)
         {
-            get_thread_info(id).outputs.push(value);
+            output_queue(id)->push(value);
         }
 
 
         Value InterpreterImpl::thread_pop_output(std::thread::id& id)
         {
-            auto& info = get_thread_info(id);
-            auto value = info.outputs.pop();
+            return output_queue(id)->pop();
+        }
 
-            // If the thread has exited and we've consumed the last of it's outputs free up the
-            // thread record now.
-            if (   (info.thead_deleted)
-                && (info.outputs.depth() == 0))
-            {
-                std::lock_guard<std::mutex> guard(sub_thread_lock);
 
-                auto& thread = thread_map[id];
+        void InterpreterImpl::thread_push_outputs(std::thread::id& id, std::vector<Value>& values)
+        {
+            output_queue(id)->push_many(values);
+        }
 
-                thread.word_thread->join();
-                thread_map.erase(id);
-            }
 
-            return value;
+        std::vector<Value> InterpreterImpl::thread_pop_inputs(std::thread::id& id, size_t count)
+        {
+            return input_queue(id)->pop_many(count);
         }
 
 
@@ -1241,6 +1381,31 @@ namespace sorth
         }
 
 
+        BlockingValueQueuePtr InterpreterImpl::input_queue(const std::thread::id& id)
+        {
+            // A thread reading it's own queue doesn't need to go through the thread map.
+            if (   (thread_handle)
+                && (id == std::this_thread::get_id()))
+            {
+                return thread_handle->inputs;
+            }
+
+            return get_thread_info(id).handle->inputs;
+        }
+
+
+        BlockingValueQueuePtr InterpreterImpl::output_queue(const std::thread::id& id)
+        {
+            if (   (thread_handle)
+                && (id == std::this_thread::get_id()))
+            {
+                return thread_handle->outputs;
+            }
+
+            return get_thread_info(id).handle->outputs;
+        }
+
+
         Value InterpreterImpl::pick(int64_t index)
         {
             auto iterator = stack.begin();
@@ -1311,7 +1476,7 @@ namespace sorth
 
         void InterpreterImpl::write_variable(size_t index, Value value)
         {
-            variables[index] = value;
+            variables.set(index, value);
         }
 
 
@@ -1367,7 +1532,18 @@ namespace sorth
                 throw_error(shared_from_this(), "Word " + word + " was not found for replacement.");
             }
 
-            auto code_ref = word_handlers[word_entry.handler_index].function.get_byte_code();
+            auto handler_info = word_handlers[word_entry.handler_index];
+
+            // JITed code doesn't check for errors from words that can't raise them, so those can
+            // only be replaced by other words that can't.
+            if (   (handler_info.function.is_no_throw())
+                && (!handler.is_no_throw()))
+            {
+                throw_error(shared_from_this(),
+                            "Word " + word + " can not be replaced by a word that can fail.");
+            }
+
+            auto code_ref = handler_info.function.get_byte_code();
 
             if (code_ref.has_value())
             {
@@ -1375,7 +1551,12 @@ namespace sorth
                 handler.set_byte_code(byte_code);
             }
 
-            word_handlers[word_entry.handler_index].function = handler;
+            // Any JITed code calling the old version of the word directly needs to go back to
+            // calling it through the handler table.
+            handler_info.function.invalidate_direct_calls();
+            handler_info.function = handler;
+
+            word_handlers.set(word_entry.handler_index, handler_info);
         }
 
 
@@ -64,13 +64,8 @@ namespace sorth
         // The thread that is executing the word.
         std::shared_ptr<std::thread> word_thread;
 
-        // Has the thread been marked for deletion?
-        bool thead_deleted;
-
-
-        // The thread's input and output queues.
-        BlockingValueQueue inputs;
-        BlockingValueQueue outputs;
+        // The handle to the thread's queues and result.
+        ThreadHandlePtr handle;
     };
 
 
@@ -97,6 +92,11 @@ namespace sorth
             virtual void process_source(const std::string& name,
                                         const std::string& source_text) = 0;
 
+            // Compile the script into a native object file instead of running it.  Only available
+            // in JIT mode.
+            virtual void compile_source(const std::filesystem::path& path,
+                                        const std::filesystem::path& object_path) = 0;
+
             virtual int get_exit_code() const = 0;
             virtual void set_exit_code(int exit_code) = 0;
 
@@ -112,6 +112,14 @@ namespace sorth
             virtual void halt() = 0;
             virtual void clear_halt_flag() = 0;
 
+            // Make the interpreter yield to it's other coroutines after running this many byte
+            // code instructions.  Zero, the default, never yields.
+            virtual void set_instruction_budget(size_t budget) = 0;
+
+            // Count instructions that were run outside of the byte-code loop, by JITed code,
+            // against the budget.
+            virtual void spend_instruction_budget(size_t instructions) = 0;
+
             virtual const internal::CallStack& get_call_stack() const = 0;
 
             virtual void call_stack_push(const std::string& name,
@@ -120,11 +128,17 @@ namespace sorth
             virtual void call_stack_pop() = 0;
 
             virtual std::tuple<bool, internal::Word> find_word(const std::string& word) = 0;
-            virtual internal::WordHandlerInfo& get_handler_info(size_t index) = 0;
+            virtual const internal::WordHandlerInfo& get_handler_info(size_t index) = 0;
+            virtual size_t handler_count() const = 0;
+
+            // Identifies the current set of word handlers, it changes whenever one is added or
+            // replaced.
+            virtual const internal::ContentVersion& handlers_version() const = 0;
 
             virtual std::list<SubThreadInfo> sub_threads() = 0;
 
-            virtual std::thread::id execute_word_threaded(const internal::Word& word) = 0;
+            virtual ThreadHandlePtr execute_word_threaded(const internal::Word& word) = 0;
+            virtual FuturePtr execute_word_async(const internal::Word& word) = 0;
 
 
             virtual void execute_word(int64_t word_index) = 0;
@@ -173,6 +187,9 @@ namespace sorth
             virtual void thread_push_output(std::thread::id& id, Value& value) = 0;
             virtual Value thread_pop_output(std::thread::id& id) = 0;
 
+            virtual void thread_push_outputs(std::thread::id& id, std::vector<Value>& values) = 0;
+            virtual std::vector<Value> thread_pop_inputs(std::thread::id& id, size_t count) = 0;
+
             virtual Value pick(int64_t index) = 0;
             virtual void push_to(int64_t index) = 0;
 
@@ -245,5 +262,31 @@ namespace sorth
                               DESCRIPTION, \
                               SIGNATURE)
 
+    #define ADD_NATIVE_NO_THROW_WORD(INTERPRETER, NAME, HANDLER, DESCRIPTION, SIGNATURE) \
+        INTERPRETER->add_word(NAME, \
+                              sorth::internal::WordFunction( \
+                                             sorth::internal::WordFunction::Handler(HANDLER), \
+                                             sorth::internal::WordIntrinsic::none, \
+                                             true), \
+                              __FILE__, \
+                              __LINE__, \
+                              1, \
+                              sorth::internal::ExecutionContext::run_time, \
+                              DESCRIPTION, \
+                              SIGNATURE)
+
+    #define ADD_NATIVE_INTRINSIC_WORD(INTERPRETER, NAME, HANDLER, INTRINSIC, DESCRIPTION, \
+                                      SIGNATURE) \
+        INTERPRETER->add_word(NAME, \
+                              sorth::internal::WordFunction( \
+                                             sorth::internal::WordFunction::Handler(HANDLER), \
+                                             INTRINSIC), \
+                              __FILE__, \
+                              __LINE__, \
+                              1, \
+                              sorth::internal::ExecutionContext::run_time, \
+                              DESCRIPTION, \
+                              SIGNATURE)
+
 
 }
@@ -0,0 +1,526 @@
+
+#include "sorth.h"
+
+#include <deque>
+
+
+
+namespace sorth::internal
+{
+
+
+    namespace
+    {
+
+
+        // The versions of an interpreter's words and variables.  Two interpreters with the same
+        // state are guaranteed to have the same words and variables.
+        struct InterpreterState
+        {
+            ContentVersion::Stamp dictionary;
+            ContentVersion::Stamp handlers;
+            ContentVersion::Stamp variables;
+
+            bool operator ==(const InterpreterState& state) const = default;
+        };
+
+
+        InterpreterState get_state(InterpreterPtr& interpreter)
+        {
+            return
+                {
+                    .dictionary = interpreter->get_dictionary().version().stamp(),
+                    .handlers = interpreter->handlers_version().stamp(),
+                    .variables = interpreter->get_variables().version().stamp()
+                };
+        }
+
+
+        // Work waiting to be run by one of the pool's workers.
+        struct Task
+        {
+            // The code to run, usually a word along with the value it's given to work on.
+            TaskBody body;
+
+            // Where the word's result goes.
+            FuturePtr future;
+
+            // The interpreter state the word expects to run in.  Workers clone their interpreters
+            // from this.
+            InterpreterPtr snapshot;
+        };
+
+
+        // One of the pool's threads.  Tasks spawned from within a task go onto the worker's own
+        // queue, where they're run newest first.  Other workers steal the oldest tasks from the
+        // other end of the queue.
+        struct Worker
+        {
+            std::mutex lock;
+            std::deque<Task> tasks;
+
+            std::thread thread;
+
+            // The worker's interpreter, the snapshot it was cloned from, and it's state right
+            // after it was cloned.  Once a task writes to a variable the state no longer matches,
+            // and the interpreter is cloned again for the next task.
+            InterpreterPtr interpreter;
+            InterpreterPtr source;
+            InterpreterState clean_state;
+        };
+
+
+        // The last snapshot taken by a thread, and the state of the interpreter it was taken from.
+        // Cloning the interpreter changes it's state, so it's recorded beforehand.
+        struct Snapshot
+        {
+            InterpreterPtr interpreter;
+            InterpreterState source_state;
+        };
+
+
+        class TaskPool
+        {
+            private:
+                std::vector<std::unique_ptr<Worker>> workers;
+
+                // Tasks spawned from outside of the pool.
+                std::mutex injected_lock;
+                std::deque<Task> injected;
+
+                // Idle workers sleep until there's something for them to do.
+                std::mutex sleep_lock;
+                std::condition_variable sleep_condition;
+                std::atomic<size_t> pending;
+                bool is_stopping;
+
+            public:
+                TaskPool()
+                : workers(),
+                  injected_lock(),
+                  injected(),
+                  sleep_lock(),
+                  sleep_condition(),
+                  pending(0),
+                  is_stopping(false)
+                {
+                    auto count = std::max(std::thread::hardware_concurrency(), 1u);
+
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        workers.push_back(std::make_unique<Worker>());
+                    }
+
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        workers[i]->thread = std::thread([this, i]() { worker_main(i); });
+                    }
+                }
+
+                ~TaskPool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(sleep_lock);
+                        is_stopping = true;
+                    }
+
+                    sleep_condition.notify_all();
+
+                    for (auto& worker : workers)
+                    {
+                        worker->thread.join();
+                    }
+                }
+
+            public:
+                size_t size() const
+                {
+                    return workers.size();
+                }
+
+                FuturePtr spawn(InterpreterPtr& interpreter, TaskBody body)
+                {
+                    auto future = std::make_shared<Future>();
+                    Task task =
+                        {
+                            .body = std::move(body),
+                            .future = future,
+                            .snapshot = get_snapshot(interpreter)
+                        };
+
+                    // Tasks spawned by a task stay with it's worker, where they're likely to be
+                    // run while the data they share is still in the cache.
+                    if (current_worker != nullptr)
+                    {
+                        std::lock_guard<std::mutex> lock(current_worker->lock);
+                        current_worker->tasks.push_back(std::move(task));
+                    }
+                    else
+                    {
+                        std::lock_guard<std::mutex> lock(injected_lock);
+                        injected.push_back(std::move(task));
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(sleep_lock);
+                        ++pending;
+                    }
+
+                    sleep_condition.notify_one();
+
+                    return future;
+                }
+
+                // A worker that blocks waiting on another task could starve the pool, so it helps
+                // out by running other tasks until it's done waiting, or the deadline has passed.
+                // Returns false if the deadline passed first.
+                bool help_until(const std::function<bool()>& is_done,
+                                std::optional<std::chrono::steady_clock::time_point> deadline)
+                {
+                    while (!is_done())
+                    {
+                        if (   (deadline)
+                            && (std::chrono::steady_clock::now() >= *deadline))
+                        {
+                            return false;
+                        }
+
+                        Task task;
+
+                        if (find_task(current_index, task))
+                        {
+                            // The worker's own interpreter is busy with the task that's waiting,
+                            // so the other task gets an interpreter of it's own.
+                            auto interpreter = clone_interpreter(task.snapshot);
+
+                            execute(interpreter, task);
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+
+                    return true;
+                }
+
+                // Is the calling thread one of the pool's workers?
+                static bool is_worker_thread()
+                {
+                    return current_worker != nullptr;
+                }
+
+            private:
+                static thread_local Worker* current_worker;
+                static thread_local size_t current_index;
+                static thread_local Snapshot last_snapshot;
+
+                // Get the interpreter that tasks from this interpreter should be cloned from.
+                // This is run on the spawning thread, as the interpreter can't be safely cloned
+                // from any other thread.  Each thread keeps it's own last snapshot, so a thread
+                // spawning task after task without changing anything only clones once.
+                static InterpreterPtr get_snapshot(InterpreterPtr& interpreter)
+                {
+                    auto state = get_state(interpreter);
+
+                    if (   (!last_snapshot.interpreter)
+                        || (last_snapshot.source_state != state))
+                    {
+                        last_snapshot.interpreter = clone_interpreter(interpreter);
+                        last_snapshot.source_state = state;
+                    }
+
+                    return last_snapshot.interpreter;
+                }
+
+                // Look for a task, first in the worker's own queue, then in the tasks from outside
+                // the pool, then try to steal one from another worker.
+                bool find_task(size_t index, Task& task)
+                {
+                    auto& worker = *workers[index];
+
+                    {
+                        std::lock_guard<std::mutex> lock(worker.lock);
+
+                        if (!worker.tasks.empty())
+                        {
+                            task = std::move(worker.tasks.back());
+                            worker.tasks.pop_back();
+                            --pending;
+
+                            return true;
+                        }
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(injected_lock);
+
+                        if (!injected.empty())
+                        {
+                            task = std::move(injected.front());
+                            injected.pop_front();
+                            --pending;
+
+                            return true;
+                        }
+                    }
+
+                    for (size_t i = 1; i < workers.size(); ++i)
+                    {
+                        auto& victim = *workers[(index + i) % workers.size()];
+                        std::lock_guard<std::mutex> lock(victim.lock);
+
+                        if (!victim.tasks.empty())
+                        {
+                            task = std::move(victim.tasks.front());
+                            victim.tasks.pop_front();
+                            --pending;
+
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                void execute(InterpreterPtr& interpreter, Task& task)
+                {
+                    try
+                    {
+                        interpreter->clear_stack();
+
+                        auto result = task.body(interpreter);
+
+                        interpreter->clear_stack();
+                        task.future->set_value(result);
+                    }
+                    catch (const std::exception& error)
+                    {
+                        interpreter->clear_stack();
+                        task.future->set_error(error.what());
+                    }
+                    catch (...)
+                    {
+                        interpreter->clear_stack();
+                        task.future->set_error("Task exited with an unknown error.");
+                    }
+                }
+
+                void worker_main(size_t index)
+                {
+                    auto& worker = *workers[index];
+
+                    current_worker = &worker;
+                    current_index = index;
+
+                    while (true)
+                    {
+                        Task task;
+
+                        if (find_task(index, task))
+                        {
+                            // Only clone a new interpreter if the task needs words or variables
+                            // that our current one doesn't have, or the last task wrote to it's
+                            // variables.
+                            if (   (worker.source != task.snapshot)
+                                || (get_state(worker.interpreter) != worker.clean_state))
+                            {
+                                worker.interpreter = clone_interpreter(task.snapshot);
+                                worker.source = task.snapshot;
+                                worker.clean_state = get_state(worker.interpreter);
+                            }
+
+                            execute(worker.interpreter, task);
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock(sleep_lock);
+
+                        sleep_condition.wait(lock, [this]() { return is_stopping || pending > 0; });
+
+                        if (is_stopping && pending == 0)
+                        {
+                            break;
+                        }
+                    }
+
+                    worker.interpreter.reset();
+                    worker.source.reset();
+                }
+        };
+
+
+        thread_local Worker* TaskPool::current_worker = nullptr;
+        thread_local size_t TaskPool::current_index = 0;
+        thread_local Snapshot TaskPool::last_snapshot;
+
+
+        // Ranges smaller than this are processed on the calling thread, it isn't worth the cost of
+        // handing them off to the task pool.
+        constexpr size_t parallel_threshold = 256;
+
+        // The smallest number of items that will be handed to a worker at once.
+        constexpr size_t minimum_chunk_size = 64;
+
+
+        // The pool is started the first time that it's used.
+        TaskPool& get_pool()
+        {
+            static TaskPool pool;
+
+            return pool;
+        }
+
+
+    }
+
+
+    FuturePtr task_spawn(InterpreterPtr& interpreter, const Word& word, const Value& input)
+    {
+        auto body = [word, input](InterpreterPtr& worker) -> Value
+            {
+                worker->push(input);
+                worker->execute_word(word);
+
+                return worker->is_stack_empty() ? Value() : worker->pop();
+            };
+
+        return get_pool().spawn(interpreter, body);
+    }
+
+
+    FuturePtr task_spawn(InterpreterPtr& interpreter, TaskBody body)
+    {
+        return get_pool().spawn(interpreter, std::move(body));
+    }
+
+
+    Value task_wait(const FuturePtr& future)
+    {
+        // Threads outside of the pool have nothing to help with, so they can just block.  This
+        // also keeps waiting on a thread's future from starting up the pool.
+        if (TaskPool::is_worker_thread())
+        {
+            get_pool().help_until([&]() { return future->is_ready(); }, std::nullopt);
+        }
+
+        return future->get();
+    }
+
+
+    bool task_wait_for(const FuturePtr& future, std::chrono::milliseconds timeout)
+    {
+        if (!TaskPool::is_worker_thread())
+        {
+            return future->wait_for(timeout);
+        }
+
+        return get_pool().help_until([&]() { return future->is_ready(); },
+                                     std::chrono::steady_clock::now() + timeout);
+    }
+
+
+    std::optional<size_t> task_wait_any(const std::vector<FuturePtr>& futures,
+                                        Future::Timeout timeout)
+    {
+        if (!TaskPool::is_worker_thread())
+        {
+            return Future::wait_any(futures, timeout);
+        }
+
+        auto first_ready = [&]() -> std::optional<size_t>
+            {
+                for (size_t i = 0; i < futures.size(); ++i)
+                {
+                    if (futures[i]->is_ready())
+                    {
+                        return i;
+                    }
+                }
+
+                return std::nullopt;
+            };
+
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+
+        if (timeout)
+        {
+            deadline = std::chrono::steady_clock::now() + *timeout;
+        }
+
+        get_pool().help_until([&]() { return first_ready().has_value(); }, deadline);
+
+        return first_ready();
+    }
+
+
+    size_t task_worker_count()
+    {
+        return get_pool().size();
+    }
+
+
+    std::vector<Value> task_run_chunks(InterpreterPtr& interpreter,
+                                       size_t size,
+                                       const ChunkBody& body)
+    {
+        // Small ranges still run on an interpreter of their own, just like the chunks given to
+        // the workers.  That way what the body can see, and what happens to the variables it
+        // writes, doesn't depend on how many items there are.
+        if (size < parallel_threshold)
+        {
+            auto clone = clone_interpreter(interpreter);
+
+            return { body(clone, 0, size) };
+        }
+
+        auto workers = task_worker_count();
+
+        // Make a few more chunks than there are workers, so that a worker that finishes early can
+        // steal some of the remaining work.
+        auto chunk_count = std::min(workers * 4, size / minimum_chunk_size);
+        auto chunk_size = (size + chunk_count - 1) / chunk_count;
+
+        std::vector<FuturePtr> futures;
+
+        for (size_t start = 0; start < size; start += chunk_size)
+        {
+            auto end = std::min(start + chunk_size, size);
+
+            futures.push_back(task_spawn(interpreter,
+                                         [body, start, end](InterpreterPtr& worker)
+                                         {
+                                             return body(worker, start, end);
+                                         }));
+        }
+
+        // Wait for every chunk before reporting an error, so that nothing is still running when
+        // we do.
+        std::vector<Value> results(futures.size());
+        std::optional<std::string> error;
+
+        for (size_t i = 0; i < futures.size(); ++i)
+        {
+            try
+            {
+                results[i] = task_wait(futures[i]);
+            }
+            catch (const std::exception& e)
+            {
+                if (!error)
+                {
+                    error = e.what();
+                }
+            }
+        }
+
+        if (error)
+        {
+            throw_error(*error);
+        }
+
+        return results;
+    }
+
+
+}
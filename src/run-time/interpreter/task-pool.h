@@ -0,0 +1,60 @@
+
+#pragma once
+
+
+namespace sorth::internal
+{
+
+
+    // Run a word on the shared task pool.  The pool has one worker thread for each CPU core, each
+    // with it's own interpreter, and idle workers steal tasks from the busy ones.  The worker's
+    // interpreters are cloned up front and reused from task to task, so spawning a task is much
+    // cheaper than starting a new thread with thread.new.
+    //
+    // The word is given the input value on it's stack, and the future is completed with the value
+    // left on the top of the stack when the word returns.  The workers are re-cloned whenever the
+    // spawning interpreter's words or variables have changed, or a task has written to them, so a
+    // task sees them as they were when it was spawned.  Any variables the task writes to are only
+    // changed in the worker's own interpreter, never in the one that spawned it.
+    FuturePtr task_spawn(InterpreterPtr& interpreter, const Word& word, const Value& input);
+
+
+    // Run native code on the task pool.  The body is given the worker's interpreter, and the
+    // future is completed with the value it returns.
+    using TaskBody = std::function<Value(InterpreterPtr& interpreter)>;
+
+    FuturePtr task_spawn(InterpreterPtr& interpreter, TaskBody body);
+
+
+    // Wait for a task, or any other future, to complete and return it's value, rethrowing it's
+    // error if it failed.  If called from within a task, the worker runs other tasks while it
+    // waits.
+    Value task_wait(const FuturePtr& future);
+
+
+    // Like future->wait_for and Future::wait_any, but from within a task the worker runs other
+    // tasks while it waits.
+    bool task_wait_for(const FuturePtr& future, std::chrono::milliseconds timeout);
+
+    std::optional<size_t> task_wait_any(const std::vector<FuturePtr>& futures,
+                                        Future::Timeout timeout = std::nullopt);
+
+
+    // How many worker threads the task pool runs.
+    size_t task_worker_count();
+
+
+    // Code that processes the items from start up to end, on the given interpreter.
+    using ChunkBody = std::function<Value(InterpreterPtr& interpreter, size_t start, size_t end)>;
+
+
+    // Split a range of items into chunks and run them on the task pool, returning each chunk's
+    // result in order.  Small ranges are run as a single chunk on the calling thread, but still on
+    // an interpreter of their own, so the body sees the same thing no matter the range's size.  If
+    // any of the chunks fail, the first error is rethrown once all of them have finished.
+    std::vector<Value> task_run_chunks(InterpreterPtr& interpreter,
+                                       size_t size,
+                                       const ChunkBody& body);
+
+
+}
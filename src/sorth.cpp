@@ -158,9 +158,14 @@ int main(int argc, char* argv[])
 
     try
     {
+        // Compiling a script ahead of time, sorth --aot <object-file> <script>, caches the script's
+        // words the way the JIT does.  So the interpreter has to be in JIT mode for that.
+        bool is_compiling = (argc >= 4) && (std::string(argv[1]) == "--aot");
+
         // Create the interpreter and set up the search path to be able to find the standard
         // library.
-        auto interpreter = sorth::create_interpreter(get_execution_mode());
+        auto interpreter = sorth::create_interpreter(is_compiling ? sorth::ExecutionMode::jit
+                                                                  : get_execution_mode());
 
         interpreter->add_search_path(get_std_lib_directory());
 
@@ -168,6 +173,9 @@ int main(int argc, char* argv[])
         sorth::register_builtin_words(interpreter);
         sorth::register_terminal_words(interpreter);
         sorth::register_io_words(interpreter);
+        #if (IS_UNIX == 1)
+            sorth::register_event_words(interpreter);
+        #endif
         sorth::register_user_words(interpreter);
         sorth::register_ffi_words(interpreter);
 
@@ -182,8 +190,17 @@ int main(int argc, char* argv[])
         // Add the current directory to the search path.
         interpreter->add_search_path(std::filesystem::current_path());
 
-        // Check to see if the user requested that we run a specific script.
-        if (argc >= 2)
+        // Check to see if the user requested that we compile or run a specific script.
+        if (is_compiling)
+        {
+            // The script's arguments are only known when the compiled program is run.  But the
+            // word that holds them has to exist just the same.
+            sorth::register_command_line_args(interpreter, argc, argc, argv);
+
+            auto user_source_path = interpreter->find_file(argv[3]);
+            interpreter->compile_source(user_source_path, argv[2]);
+        }
+        else if (argc >= 2)
         {
             // Looks like we have a script to run.  Load up any remaining command line arguments
             // into an array and make them available to the script as the word sorth.args.
@@ -80,6 +80,7 @@
 #include <filesystem>
 #include <list>
 #include <vector>
+#include <array>
 #include <memory>
 #include <string>
 #include <variant>
@@ -95,7 +96,11 @@
 #include <cassert>
 #include <condition_variable>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
+#include <atomic>
+#include <limits>
+#include <chrono>
 
 
 
@@ -105,6 +110,7 @@
 #include "lang/source/tokenize.h"
 #include "run-time/data-structures/contextual-list.h"
 #include "run-time/data-structures/value.h"
+#include "run-time/data-structures/freezable.h"
 #include "run-time/data-structures/word-function.h"
 #include "run-time/data-structures/dictionary.h"
 #include "lang/code/instruction.h"
@@ -112,9 +118,15 @@
 #include "run-time/data-structures/byte-buffer.h"
 #include "run-time/data-structures/data-object.h"
 #include "run-time/data-structures/hash-table.h"
+#include "run-time/data-structures/concurrent-hash-table.h"
 #include "lang/code/compile-context.h"
 #include "run-time/data-structures/blocking-value-queue.h"
+#include "run-time/data-structures/future.h"
+#include "run-time/data-structures/thread-handle.h"
+#include "run-time/data-structures/channel.h"
 #include "run-time/interpreter/interpreter.h"
+#include "run-time/interpreter/task-pool.h"
+#include "run-time/interpreter/coroutines.h"
 #include "run-time/built-ins/core-words/core-words.h"
 #include "run-time/built-ins/terminal-words.h"
 #include "run-time/built-ins/ffi-words.h"
@@ -125,6 +137,8 @@
 #if (IS_UNIX == 1)
 
 	#include "run-time/built-ins/io-words-posix.h"
+	#include "run-time/built-ins/event-words-posix.h"
+	#include "run-time/built-ins/async-io-posix.h"
 
 #elif (IS_WINDOWS == 1)
 
@@ -323,25 +323,25 @@
 
 
 ( Simple increment and decrements. )
-: ++  description: "Increment a value on the stack."
+: ++  intrinsic: increment description: "Increment a value on the stack."
       signature: "value -- incremented"
     1 +
 ;
 
 
-: ++!  description: "Increment the given variable."
+: ++!  intrinsic: increment_variable description: "Increment the given variable."
        signature: "variable -- "
     dup @ ++ swap !
 ;
 
 
-: --  description: "Decrement a value on the stack."
+: --  intrinsic: decrement description: "Decrement a value on the stack."
       signature: "value -- decremented"
     1 -
 ;
 
 
-: --!  description: "Decrement the given variable."
+: --!  intrinsic: decrement_variable description: "Decrement the given variable."
        signature: "variable -- "
     dup @ -- swap !
 ;
@@ -414,6 +414,39 @@
 
 
 
+: pdo immediate description: "Define a parallel loop, the body is given each index and is run across the task pool.  Variables the body writes to aren't kept."
+                signature: "start_value end_value pdo <loop-body> ploop | initial start_value end_value pdo <loop-body> preduce <merge-word>"
+    ( Compile the loop body into it's own block of code, so that it can be handed to the workers. )
+    code.new_block
+
+    "ploop" "preduce" 2 code.compile_until_words
+
+    code.resolve_jumps
+    code.pop_stack_block op.push_constant_value
+
+    ( A reducing loop also needs the word that merges the body's results together. )
+    "preduce" =
+    if
+        ` ` execute
+        ` parallel.reduce op.execute
+    else
+        ` parallel.for op.execute
+    then
+;
+
+
+: ploop description: "The end of a parallel loop."
+    "ploop" sentinel_word
+;
+
+
+: preduce description: "The end of a parallel loop that merges it's results with the following word."
+    "preduce" sentinel_word
+;
+
+
+
+
 ( Stack words. )
 : nip description: "Nip the second from the top item from the stack."
       signature: "a b c -- a c"
@@ -515,7 +548,7 @@
 
 
 
-: thread.new immediate description: "Create a new thread with the given word and return the new thread id."
+: thread.new immediate description: "Create a new thread with the given word and return the new thread's handle."
              signature: "thread.new <word_name>"
     word op.push_constant_value
     ` thread.new op.execute
@@ -523,6 +556,30 @@
 
 
 
+: thread.async immediate description: "Run the word on a new thread and return a future for it's result."
+               signature: "thread.async <word_name> -- future"
+    word op.push_constant_value
+    ` thread.async op.execute
+;
+
+
+
+: task.spawn immediate description: "Run the word on the task pool with the given input and return it's future."
+             signature: "input task.spawn <word_name> -- future"
+    word op.push_constant_value
+    ` task.spawn op.execute
+;
+
+
+
+: coroutine.new immediate description: "Run the word as a coroutine on this thread with the given input and return it's future."
+                signature: "input coroutine.new <word_name> -- future"
+    word op.push_constant_value
+    ` coroutine.new op.execute
+;
+
+
+
 : value.both-are? description: "Check if the two values are the same type."
                   signature: "a b value-check -- are-same-type?"
     variable! operation
@@ -578,7 +635,7 @@
 
 
 
-: = description: "Compare two values."
+: = intrinsic: equal description: "Compare two values."
     signature: "a b -- are_equal?"
     variable! b
     variable! a
@@ -603,14 +660,14 @@
 
 
 
-: <> description: "Compare two values."
+: <> intrinsic: not_equal description: "Compare two values."
      signature: "a b -- are-not-equal?"
     = '
 ;
 
 
 
-: + description: "Add two values together."
+: + intrinsic: add description: "Add two values together."
     signature: "a b -- result"
     variable! b
     variable! a
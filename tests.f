@@ -55,8 +55,27 @@ cr
 
 cr
 
+"--- Testing threads. ---" .cr
+
+"tests/10_test_threads.f" include
+
+cr
+
+"--- Testing the event loop. ---" .cr
+
+"tests/11_test_events.f" include
+
+cr
+
+"--- Testing async file I/O. ---" .cr
+
+"tests/12_test_async_io.f" include
+
+cr
+
 "--- Testing the ffi. ---" .cr
 
 "tests/09_test_ffi.f" include
 
 cr
+
@@ -38,3 +38,33 @@ cr
 loop_while
 cr
 do_loop
+
+
+0 variable! merges
+: merge-and-count merges @ 1 + merges ! + ;
+
+
+: parallel_loop
+    ( Each index is squared on whichever worker picks it up, then the results are summed. )
+    0 0 1000
+    pdo
+        dup *
+    preduce +
+
+    "Parallel sum of squares: " . .cr
+
+    0 0 10
+    pdo
+    preduce merge-and-count
+
+    "Parallel merge count: " . merges @ . "  sum: " . .cr
+
+    0 4
+    pdo
+        drop
+    ploop
+;
+
+
+cr
+parallel_loop
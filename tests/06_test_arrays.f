@@ -26,3 +26,47 @@
 
 
 "Create on the spot: " . [ 1024 , 2048 , 4096 ] .cr
+
+
+: square dup * ;
+: is-even? 2 % 0 = ;
+: add + ;
+
+"Map:                " . ` square [ 1 , 2 , 3 , 4 ] [].map .cr
+"Filter:             " . ` is-even? [ 1 , 2 , 3 , 4 ] [].filter .cr
+"Reduce:             " . 0 ` add [ 1 , 2 , 3 , 4 ] [].reduce .cr
+"Reduce empty:       " . 100 ` add 0 [].new [].reduce .cr
+
+
+( Large enough to be split up over the task pool. )
+1000 [].new variable! big_array
+0 variable! big_index
+
+begin
+    big_index @ 1000 <
+while
+    big_index @ big_array [ big_index @ ]!!
+    big_index ++!
+repeat
+
+"Big map:            " . ` square big_array @ [].map 999 swap []@ .cr
+"Big filter:         " . ` is-even? big_array @ [].filter [].size@ .cr
+"Big reduce:         " . 0 ` add big_array @ [].reduce .cr
+
+` drop big_array @ [].each
+
+
+( The word gets an interpreter of it's own no matter how big the array is, so the variables it
+  writes to are left as they were. )
+0 variable! last_seen
+: remember last_seen ! ;
+
+` remember [ 1 , 2 , 3 ] [].each
+` remember big_array @ [].each
+
+"Each kept writes:   " . last_seen @ .cr
+
+: remember-sum dup last_seen ! + ;
+
+0 ` remember-sum [ 1 , 2 , 3 ] [].reduce
+"Reduce kept writes: " . last_seen @ . "  sum: " . .cr
@@ -0,0 +1,499 @@
+
+( A worker that doubles every value it's given until it sees a negative one. )
+: doubler
+    begin
+        thread.pop dup 0 <
+        if
+            drop true
+        else
+            2 * thread.push false
+        then
+    until
+;
+
+
+( Add up batches of values and send back the totals. )
+: batch-adder
+    8 thread.pop-many
+    + + + + + + +
+    thread.push
+
+    1 2 3 3 thread.push-many
+;
+
+
+thread.new doubler variable! doubler-id
+0 variable! total
+
+
+( Push more values than fit in a queue before reading any of the results back.  The doubler's
+  output queue fills up, so it has to wait on us to drain it before it can go on. )
+0 variable! index
+
+begin
+    index @ 5000 <
+while
+    index @ doubler-id @ thread.push-to
+    index ++!
+repeat
+
+0 index !
+
+begin
+    index @ 5000 <
+while
+    doubler-id @ thread.pop-from total @ + total !
+    index ++!
+repeat
+
+-1 doubler-id @ thread.push-to
+
+total @ 24995000 <>
+if
+    "Thread total mismatch!" .cr
+    exit_failure quit
+then
+
+total @ "Doubled total: {}" string.format .cr
+
+
+thread.new batch-adder variable! adder-id
+
+0 8 do 10 adder-id @ thread.push-to loop
+
+adder-id @ thread.pop-from "Batch total: {}" string.format .cr
+
+adder-id @ thread.pop-from
+adder-id @ thread.pop-from
+adder-id @ thread.pop-from
+"Batch values: {} {} {}" string.format .cr
+
+
+
+( Fan work out over the task pool and gather the results back up. )
+: square dup * ;
+
+: failing-task drop "Task failed on purpose." throw ;
+
+: sum-of-squares
+    variable! count
+
+    count @ [].new variable! futures
+    0 variable! total
+    0 variable! i
+
+    begin
+        i @ count @ <
+    while
+        i @ task.spawn square  futures [ i @ ]!!
+        i ++!
+    repeat
+
+    0 i !
+
+    begin
+        i @ count @ <
+    while
+        futures [ i @ ]@@ task.wait  total @ +  total !
+        i ++!
+    repeat
+
+    total @
+;
+
+
+100 sum-of-squares "Sum of squares: {}" string.format .cr
+
+( Tasks can spawn and wait on tasks of their own. )
+10 task.spawn sum-of-squares task.wait "Nested sum of squares: {}" string.format .cr
+
+try
+    0 task.spawn failing-task task.wait drop
+    "Task error was lost!" .cr
+    exit_failure quit
+catch
+    drop "Task error was passed on." .cr
+endcatch
+
+
+( A task that waits on other tasks helps run them, even if every worker is busy waiting. )
+: waits-in-task
+    drop
+
+    5 task.spawn square 1000 future.wait-for
+    [ 3 task.spawn square , 4 task.spawn square ] future.wait-any 0 >=
+    [ 6 task.spawn square ] 1000 future.wait-any-for 0 =
+
+    "{} {} {}" string.format
+;
+
+0 task.spawn waits-in-task task.wait "Waits inside a task: {}" string.format .cr
+
+
+( Tasks see variables as they are when the task is spawned, even when nothing new was defined
+  since the last task. )
+0 variable! scale
+0 variable! first-scaled
+
+: scaled scale @ * ;
+
+2 scale !
+5 task.spawn scaled task.wait first-scaled !
+
+3 scale !
+first-scaled @  5 task.spawn scaled task.wait
+"Scaled tasks: {} {}" string.format .cr
+
+
+( A task's variable writes stay with that task, the next one to run on the same worker still sees
+  the variables as they were when it was spawned. )
+0 variable! bumps
+
+: bump drop bumps @ 1 + dup bumps ! ;
+
+0 task.spawn bump task.wait  0 task.spawn bump task.wait  0 task.spawn bump task.wait  bumps @
+"Bumped tasks: {} {} {}, caller still: {}" string.format .cr
+
+
+
+( Threads started with thread.async pass their result, or their error, back through a future. )
+: answer-thread 6 7 * ;
+
+: failing-thread "Thread failed on purpose." throw ;
+
+thread.async answer-thread variable! answer
+
+answer @ 10000 future.wait-for '
+if
+    "Thread did not finish in time!" .cr
+    exit_failure quit
+then
+
+answer @ future.wait "Thread answer: {}" string.format .cr
+
+try
+    thread.async failing-thread future.wait drop
+    "Thread error was lost!" .cr
+    exit_failure quit
+catch
+    drop "Thread error was passed on." .cr
+endcatch
+
+3 [].new variable! answers
+
+thread.async answer-thread  answers [ 0 ]!!
+5 task.spawn square       answers [ 1 ]!!
+6 task.spawn square       answers [ 2 ]!!
+
+answers @ 10000 future.wait-any-for 0 < answers @ future.wait-any 0 < ||
+if
+    "No future completed!" .cr
+    exit_failure quit
+then
+
+answers @ future.wait-all variable! results
+
+results [ 0 ]@@ results [ 1 ]@@ results [ 2 ]@@ "Gathered: {} {} {}" string.format .cr
+
+
+
+( Thread handles can be passed between threads to wire them up into a pipeline. )
+: add-one
+    thread.pop 1 + thread.push
+;
+
+: double-into
+    thread.pop variable! next
+    thread.pop 2 * next @ thread.push-to
+;
+
+thread.new add-one variable! last-stage
+thread.new double-into variable! first-stage
+
+last-stage @ first-stage @ thread.push-to
+20 first-stage @ thread.push-to
+
+last-stage @ thread.pop-from "Pipeline result: {}" string.format .cr
+last-stage @ thread.result future.wait drop
+
+
+
+( One thread can listen to several producers at once by selecting across their channels. )
+: produce-into
+    thread.pop variable! channel
+    thread.pop variable! item
+
+    0 100 do item @ channel @ channel.push loop
+;
+
+2 [].new variable! channels
+
+16 channel.new  channels [ 0 ]!!
+16 channel.new  channels [ 1 ]!!
+
+thread.new produce-into variable! producer-a
+thread.new produce-into variable! producer-b
+
+channels [ 0 ]@@ producer-a @ thread.push-to   1 producer-a @ thread.push-to
+channels [ 1 ]@@ producer-b @ thread.push-to  10 producer-b @ thread.push-to
+
+0 total !
+0 index !
+
+begin
+    index @ 200 <
+while
+    channels @ channel.select drop total @ + total !
+    index ++!
+repeat
+
+channels @ 10 channel.select-for -1 <>
+if
+    "Channel select did not time out!" .cr
+    exit_failure quit
+then
+drop
+
+total @ "Selected total: {}" string.format .cr
+
+
+( A producer that fills a small channel has to wait for the consumer to make room.  Wait until the
+  channel is full, so we know the producer is blocked, before draining it. )
+4 channel.new variable! small-channel
+
+thread.new produce-into variable! producer-c
+
+small-channel @ producer-c @ thread.push-to  1 producer-c @ thread.push-to
+
+begin
+    small-channel @ channel.depth 4 >=
+until
+
+0 total !
+0 index !
+
+begin
+    index @ 100 <
+while
+    small-channel @ channel.pop total @ + total !
+    index ++!
+repeat
+
+total @ "Full channel total: {}" string.format .cr
+
+
+
+( Concurrent tables can be shared between threads without copying. )
+: count-into
+    thread.pop variable! counts
+
+    0 1000 do 1 "hits" counts @ ctable.add drop loop
+    "first" "owner" counts @ ctable.get-or-insert drop
+;
+
+: bump 1 + ;
+
+ctable.new variable! counts
+
+thread.new count-into variable! counter-a
+thread.new count-into variable! counter-b
+
+counts @ counter-a @ thread.push-to
+counts @ counter-b @ thread.push-to
+
+0 1000 do 1 "hits" counts @ ctable.add drop loop
+
+counter-a @ thread.result future.wait drop
+counter-b @ thread.result future.wait drop
+
+` bump "hits" counts @ ctable.update
+"owner" counts @ ctable@
+"Shared counts: {} owned by {}" string.format .cr
+
+( The table keeps frozen copies, so the original can still be changed without the other threads
+  seeing it.  Updates swap in a new list, matching the old one by identity. )
+: add-item value.copy dup 4 swap [].push_back! ;
+
+[ 1 , 2 ] variable! stored-list
+stored-list @ "list" counts @ ctable!
+3 stored-list @ [].push_back!
+
+` add-item "list" counts @ ctable.update drop
+"list" counts @ ctable@ dup value.frozen? swap
+"Stored list frozen {}: {}, original {}" stored-list @ swap string.format .cr
+
+( Thread handles are equal only to themselves, even once their threads are gone. )
+ctable.new variable! by-thread
+"a" counter-a @ by-thread @ ctable!
+
+counter-a @ by-thread @ ctable?  counter-b @ by-thread @ ctable?
+"Keyed by the same handle: {}, by another: {}" string.format .cr
+
+
+
+( Frozen values can be handed to other threads without being copied. )
+: sum-frozen
+    thread.pop variable! numbers
+
+    0 ` + numbers @ [].reduce
+;
+
+[ 1 , 2 , 3 , 4 , 5 ] value.freeze variable! numbers
+
+try
+    10 numbers [ 0 ]!!
+    "Wrote to a frozen array!" .cr
+    exit_failure quit
+catch
+    drop
+endcatch
+
+thread.new sum-frozen variable! summer
+numbers @ summer @ thread.push-to
+
+summer @ thread.result future.wait
+numbers @ value.frozen?
+numbers @ value.copy value.frozen? '
+"Frozen sum: {}, still frozen: {}, copy writable: {}" string.format .cr
+
+
+( Frozen buffers are read by offset, so the readers never share a cursor. )
+: read-frozen-buffer
+    thread.pop variable! frozen-bytes
+
+    4 frozen-bytes @ 4 true buffer.int-at@
+    0 frozen-bytes @ 4 true buffer.int-at@
+    +
+;
+
+8 buffer.new variable! frozen-bytes
+
+20 frozen-bytes buffer.i32!!
+22 frozen-bytes buffer.i32!!
+2 frozen-bytes buffer.position!!
+frozen-bytes @ value.freeze drop
+
+try
+    0 frozen-bytes buffer.position!!
+    "Moved the cursor of a frozen buffer!" .cr
+    exit_failure quit
+catch
+    drop
+endcatch
+
+try
+    frozen-bytes buffer.i32@@ drop
+    "Read through the cursor of a frozen buffer!" .cr
+    exit_failure quit
+catch
+    drop
+endcatch
+
+thread.new read-frozen-buffer variable! buffer-reader
+frozen-bytes @ buffer-reader @ thread.push-to
+
+buffer-reader @ thread.result future.wait
+frozen-bytes buffer.position@@
+"Frozen buffer total: {}, position still: {}" string.format .cr
+
+
+
+( Coroutines take turns on the thread that started them, each with it's own stack. )
+: take-turns
+    variable! name
+    variable steps
+
+    "" steps !
+    0 3 do steps @ name @ + steps ! yield loop
+
+    steps @
+;
+
+: await-task
+    task.spawn square await
+;
+
+"a" coroutine.new take-turns variable! turns-a
+"b" coroutine.new take-turns variable! turns-b
+9 coroutine.new await-task variable! squared
+
+turns-a @ await turns-b @ await squared @ await
+coroutine.count
+"Coroutines: {} {} {}, {} left" string.format .cr
+
+
+( Record the order that coroutines get their turns in.  A name is only logged when the turn )
+( changes hands, so a coroutine that keeps the thread shows up once. )
+variable turn-log
+
+: log-turn
+    variable! name
+    turn-log @ [].size@ variable! size
+
+    size @ 0 =
+    if
+        true
+    else
+        size @ 1 - turn-log @ []@ name @ <>
+    then
+
+    if
+        name @ turn-log @ [].push_back!
+    then
+;
+
+: yield-turns
+    variable! name
+    0 3 do name @ log-turn yield loop
+;
+
+: busy-turns
+    variable! name
+    0 200 do name @ log-turn loop
+;
+
+: turn-order
+    "" ` + turn-log @ [].reduce
+;
+
+0 [].new turn-log !
+"a" coroutine.new yield-turns variable! yields-a
+"b" coroutine.new yield-turns variable! yields-b
+yields-a @ await drop yields-b @ await drop
+turn-order
+
+0 [].new turn-log !
+"a" coroutine.new busy-turns variable! busy-a
+"b" coroutine.new busy-turns variable! busy-b
+busy-a @ await drop busy-b @ await drop
+turn-order
+
+50 coroutine.budget!
+0 [].new turn-log !
+"a" coroutine.new busy-turns variable! preempted-a
+"b" coroutine.new busy-turns variable! preempted-b
+preempted-a @ await drop preempted-b @ await drop
+0 coroutine.budget!
+turn-log @ [].size@ 2 >
+
+"Turn order with yields: {}, without a budget: {}, preempted by the budget: {}"
+string.format .cr
+
+
+( A thread that exits with a coroutine it never ran leaves that coroutine's future failed, so
+  nothing waits on it forever. )
+: leave-coroutine
+    "c" coroutine.new yield-turns
+;
+
+thread.new leave-coroutine variable! leaver
+leaver @ thread.result future.wait variable! orphan
+
+try
+    orphan @ await drop
+    "Orphaned coroutine finished!" .cr
+    exit_failure quit
+catch
+    drop
+    "Orphaned coroutine failed once it's thread exited." .cr
+endcatch
@@ -0,0 +1,89 @@
+( The event loop handles many connections, and timers, from a single thread. )
+"/tmp/sorth-event-test.sock" socket.listen variable! server
+
+variable received
+variable closed
+variable connections
+
+"" received !
+0 closed !
+0 connections !
+
+: on-client-data
+    variable! fd
+
+    256 fd @ event.read
+    if
+        received @ swap + received !
+    else
+        drop
+
+        fd @ event.remove
+        fd @ file.close
+
+        closed ++!
+        closed @ 3 =
+        if
+            server @ event.remove
+            server @ file.close
+        then
+    then
+;
+
+: on-connect
+    socket.accept dup 0 >=
+    if
+        ` on-client-data event.on-readable
+    else
+        drop
+    then
+;
+
+: on-client-writable
+    variable! fd
+
+    "ping " fd @ event.write drop
+
+    fd @ event.remove
+    fd @ file.close
+;
+
+: connect-client
+    variable! timer
+
+    connections ++!
+    connections @ 3 =
+    if
+        timer @ event.cancel
+    then
+
+    "/tmp/sorth-event-test.sock" socket.connect ` on-client-writable event.on-writable
+;
+
+server @ ` on-connect event.on-readable
+
+variable ticks
+0 ticks !
+
+: tick drop ticks ++! ;
+
+5 ` connect-client event.interval drop
+1 ` tick event.timer drop
+
+event.loop
+
+received @ ticks @
+"Event loop received: {}after {} tick" string.format .cr
+
+
+( Watching a socket makes it non-blocking, so accepting with nobody waiting doesn't block. )
+: ignore-connect drop ;
+
+"/tmp/sorth-event-idle.sock" socket.listen variable! idle-server
+idle-server @ ` ignore-connect event.on-readable
+
+idle-server @ socket.accept
+"Accept with nobody waiting: {}" string.format .cr
+
+idle-server @ event.remove
+idle-server @ file.close
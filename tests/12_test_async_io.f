@@ -0,0 +1,48 @@
+( Async file I/O keeps many reads and writes in flight at once. )
+"/tmp/sorth-async-test.bin" file.r/w file.create variable! async-fd
+
+variable buffers
+variable futures
+variable index
+variable total
+variable text
+
+8 [].new buffers !
+8 [].new futures !
+
+0 index !
+begin index @ 8 < while
+    8 buffer.new  buffers [ index @ ]!!
+    index @ "block-{}" string.format  buffers [ index @ ]@@  8  buffer.string!
+
+    buffers [ index @ ]@@  index @ 8 *  async-fd @  file.write-async  futures [ index @ ]!!
+    index ++!
+repeat
+
+0 total !
+0 index !
+begin index @ 8 < while
+    futures [ index @ ]@@ await  total @ +  total !
+    index ++!
+repeat
+
+( Read the blocks back in reverse order. )
+0 index !
+begin index @ 8 < while
+    8 buffer.new  buffers [ index @ ]!!
+    buffers [ index @ ]@@  7 index @ - 8 *  async-fd @  file.read-async  futures [ index @ ]!!
+    index ++!
+repeat
+
+"" text !
+0 index !
+begin index @ 8 < while
+    futures [ index @ ]@@ await drop
+    text @  buffers [ index @ ]@@ 8 buffer.string@  +  " " +  text !
+    index ++!
+repeat
+
+async-fd @ file.close
+
+total @ text @
+"Async wrote {} bytes, read back: {}" string.format .cr